@@ -57,6 +57,12 @@ void audio_sdl_set_effects_volume(AudioSdl *audio, int volume);
  */
 int audio_sdl_get_effects_volume(const AudioSdl *audio);
 
+/**
+ * Duration of the last audio mixing pass in microseconds; *calls receives
+ * how many passes have run.
+ */
+unsigned int audio_sdl_mix_time_us(const AudioSdl *audio, unsigned int *calls);
+
 /**
  * Load a sound effect from file path.
  * Returns 1 on success, 0 on failure.
@@ -3,15 +3,39 @@
 
 #include "common.h"
 #include "snake.h"
+#include "occupancy.h"
+#include "rng.h"
 
 typedef struct {
     int width;
     int height;
     Vec2 food;
+    OccupancyGrid occupancy;    // One plane per snake on this board
 } Board;
 
-void board_init(Board *b, int width, int height);
+/**
+ * Set up a board and its occupancy grid with `owners` snake planes.
+ * The Board must be zero-filled or released with board_free first.
+ */
+void board_init(Board *b, int width, int height, int owners);
+
+/**
+ * Free the occupancy grid. Free snakes bound to it first.
+ */
+void board_free(Board *b);
+
 int board_out_of_bounds(const Board *b, Vec2 pos);
-void board_place_food(Board *b, const Snake *s);
+
+/**
+ * Pick a uniformly random cell no snake is on, drawing from rng.
+ * O(1) at any fill level. Returns 1 and sets *out, or 0 if every cell is taken.
+ */
+int board_random_free_cell(const Board *b, Rng *rng, Vec2 *out);
+
+/**
+ * Move the food to a random cell no snake is on, drawing from rng.
+ * Returns 1 if placed, 0 if the board is full (food is left where it was).
+ */
+int board_place_food(Board *b, Rng *rng);
 
 #endif
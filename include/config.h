@@ -25,6 +25,9 @@ typedef struct {
     int combo_window_ticks;  // Base combo window in ticks
     int combo_window_increase_per_tier; // Additional ticks added per tier level
 
+    // Input
+    int input_queue_depth;   // Direction presses queued between ticks
+
     // Multiplayer settings
     int initial_lives;       // Starting lives per player
     int max_players;         // Maximum players allowed
@@ -34,6 +37,7 @@ typedef struct {
     int window_height;
     int max_cell_size;
     int min_cell_size;
+    int vsync;               // 1 to wait for the display on present
 
 } GameConfig;
 
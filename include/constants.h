@@ -15,8 +15,11 @@
 // =============================================================================
 #define TICK_MS 95                   // Default game tick duration in milliseconds
 #define MENU_FRAME_DELAY_MS 16       // ~60 FPS for menus
-#define GAME_FRAME_DELAY_MS 1        // Minimal delay for gameplay
+#define MENU_IDLE_WAIT_MS 250        // Longest sleep on a menu with nothing animating
+#define GAME_MAX_WAIT_MS 100         // Longest sleep during gameplay between frames
+#define DEATH_ANIMATION_TICK_MS 50   // One segment removed per death animation step
 #define GAMEOVER_DISPLAY_MS 3000     // How long to show game over screen
+#define LOG_DRAIN_INTERVAL_MS 20     // How often the log thread writes queued records
 
 // Speed curve parameters (singleplayer)
 #define SPEED_START_MS 95.0f         // Starting tick time
@@ -44,6 +47,7 @@
 #define WINDOW_HEIGHT 640
 #define MIN_CELL_SIZE 8
 #define MAX_CELL_SIZE 40
+#define VSYNC_ENABLED 1              // Default for vsync in game_config.ini
 #define LAYOUT_PADDING_CELLS 2
 
 // UI Layout offsets
@@ -55,6 +59,9 @@
 
 // Multiplayer HUD
 #define MP_HUD_PADDING 40            // Padding around board for player stats
+#define PERF_HUD_WIDTH 240           // Debug performance graphs (2 px per sample)
+#define PERF_HUD_GRAPH_HEIGHT 24
+#define PERF_HUD_GRAPH_MS 33.3f      // Graph height in ms (two 60 Hz frames)
 
 // =============================================================================
 // COLOR DEFINITIONS (RGB)
@@ -181,8 +188,6 @@
 // =============================================================================
 // Note: MAIN_MENU_COUNT and OPTIONS_MENU_COUNT are defined as enums in main.c
 #define PAUSE_MENU_COUNT 3          // Resume, Options, Quit
-#define MAX_SNAKE_LEN 256
-#define INPUT_BUFFER_SIZE 2
 #define SCOREBOARD_TOP_N 5
 
 #endif // CONSTANTS_H
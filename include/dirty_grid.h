@@ -0,0 +1,59 @@
+#ifndef DIRTY_GRID_H
+#define DIRTY_GRID_H
+
+#include <stdint.h>
+#include "draw_list.h"
+
+/**
+ * What a persistent render target shows on each cell of a board, kept so a
+ * frame can repaint only the cells that changed since the last one.
+ *
+ * Each cell holds a digest of the quads that were drawn over it, in order.
+ * A quad that lies across several cells (a snake segment sliding between
+ * cells) makes all of them count as changed, this frame and the next.
+ */
+typedef struct {
+    uint32_t *keys;             // Per cell: digest of what the target shows
+    uint32_t *next;             // ... of this frame's quads, while diffing
+    DrawQuad *kept;             // Scratch for the quads that land on changed cells
+    int kept_capacity;
+
+    int origin_x, origin_y;     // Pixel position of cell (0, 0)
+    int cell;                   // Cell size in pixels
+    int width, height;          // Board size in cells
+    int valid;                  // keys describe the target's current contents
+} DirtyGrid;
+
+void dirty_grid_init(DirtyGrid *g);
+void dirty_grid_free(DirtyGrid *g);
+
+/**
+ * Forget what the target shows (it was lost, resized or drawn over): the
+ * next frame has to be drawn in full.
+ */
+void dirty_grid_invalidate(DirtyGrid *g);
+
+/**
+ * Start a frame laid out at `origin_x`, `origin_y` with `cell` pixel cells
+ * on a `width` x `height` board. Returns 1 if the target holds the last
+ * frame of this same layout, so dirty_grid_repaint may be used; 0 if the
+ * frame has to be drawn in full and passed to dirty_grid_record.
+ */
+int dirty_grid_begin(DirtyGrid *g, int origin_x, int origin_y, int cell, int width, int height);
+
+/**
+ * Turn `dl`, holding every quad this frame puts on the board in drawing
+ * order, into just what has to be drawn over the last frame: a
+ * `background` quad for each changed cell, then the quads on changed cells.
+ * Returns 0, leaving `dl` alone, if a quad falls outside the board (the
+ * frame has to be drawn in full).
+ */
+int dirty_grid_repaint(DirtyGrid *g, DrawList *dl, SDL_Color background);
+
+/**
+ * Remember the quads in `dl` as what the target shows after a full redraw
+ * (background, then `dl`).
+ */
+void dirty_grid_record(DirtyGrid *g, const DrawList *dl);
+
+#endif
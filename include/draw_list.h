@@ -0,0 +1,62 @@
+#ifndef DRAW_LIST_H
+#define DRAW_LIST_H
+
+#include <SDL2/SDL.h>
+
+#define DRAW_LIST_INITIAL_QUADS 256 // Room reserved on first use, doubled when full
+
+typedef struct {
+    SDL_Rect rect;
+    SDL_Color color;
+} DrawQuad;
+
+/**
+ * Solid colored rectangles collected over a frame and submitted together.
+ *
+ * With SDL 2.0.18 or later a flush is a single SDL_RenderGeometry call;
+ * older SDL, or a list with `fill_rects` set, gets one SDL_RenderFillRects
+ * call per run of same-colored quads. Quads are drawn in the order they
+ * were added, with the renderer's draw blend mode at the time of the
+ * flush, so a list holds one blend state: flush it before switching.
+ */
+typedef struct {
+    SDL_Renderer *ren;
+    DrawQuad *quads;
+    int count;
+    int capacity;
+    int fill_rects;             // Skip SDL_RenderGeometry (the software renderer
+                                // fills rects with memset, triangles pixel by pixel)
+
+    SDL_Vertex *verts;          // Flush scratch, 4 per quad
+    int *indices;               // ... 6 per quad
+    int scratch_capacity;       // Quads the scratch arrays hold
+} DrawList;
+
+void draw_list_init(DrawList *dl, SDL_Renderer *ren);
+void draw_list_free(DrawList *dl);
+
+void draw_list_rect(DrawList *dl, int x, int y, int w, int h, SDL_Color c);
+
+/**
+ * Filled rectangle with a one pixel black outline (what
+ * ui_draw_filled_rect_with_outline draws), as two quads.
+ */
+void draw_list_rect_outlined(DrawList *dl, int x, int y, int w, int h, SDL_Color c);
+
+/**
+ * One pixel outline of a rectangle (what SDL_RenderDrawRect draws), as
+ * four quads.
+ */
+void draw_list_outline(DrawList *dl, int x, int y, int w, int h, SDL_Color c);
+
+/**
+ * Submit everything added since the last flush and empty the list.
+ */
+void draw_list_flush(DrawList *dl);
+
+/**
+ * Drop everything added since the last flush without drawing it.
+ */
+void draw_list_clear(DrawList *dl);
+
+#endif
@@ -0,0 +1,110 @@
+#ifndef ENV_H
+#define ENV_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "config.h"
+#include "game.h"
+#include "multiplayer_game.h"
+#include "sim.h"
+
+#define ENV_ACTION_NONE 0xFF   // Keep the current direction
+
+/**
+ * Observation planes, in buffer order.
+ */
+typedef enum {
+    ENV_PLANE_HEAD,      // The agent's own head
+    ENV_PLANE_BODY_AGE,  // Snake cells: ticks until the cell is vacated (tail = 1)
+    ENV_PLANE_FOOD,      // Food
+    ENV_PLANE_WALL,      // The border ring around the board
+    ENV_PLANE_COUNT
+} EnvPlane;
+
+/**
+ * Observation encoding. ENV_OBS_U8 uses one byte per cell (255 for set cells,
+ * body age clamped to 255). ENV_OBS_BITS packs one bit per cell, LSB first,
+ * with each plane starting on a byte boundary; the body plane then only says
+ * whether a cell is taken.
+ */
+typedef enum {
+    ENV_OBS_U8,
+    ENV_OBS_BITS
+} EnvObsFormat;
+
+typedef enum {
+    ENV_SINGLEPLAYER,    // One agent playing a Game
+    ENV_MULTIPLAYER      // 1 to MAX_PLAYERS agents sharing a MultiplayerGame_s
+} EnvMode;
+
+/**
+ * Reinforcement-learning environment over the core game rules.
+ *
+ * Observations cover the board plus a one-cell wall border, so every plane is
+ * (width + 2) x (height + 2) cells, row-major. In multiplayer the body plane
+ * shows every snake and the head plane only the observing agent's head.
+ * Time is virtual: the singleplayer game runs on a SimClock (speed and combo
+ * windows as in the SDL game), multiplayer at a fixed cfg->tick_ms per step.
+ * A snake that collides is removed at once (the death animation is played
+ * out inside the step). Multiplayer episodes have one life per agent.
+ */
+typedef struct {
+    EnvMode mode;
+    int agents;               // Number of agents (1 in singleplayer)
+    int width;                // Board size
+    int height;
+    int obs_width;            // width + 2
+    int obs_height;           // height + 2
+    GameConfig cfg;
+    int done;                 // 1 once the episode is over
+
+    Game game;                // ENV_SINGLEPLAYER state
+    SimClock clock;
+
+    MultiplayerGame_s mp;     // ENV_MULTIPLAYER state
+    unsigned int mp_time;     // Virtual time of the last multiplayer tick (ms)
+    int mp_done[MAX_PLAYERS]; // Agents whose snake has died
+} Env;
+
+/**
+ * Set up an environment. Singleplayer uses cfg->sp_board_width/height and
+ * needs agents == 1; multiplayer takes 1 to MAX_PLAYERS agents on
+ * cfg->mp_board_width/height, which must fit the fixed start positions
+ * (at least MULTIPLAYER_BOARD_WIDTH x MULTIPLAYER_BOARD_HEIGHT). The Env must be
+ * zero-filled or released with env_free first. Call env_reset before stepping.
+ * Returns 1 on success, 0 on bad arguments.
+ */
+int env_init(Env *env, EnvMode mode, int agents, const GameConfig *cfg);
+
+/**
+ * Release the game state. Safe on a zero-filled Env.
+ */
+void env_free(Env *env);
+
+/**
+ * Start a new episode; every random choice comes from `seed`.
+ */
+void env_reset(Env *env, uint64_t seed);
+
+/**
+ * Advance one tick. actions[a] is agent a's Direction or ENV_ACTION_NONE
+ * (NULL keeps every direction). Per agent, writes the points scored this step
+ * (combo multiplier included) to rewards, 1 to dones once its snake has died
+ * or the episode is over, and the current combo streak to combo_counts. Any
+ * output array may be NULL. Stepping a finished episode changes nothing.
+ * Returns 1 when the episode is over.
+ */
+int env_step(Env *env, const uint8_t *actions, float *rewards, uint8_t *dones,
+             int32_t *combo_counts);
+
+/**
+ * Bytes one agent's observation takes in `format` (all ENV_PLANE_COUNT planes).
+ */
+size_t env_obs_size(const Env *env, EnvObsFormat format);
+
+/**
+ * Write agent's observation straight into `out` (env_obs_size bytes).
+ */
+void env_observe(const Env *env, int agent, EnvObsFormat format, uint8_t *out);
+
+#endif
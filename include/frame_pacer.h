@@ -0,0 +1,41 @@
+#ifndef FRAME_PACER_H
+#define FRAME_PACER_H
+
+#include <stdint.h>
+#include "tick_scheduler.h"
+
+/**
+ * Decides how long the main loop may sleep between frames, on the same
+ * high-resolution counter as TickScheduler.
+ *
+ * The loop wakes for whichever comes first: the next game tick, the next
+ * frame at the display's refresh rate, or input (the caller waits on the
+ * event queue with the returned timeout). With vsync, SDL_RenderPresent
+ * already blocks until the display is ready, so frames are always due.
+ */
+typedef struct {
+    uint64_t freq;          // Counter units per second
+    uint64_t period;        // Counter units per frame, 0 when vsync paces frames
+    uint64_t next;          // When the next frame is due
+} FramePacer;
+
+/**
+ * Set up a pacer for a display refreshing `refresh_hz` times per second
+ * (60 if unknown). With `vsync` set, frames are never waited for.
+ */
+void frame_pacer_init(FramePacer *fp, uint64_t freq, int refresh_hz, int vsync);
+
+/**
+ * Record that a frame was presented at `now`; the next is due one period on.
+ */
+void frame_pacer_presented(FramePacer *fp, uint64_t now);
+
+/**
+ * Milliseconds to sleep at `now` before the next frame or the next tick of
+ * `ts` is due (NULL or paused: frames only), rounded up so the caller never
+ * wakes just short of a deadline and spins. Never more than `max_ms`.
+ */
+unsigned int frame_pacer_wait_ms(const FramePacer *fp, const TickScheduler *ts, uint64_t now,
+                                 unsigned int max_ms);
+
+#endif
@@ -4,6 +4,19 @@
 #include "common.h"
 #include "board.h"
 #include "snake.h"
+#include "segment_pool.h"
+#include "rng.h"
+#include "config.h"
+#include "timer_wheel.h"
+
+#define POINTS_PER_FOOD 10  // Base points per food, multiplied by the combo multiplier
+
+/**
+ * Kinds of timer on a Game's wheel.
+ */
+typedef enum {
+    GAME_TIMER_COMBO = 0   // Combo window ran out
+} GameTimerKind;
 
 /**
  * Core game state containing board, snake, game status, and score.
@@ -11,7 +24,11 @@
 typedef struct {
     Board board;           // Game board with food
     Snake snake;           // Snake state (position, length, direction)
+    SegmentPool pool;      // Segment storage for the snake
+    Rng rng;               // Food placement randomness
+    uint64_t seed;         // Seed rng started from (replays the game exactly)
     GameState state;       // Current game state (RUNNING or GAME_OVER)
+    int won;               // 1 if the snake filled the board (state is GAME_OVER)
     int score;             // Current score
     int fruits_eaten;      // Number of fruits eaten
     unsigned int start_time; // Game start time (milliseconds)
@@ -23,22 +40,35 @@ typedef struct {
     int combo_window_ms;   // Time window for combo in milliseconds
     int combo_best;        // Best combo achieved this game
     int food_eaten_this_frame; // Flag: 1 if food was eaten this update
+
+    // Timed events (combo expiry), on the caller's millisecond clock
+    TimerWheel timers;
+    int combo_timer;       // Handle of the pending combo expiry
 } Game;
 
 /**
  * Initialize a new game with specified board dimensions.
- * Places snake at center and spawns initial food.
+ * Places snake at center and spawns initial food; if the snake already fills
+ * the board, the game starts won (GAME_OVER with won set). Every random choice in the
+ * game comes from `seed`, so the same seed and inputs replay the same game.
+ * The Game must be zero-filled or released with game_free first.
  */
-void game_init(Game *g, int width, int height);
+void game_init(Game *g, int width, int height, uint64_t seed);
 
 /**
- * Reset game to initial state, keeping same board dimensions.
+ * Release segment storage and the board occupancy grid. Safe on a zero-filled Game.
+ */
+void game_free(Game *g);
+
+/**
+ * Reset game to initial state, keeping same board dimensions and seed.
  */
 void game_reset(Game *g);
 
 /**
  * Update game state by one tick - move snake, check collisions, handle food.
- * Sets state to GAME_OVER if collision detected.
+ * Sets state to GAME_DYING if collision detected, or to GAME_OVER with
+ * won set when the snake has filled the board and no food can be placed.
  */
 void game_update(Game *g);
 
@@ -55,10 +85,17 @@ void game_change_direction(Game *g, Direction dir);
 int game_update_death_animation(Game *g);
 
 /**
- * Update combo timer - checks if combo has expired.
- * Call this each frame with current time.
+ * Run the game's timers up to `now` (combo expiry). Call each frame, or
+ * before a tick, with the current time. Costs nothing when none are due.
  */
-void game_update_combo_timer(Game *g, unsigned int current_time);
+void game_update_timers(Game *g, unsigned int now);
+
+/**
+ * (Re)start the combo window: the combo ends combo_window_ms after `now`
+ * unless food is eaten again first. Call after a tick that ate food, once
+ * combo_window_ms is set for the new speed.
+ */
+void game_start_combo_timer(Game *g, unsigned int now);
 
 /**
  * Get combo tier (1-5) based on current combo count.
@@ -71,4 +108,16 @@ int game_get_combo_tier(int combo_count);
  */
 int game_get_combo_multiplier(int combo_count);
 
+/**
+ * Tick duration for a combo streak: decays exponentially from cfg->tick_ms
+ * toward cfg->speed_floor_ms at rate cfg->speed_curve_k per combo step.
+ */
+int game_tick_ms_for_combo(const GameConfig *cfg, int combo_count);
+
+/**
+ * Combo window after eating food at tick speed tick_ms.
+ * Higher combo tiers get extra ticks (cfg->combo_window_increase_per_tier).
+ */
+unsigned int game_combo_window_ms(const GameConfig *cfg, int tick_ms, int combo_count);
+
 #endif
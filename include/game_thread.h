@@ -0,0 +1,115 @@
+#ifndef GAME_THREAD_H
+#define GAME_THREAD_H
+
+#include <SDL2/SDL.h>
+#include "game.h"
+#include "config.h"
+#include "input_buffer.h"
+#include "latency.h"
+#include "tick_scheduler.h"
+#include "triple_buffer.h"
+
+/**
+ * One published state of a singleplayer game, as the renderer sees it.
+ * game is a copy whose snake reads from `cells` (head first); its pool and
+ * occupancy grid are not usable. Sounds are running counts, so a renderer
+ * that skips frames still hears that something happened.
+ */
+typedef struct
+{
+    Game game;                  // Copy of the game after the last tick
+    Vec2 *cells;                // Storage behind game.snake
+    int cells_capacity;         // Power of two, at least the board size
+    TickScheduler ticks;        // Tick clock when published (for interpolation)
+    unsigned int tick_ms;       // Tick length at publish time (HUD, speed effects)
+    unsigned int combo_sounds;  // Food pickups so far (play the combo sound)
+    int combo_tier;             // Combo tier of the latest pickup
+    unsigned int explosions;    // Death animation steps so far
+    LatencyTrail inputs;        // Presses applied by ticks so far (latency measurement)
+    float tick_late_ms;         // How long after its deadline the last tick ran (performance HUD)
+} GameFrame;
+
+/**
+ * Runs a singleplayer Game on its own thread so tick timing does not depend
+ * on rendering, vsync or compositor stalls.
+ *
+ * The render thread pushes direction presses onto `input` (lock-free, no
+ * request needed), sends pause requests, and reads the newest GameFrame
+ * through a lock-free triple buffer. Between game_thread_start and
+ * game_thread_stop the Game belongs to the simulation thread; the caller
+ * must not touch it.
+ *
+ * Singleplayer only. Online rounds still tick MultiplayerGame_s on the main
+ * thread between polling, network sends and presents: moving them needs a
+ * multi-snake frame copy, a handoff of the game between the lobby and the
+ * thread, and the network inbox and sends driven from the thread.
+ */
+typedef struct
+{
+    SDL_Thread *thread;
+    SDL_mutex *lock;            // Guards the request fields below and the game while ticking
+    SDL_cond *wake;             // Signalled on every request
+
+    // Requests from the render thread (under lock)
+    int stop;
+    int paused;
+
+    // Direction presses: render thread produces, game thread consumes per tick
+    InputBuffer input;
+
+    // Simulation thread state
+    Game *game;
+    const GameConfig *config;
+    TickScheduler ticks;
+    unsigned int tick_ms;
+    unsigned int combo_sounds;
+    int combo_tier;
+    unsigned int explosions;
+    LatencyTrail inputs;
+    float tick_late_ms;
+
+    // Handoff
+    GameFrame frames[3];
+    TripleBuffer buffer;
+
+    // Sounds the render thread has already played
+    unsigned int heard_combo_sounds;
+    unsigned int heard_explosions;
+    unsigned int seen_inputs;   // Applied presses already on screen
+} GameThread;
+
+/**
+ * Create the lock and condition variable. Returns 1 on success.
+ */
+int game_thread_init(GameThread *gt);
+
+/**
+ * Stop the thread if running and free everything.
+ */
+void game_thread_free(GameThread *gt);
+
+/**
+ * Start simulating `g` (already set up with game_init) with ticks of
+ * `tick_ms`. Publishes the initial state before returning.
+ * Returns 1 on success, 0 if the thread or frame storage could not be created.
+ */
+int game_thread_start(GameThread *gt, Game *g, const GameConfig *cfg, unsigned int tick_ms);
+
+/**
+ * Stop and join the thread. The Game belongs to the caller again.
+ * Safe to call when not running.
+ */
+void game_thread_stop(GameThread *gt);
+
+/**
+ * Freeze or unfreeze the game clock (the pause menu).
+ */
+void game_thread_pause(GameThread *gt);
+void game_thread_resume(GameThread *gt);
+
+/**
+ * Newest published frame. Render thread only; valid until the next call.
+ */
+const GameFrame *game_thread_latest(GameThread *gt);
+
+#endif
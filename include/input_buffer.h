@@ -1,41 +1,72 @@
 #ifndef INPUT_BUFFER_H
 #define INPUT_BUFFER_H
 
+#include <stdatomic.h>
 #include "common.h"
 
-#define INPUT_BUFFER_SIZE 2
+#define INPUT_BUFFER_MAX_DEPTH 32     // Storage per buffer (power of two)
+#define INPUT_BUFFER_DEFAULT_DEPTH 8  // Queued inputs before new ones are dropped
 
 /**
- * Input buffer for queuing direction changes between game ticks.
- * Prevents missed inputs when player presses keys faster than game updates.
- * Capacity of 2 allows for one queued turn (e.g., right then down in quick succession).
+ * One direction key press and when it happened (SDL_Event timestamp, ms).
  */
 typedef struct {
-    Direction buf[INPUT_BUFFER_SIZE];  // Buffered direction inputs
-    int count;                          // Number of buffered inputs (0-2)
+    Direction dir;
+    unsigned int time_ms;
+} InputEvent;
+
+/**
+ * Queue of direction presses between game ticks: a lock-free
+ * single-producer/single-consumer ring, so an input or network thread can
+ * push while the simulation pops at tick boundaries.
+ *
+ * Presses are queued as they arrive and checked when popped, against the
+ * direction the snake has at that tick: repeats and 180-degree turns are
+ * skipped there, so any number of quick turns between two ticks (up to the
+ * depth) play out one per tick instead of being lost.
+ *
+ * The storage lives inside the struct, so games holding buffers can still
+ * be copied (snapshots).
+ */
+typedef struct {
+    InputEvent buf[INPUT_BUFFER_MAX_DEPTH];
+    unsigned int mask;          // Depth - 1
+    atomic_uint head;           // Next slot the producer writes (producer-owned)
+    atomic_uint tail;           // Next slot the consumer reads (consumer-owned)
 } InputBuffer;
 
 /**
- * Initialize input buffer to empty state.
+ * Initialize an empty buffer of INPUT_BUFFER_DEFAULT_DEPTH.
  */
 void input_buffer_init(InputBuffer *ib);
 
 /**
- * Clear all buffered inputs.
+ * Initialize an empty buffer holding `depth` presses, rounded up to a power
+ * of two and clamped to 1..INPUT_BUFFER_MAX_DEPTH.
+ */
+void input_buffer_init_depth(InputBuffer *ib, int depth);
+
+/**
+ * Drop every queued press. Consumer side (or while no producer is running).
  */
 void input_buffer_clear(InputBuffer *ib);
 
 /**
- * Push a direction input into the buffer.
- * Ignores duplicate directions and 180-degree turns.
- * Returns 1 if input was buffered, 0 if rejected or buffer full.
+ * Queue a press. Producer side.
+ * Returns 1 if queued, 0 if the buffer is full (the press is dropped).
+ */
+int  input_buffer_push(InputBuffer *ib, Direction dir, unsigned int time_ms);
+
+/**
+ * Take the oldest press that is a valid turn from `current_dir` (not the
+ * same direction, not a 180), discarding invalid ones before it.
+ * Consumer side. Returns 1 and fills *out, or 0 if none is queued.
  */
-int  input_buffer_push(InputBuffer *ib, Direction dir, Direction current_dir);
+int  input_buffer_pop(InputBuffer *ib, Direction current_dir, InputEvent *out);
 
 /**
- * Pop the next direction from the buffer (FIFO).
- * Returns 1 and sets out_dir if buffer not empty, 0 otherwise.
+ * Number of queued presses (approximate while the other side is running).
  */
-int  input_buffer_pop(InputBuffer *ib, Direction *out_dir);
+int  input_buffer_count(const InputBuffer *ib);
 
 #endif
@@ -0,0 +1,97 @@
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include <stdint.h>
+
+#define LATENCY_MAX_MS 250          // Histogram range; slower samples land in the last bucket
+#define LATENCY_TRAIL_SIZE 8        // Consumed inputs remembered between two presented frames
+#define LATENCY_MAX_CHANNELS 8      // App states measured separately
+
+/**
+ * Input-to-photon latency measurement.
+ *
+ * Every direction press keeps its SDL event timestamp. The tick that applies
+ * it appends a LatencySample to a LatencyTrail; the frame that first shows
+ * that tick's result reports the trail to a LatencyChannel, which adds two
+ * samples: input to tick (queueing, tick alignment) and input to present
+ * (the whole pipeline). All times are SDL_GetTicks milliseconds.
+ */
+typedef struct {
+    unsigned int input_ms;  // SDL event timestamp of the key press
+    unsigned int tick_ms;   // When the tick that applied it ran
+    uint64_t tick;          // Which tick that was
+} LatencySample;
+
+/**
+ * Running log of the inputs ticks have applied. `count` only grows, so a
+ * reader that skips published frames still sees (up to the last
+ * LATENCY_TRAIL_SIZE of) what it missed.
+ */
+typedef struct {
+    LatencySample samples[LATENCY_TRAIL_SIZE];
+    unsigned int count;
+} LatencyTrail;
+
+/**
+ * 1 ms buckets from 0 to LATENCY_MAX_MS.
+ */
+typedef struct {
+    unsigned int buckets[LATENCY_MAX_MS + 1];
+    unsigned int count;
+    unsigned int max_ms;
+    uint64_t total_ms;
+} LatencyHistogram;
+
+typedef enum {
+    LATENCY_STAGE_TICK = 0,     // Key press to the tick that applied it
+    LATENCY_STAGE_PRESENT,      // Key press to the first frame presented after that tick
+    LATENCY_STAGE_COUNT
+} LatencyStage;
+
+typedef struct {
+    const char *state;                              // App state name (static string)
+    LatencyHistogram stages[LATENCY_STAGE_COUNT];
+} LatencyChannel;
+
+typedef struct {
+    LatencyChannel channels[LATENCY_MAX_CHANNELS];
+    int count;
+} LatencyReport;
+
+void latency_trail_clear(LatencyTrail *t);
+
+/**
+ * Record that the tick numbered `tick`, running at `tick_ms`, applied the
+ * press made at `input_ms`.
+ */
+void latency_trail_add(LatencyTrail *t, unsigned int input_ms, unsigned int tick_ms, uint64_t tick);
+
+void latency_histogram_add(LatencyHistogram *h, unsigned int ms);
+
+/**
+ * Smallest latency that `pct` percent of samples are at or under (0 if empty).
+ */
+unsigned int latency_histogram_percentile(const LatencyHistogram *h, int pct);
+
+void latency_report_init(LatencyReport *r);
+
+/**
+ * Channel for app state `state`, created on first use. `state` must outlive
+ * the report. Returns NULL when all channels are taken.
+ */
+LatencyChannel *latency_report_channel(LatencyReport *r, const char *state);
+
+/**
+ * Add every trail entry after `*seen` to `ch` as shown at `present_ms`, then
+ * advance `*seen`. `ch` may be NULL (instrumentation off): only `*seen` moves.
+ */
+void latency_channel_present(LatencyChannel *ch, const LatencyTrail *t, unsigned int *seen,
+                             unsigned int present_ms);
+
+/**
+ * Write one row per state and stage: samples, mean, p50, p95, p99 and max in ms.
+ * Returns 0 on success, -1 if the file could not be written.
+ */
+int latency_report_write_csv(const LatencyReport *r, const char *path);
+
+#endif
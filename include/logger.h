@@ -0,0 +1,88 @@
+#ifndef LOGGER_H
+#define LOGGER_H
+
+typedef enum {
+    LOG_LEVEL_DEBUG = 0,
+    LOG_LEVEL_INFO,
+    LOG_LEVEL_WARN,
+    LOG_LEVEL_ERROR,
+    LOG_LEVEL_OFF
+} LogLevel;
+
+// Calls below this level are compiled out (build with
+// -DLOG_COMPILED_LEVEL=LOG_LEVEL_INFO to strip every LOG_DEBUG)
+#ifndef LOG_COMPILED_LEVEL
+#define LOG_COMPILED_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+#define LOG_RING_SIZE 256       // Records queued for the drain thread (power of two)
+#define LOG_LINE_MAX 200        // Longest message kept; longer ones are cut
+
+#define LOG_AT(level, tag, ...) \
+    do { \
+        if ((level) >= LOG_COMPILED_LEVEL) \
+            log_write((level), (tag), __VA_ARGS__); \
+    } while (0)
+#define LOG_DEBUG(tag, ...) LOG_AT(LOG_LEVEL_DEBUG, tag, __VA_ARGS__)
+#define LOG_INFO(tag, ...)  LOG_AT(LOG_LEVEL_INFO, tag, __VA_ARGS__)
+#define LOG_WARN(tag, ...)  LOG_AT(LOG_LEVEL_WARN, tag, __VA_ARGS__)
+#define LOG_ERROR(tag, ...) LOG_AT(LOG_LEVEL_ERROR, tag, __VA_ARGS__)
+
+// 1 if a record at `level` would be written: guards work done only to build
+// a message (constant 0 when the level is compiled out)
+#define LOG_ENABLED(level) ((level) >= LOG_COMPILED_LEVEL && log_enabled(level))
+
+/**
+ * Leveled logger: one line per record, "seconds level [tag] message",
+ * seconds counted from the first record.
+ *
+ * By default a record is written as it is logged. In async mode log_write
+ * only formats into a lock-free ring (any number of threads may log) and
+ * returns; one consumer, normally a background thread, writes the ring out
+ * with log_drain. A full ring drops records instead of blocking the caller.
+ */
+
+/**
+ * Records below `level` are skipped at run time (default LOG_LEVEL_INFO).
+ */
+void log_set_level(LogLevel level);
+
+/**
+ * 1 if records at `level` pass the run-time level (see LOG_ENABLED).
+ */
+int log_enabled(LogLevel level);
+
+/**
+ * Send records to `path` (appended), or to stderr when NULL.
+ * Returns 0 on success, -1 if the file could not be opened (stderr is kept).
+ */
+int log_open(const char *path);
+
+/**
+ * Switch async mode on or off. Turn it on before the first producer thread
+ * logs, and off only once the drain thread has stopped (the rest is
+ * written out then).
+ */
+void log_set_async(int async);
+
+#if defined(__GNUC__)
+__attribute__((format(printf, 3, 4)))
+#endif
+void log_write(LogLevel level, const char *tag, const char *fmt, ...);
+
+/**
+ * Write out every queued record. Single consumer. Returns how many were written.
+ */
+int log_drain(void);
+
+/**
+ * Records dropped so far because the ring was full.
+ */
+unsigned int log_dropped(void);
+
+/**
+ * Leave async mode, write out what is queued and close the log file.
+ */
+void log_close(void);
+
+#endif
@@ -5,10 +5,20 @@
 #include "board.h"
 #include "snake.h"
 #include "input_buffer.h"
+#include "segment_pool.h"
+#include "rng.h"
+#include "timer_wheel.h"
 
 #define MAX_PLAYERS 4
 #define MAX_FOOD_ITEMS 32
 
+/**
+ * Kinds of timer on a multiplayer game's wheel.
+ */
+typedef enum {
+    MP_TIMER_COMBO = 0     // A player's combo window ran out (data: player index)
+} MultiplayerTimerKind;
+
 /**
  * Player state in multiplayer game.
  */
@@ -30,6 +40,7 @@ typedef struct {
     unsigned int combo_expiry_time; // When combo expires (milliseconds)
     int combo_best;           // Best combo achieved this game
     int food_eaten_this_frame; // Flag: 1 if food was eaten this update
+    int combo_timer;          // Handle of the pending combo expiry (this instance's wheel)
 
     // Network identity
     char client_id[64];       // mpapi client ID (empty string for local player)
@@ -46,16 +57,21 @@ typedef struct {
  */
 typedef struct MultiplayerGame_s {
     Board board;              // Shared game board
+    SegmentPool pool;         // Segment storage shared by all player snakes
+    Rng rng;                  // Food and spawn randomness for this match
+    uint64_t seed;            // Seed rng started from (replays the match)
     MultiplayerPlayer players[MAX_PLAYERS];  // Player states
     Vec2 food[MAX_FOOD_ITEMS]; // Food positions
     int food_count;           // Number of active food items
     int active_players;       // Number of players currently alive
     int total_joined;         // Total number of players who joined
+    unsigned int updates;     // multiplayer_game_update calls so far (debug sampling)
 
     // Network state
     int is_host;              // 1 if local instance is host, 0 if client
     int local_player_index;   // Which player slot is local (-1 if spectating)
     unsigned int combo_window_ms; // Combo timer window (based on tick speed)
+    TimerWheel timers;        // Timed events of the snakes simulated here (combo expiry)
 
     // Session info
     char session_id[8];       // 6-char session ID + null terminator
@@ -79,8 +95,17 @@ static const PlayerColor PLAYER_COLORS[MAX_PLAYERS] = {
 
 /**
  * Initialize multiplayer game with specified board dimensions.
+ * Food and spawn positions on this instance are drawn from `seed`.
+ * Every field is set: network fields start offline (not host, no local
+ * player, empty session) for the online code to fill in.
+ * The game must be zero-filled or released with multiplayer_game_free first.
+ */
+void multiplayer_game_init(MultiplayerGame_s *mg, int width, int height, uint64_t seed);
+
+/**
+ * Release player snake storage and the board occupancy grid. Safe on a zero-filled game.
  */
-void multiplayer_game_init(MultiplayerGame_s *mg, int width, int height);
+void multiplayer_game_free(MultiplayerGame_s *mg);
 
 /**
  * Add a player to the game (called when player presses USE in lobby).
@@ -126,4 +151,23 @@ int multiplayer_game_update_death_animations(MultiplayerGame_s *mg);
  */
 void multiplayer_game_add_food(MultiplayerGame_s *mg, Vec2 pos);
 
+/**
+ * Run the game's timers up to `now` (combo expiry). Call once per tick with
+ * the current time, after starting the combo timers of the snakes that ate.
+ */
+void multiplayer_game_update_timers(MultiplayerGame_s *mg, unsigned int now);
+
+/**
+ * (Re)start a player's combo window: the combo ends combo_window_ms after
+ * `now` unless that player eats again first.
+ */
+void multiplayer_game_start_combo_timer(MultiplayerGame_s *mg, int player_index, unsigned int now);
+
+/**
+ * End a player's combo now (respawn, new round, player left): count and
+ * expiry back to 0 and the pending expiry timer cancelled, so it cannot
+ * fire later on the reset player.
+ */
+void multiplayer_game_clear_combo(MultiplayerGame_s *mg, int player_index);
+
 #endif
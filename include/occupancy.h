@@ -0,0 +1,97 @@
+#ifndef OCCUPANCY_H
+#define OCCUPANCY_H
+
+#include "common.h"
+
+/**
+ * Per-board occupancy grid for O(1) collision queries.
+ * Each owner (snake) has its own plane of width*height cells. A cell holds the
+ * age of the newest segment that owner has on it, or 0 if the owner has no
+ * segment there. Ages count up as the head advances, so the age also tells
+ * which segment a cell belongs to (head, tail, ...).
+ *
+ * Snakes bound to the grid keep it up to date themselves on every head push
+ * and tail pop; see snake_storage_init. Separate planes let snakes overlap
+ * (e.g. for a tick of network lag) without one snake erasing another.
+ *
+ * The grid also keeps the set of cells no snake is on, as a dense array plus
+ * a cell -> slot index (swap-remove on take, append on free), so a uniformly
+ * random free cell is a single draw no matter how full the board is.
+ */
+typedef struct {
+    int width;
+    int height;
+    int owners;             // Number of planes
+    unsigned int *ages;     // owners * width * height segment ages, 0 = empty
+    unsigned short *takers; // Per cell: planes with a segment there + holds
+    int *free_cells;        // Dense list of cells with no takers
+    int *free_slot;         // Per cell: index in free_cells, -1 if taken
+    int free_count;         // Number of entries in free_cells
+} OccupancyGrid;
+
+/**
+ * Allocate an empty grid with every cell free. Returns 1 on success, 0 on
+ * allocation failure (the grid then has no storage: nothing is recorded and
+ * there are no free cells).
+ */
+int occupancy_init(OccupancyGrid *g, int width, int height, int owners);
+
+/**
+ * Free the grid storage. Safe on a zero-filled grid.
+ */
+void occupancy_free(OccupancyGrid *g);
+
+/**
+ * Age of the newest segment `owner` has at pos, or 0 if none.
+ * Out-of-bounds positions and unknown owners are always empty.
+ */
+static inline unsigned int occupancy_age(const OccupancyGrid *g, int owner, Vec2 pos)
+{
+    if (!g->ages || owner < 0 || owner >= g->owners ||
+        pos.x < 0 || pos.x >= g->width || pos.y < 0 || pos.y >= g->height) {
+        return 0;
+    }
+    return g->ages[(owner * g->height + pos.y) * g->width + pos.x];
+}
+
+/**
+ * Check if no snake (and no hold) is on pos. Out-of-bounds is never free.
+ */
+static inline int occupancy_is_free(const OccupancyGrid *g, Vec2 pos)
+{
+    if (!g->takers || pos.x < 0 || pos.x >= g->width || pos.y < 0 || pos.y >= g->height) {
+        return 0;
+    }
+    return g->takers[pos.y * g->width + pos.x] == 0;
+}
+
+/**
+ * Get free cell number n (0 <= n < free_count) into *out.
+ * Returns 1 on success, 0 if n is out of range.
+ */
+int occupancy_free_cell(const OccupancyGrid *g, int n, Vec2 *out);
+
+/**
+ * Temporarily take pos out of the free set without a snake on it, e.g. to
+ * keep a random draw off existing food. Undo with occupancy_unhold.
+ */
+void occupancy_hold(OccupancyGrid *g, Vec2 pos);
+
+/**
+ * Undo one occupancy_hold on pos.
+ */
+void occupancy_unhold(OccupancyGrid *g, Vec2 pos);
+
+/**
+ * Record a segment of `owner` at pos. The cell keeps whichever of the old and
+ * new age is newer, so rebuilding a snake tail-last never hides its head.
+ */
+void occupancy_mark(OccupancyGrid *g, int owner, Vec2 pos, unsigned int age);
+
+/**
+ * Remove the segment with `age` from pos. The cell is only cleared if that
+ * segment is the one recorded there (a newer segment on the same cell stays).
+ */
+void occupancy_unmark(OccupancyGrid *g, int owner, Vec2 pos, unsigned int age);
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef ONLINE_MULTIPLAYER_H
 #define ONLINE_MULTIPLAYER_H
 
+#include <SDL2/SDL.h>
 #include "multiplayer_game.h"
 #include "../src/mpapi/c_client/libs/mpapi.h"
 #include "../src/mpapi/c_client/libs/jansson/jansson.h"
@@ -14,6 +15,15 @@ typedef enum {
     ONLINE_STATE_DISCONNECTED    // Connection lost
 } OnlineState;
 
+// An mpapi event received on the listener thread, waiting for the main thread
+typedef struct OnlineEvent {
+    struct OnlineEvent *next;
+    char event[16];              // "joined", "leaved", "game", "closed"
+    char client_id[64];          // Sender ("" if none)
+    json_t *data;                // Our own copy (NULL if none)
+    unsigned int received_ms;    // SDL_GetTicks() on arrival
+} OnlineEvent;
+
 typedef struct {
     mpapi *api;                  // mpapi instance
     int listener_id;             // Event listener ID
@@ -30,14 +40,27 @@ typedef struct {
     int has_pending_input;       // 1 if input queued
     char our_client_id[64];      // Our mpapi client ID (for identifying ourselves)
 
+    // Randomness
+    int seed_fixed;              // 1 if every round this instance hosts replays `seed` (--seed)
+    uint64_t seed;
+
     // Synchronized game timing
     unsigned int game_start_timestamp; // Synchronized timestamp when game should start (after countdown)
+
+    // Events queued by the listener thread; only online_multiplayer_poll
+    // applies them, so the game is never touched off the main thread
+    SDL_mutex *inbox_lock;       // Guards the two pointers below
+    OnlineEvent *inbox_head;
+    OnlineEvent *inbox_tail;
 } OnlineMultiplayerContext;
 
 // Lifecycle
 OnlineMultiplayerContext* online_multiplayer_create(void);
 void online_multiplayer_destroy(OnlineMultiplayerContext *ctx);
 
+// Apply the events received since the last call (main thread, once per frame)
+void online_multiplayer_poll(OnlineMultiplayerContext *ctx);
+
 // Host operations
 int online_multiplayer_host(OnlineMultiplayerContext *ctx, int is_private, int board_width, int board_height, const char *player_name);
 void online_multiplayer_host_update(OnlineMultiplayerContext *ctx, unsigned int current_time);
@@ -45,7 +68,8 @@ void online_multiplayer_host_broadcast_state(OnlineMultiplayerContext *ctx);
 
 // Client operations
 int online_multiplayer_join(OnlineMultiplayerContext *ctx, const char *session_id, int board_width, int board_height, const char *player_name);
-void online_multiplayer_client_send_input(OnlineMultiplayerContext *ctx, Direction dir);
+// Queue `dir`, pressed at `time_ms` (SDL event time), and send it to the host
+void online_multiplayer_client_send_input(OnlineMultiplayerContext *ctx, Direction dir, unsigned int time_ms);
 
 // Common operations
 void online_multiplayer_start_game(OnlineMultiplayerContext *ctx);
@@ -54,6 +78,12 @@ void online_multiplayer_toggle_ready(OnlineMultiplayerContext *ctx);
 int online_multiplayer_all_players_ready(OnlineMultiplayerContext *ctx);
 void online_multiplayer_reset_ready_states(OnlineMultiplayerContext *ctx);
 
+// Send a game message (mpapi_game to all peers); returns the mpapi result
+int online_multiplayer_send(mpapi *api, json_t *msg);
+
+// Messages sent and received since startup (all sessions)
+void online_multiplayer_traffic(unsigned int *sent, unsigned int *received);
+
 // JSON serialization
 json_t* online_multiplayer_serialize_state(MultiplayerGame_s *game);
 void online_multiplayer_deserialize_state(MultiplayerGame_s *game, json_t *data);
@@ -0,0 +1,85 @@
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include <stdint.h>
+
+#define PERF_HISTORY 120            // Samples per graph (2 s of frames at 60 Hz)
+#define PERF_RATE_WINDOW_MS 1000    // Network rates are counted over this span
+
+typedef enum {
+    PERF_FRAME = 0,     // Present to present
+    PERF_TICK_JITTER,   // How late each tick ran after its deadline
+    PERF_RENDER,        // Drawing a frame, up to its present
+    PERF_PRESENT,       // SDL_RenderPresent (includes waiting for vsync)
+    PERF_AUDIO,         // One run of the audio mixing callback
+    PERF_SERIES_COUNT
+} PerfSeriesId;
+
+/**
+ * Rolling window of the last PERF_HISTORY samples, in milliseconds.
+ */
+typedef struct {
+    float samples[PERF_HISTORY];
+    unsigned int count;     // Samples added so far; the next goes to count % PERF_HISTORY
+} PerfSeries;
+
+/**
+ * Figures behind the --debug performance HUD. Filled on the render thread
+ * (samples from other threads are handed over by their owners).
+ */
+typedef struct {
+    PerfSeries series[PERF_SERIES_COUNT];
+    unsigned int draw_calls;        // Issued for the last presented frame
+    float sent_per_s;               // Network messages over the last full window
+    float received_per_s;
+    unsigned int rate_window_ms;    // Start of the current rate window
+    unsigned int rate_sent;         // Message totals at that moment
+    unsigned int rate_received;
+    uint64_t tick_seen;             // Newest tick already sampled
+    unsigned int audio_seen;        // Audio callbacks already sampled
+} PerfStats;
+
+void perf_stats_init(PerfStats *p);
+
+void perf_series_add(PerfSeries *s, float ms);
+
+/**
+ * Newest sample (0 if empty).
+ */
+float perf_series_last(const PerfSeries *s);
+
+/**
+ * Mean and maximum over the window (0 if empty).
+ */
+void perf_series_summary(const PerfSeries *s, float *avg, float *max);
+
+/**
+ * Sample `i` counted back from the newest (0 = newest). `i` must be below
+ * the number of samples held.
+ */
+float perf_series_at(const PerfSeries *s, unsigned int i);
+
+/**
+ * Number of samples held (at most PERF_HISTORY).
+ */
+unsigned int perf_series_size(const PerfSeries *s);
+
+/**
+ * Sample how late tick number `tick` ran, once per tick however often the
+ * same tick is reported.
+ */
+void perf_stats_tick(PerfStats *p, uint64_t tick, float late_ms);
+
+/**
+ * Sample the audio callback's last duration, once per callback (`calls` is
+ * the running callback count).
+ */
+void perf_stats_audio(PerfStats *p, unsigned int calls, unsigned int time_us);
+
+/**
+ * Feed running totals of network messages at `now_ms`; the rates move
+ * once per PERF_RATE_WINDOW_MS.
+ */
+void perf_stats_net(PerfStats *p, unsigned int now_ms, unsigned int sent_total, unsigned int received_total);
+
+#endif
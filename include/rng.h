@@ -0,0 +1,38 @@
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+/**
+ * Small seedable pseudo-random generator (PCG32, XSH-RR output).
+ * Each game owns one, so a match is reproducible from its seed and
+ * independent games never contend on libc's global rand() state.
+ */
+typedef struct {
+    uint64_t state;
+    uint64_t inc;           // Stream selector (always odd)
+} Rng;
+
+/**
+ * Seed the generator. The same seed always produces the same sequence.
+ */
+void rng_seed(Rng *r, uint64_t seed);
+
+/**
+ * Next 32 random bits.
+ */
+uint32_t rng_next(Rng *r);
+
+/**
+ * Uniform integer in [0, bound) without modulo bias. Returns 0 if bound <= 0.
+ */
+int rng_below(Rng *r, int bound);
+
+/**
+ * A fresh seed from the clock, for games that are not replaying a run.
+ * Successive calls return different seeds even within the same second,
+ * also when made from several threads at once.
+ */
+uint64_t rng_entropy_seed(void);
+
+#endif
@@ -0,0 +1,57 @@
+#ifndef SEGMENT_POOL_H
+#define SEGMENT_POOL_H
+
+#include <stdatomic.h>
+#include "common.h"
+
+#define SEGMENT_POOL_MIN_BLOCK 8          // Smallest block in segments (power of two)
+#define SEGMENT_POOL_CHUNK_SEGMENTS 4096  // Segments carved from each arena chunk
+#define SEGMENT_POOL_CLASSES 27           // Size classes: MIN_BLOCK << 0 .. MIN_BLOCK << 26
+
+typedef struct SegmentChunk SegmentChunk;
+
+/**
+ * Per-game arena for snake segment storage.
+ * Blocks are power-of-two sized and carved from large chunks; released blocks
+ * go onto a free list for their size class and are reused by the next snake
+ * that grows into that size. Chunks are only returned to the system by
+ * segment_pool_destroy, so a stale block read never touches unmapped memory.
+ *
+ * The pool is shared by the game thread and the network listener thread
+ * (remote snakes are rebuilt from network messages), so alloc/release take a
+ * small spinlock. Growth is amortized O(1) so the lock is rarely contended.
+ */
+typedef struct {
+    SegmentChunk *chunks;                       // All arena chunks (bump chunk first)
+    Vec2 *free_blocks[SEGMENT_POOL_CLASSES];    // Free list head per size class
+    atomic_flag lock;                           // Guards chunks and free lists
+} SegmentPool;
+
+/**
+ * Initialize an empty pool. A zero-filled pool is also a valid empty pool.
+ */
+void segment_pool_init(SegmentPool *pool);
+
+/**
+ * Free all chunks. Every block handed out by the pool becomes invalid.
+ */
+void segment_pool_destroy(SegmentPool *pool);
+
+/**
+ * Round a segment count up to a valid block capacity (power of two >= MIN_BLOCK).
+ * Returns 0 if the count is too large for any size class.
+ */
+int segment_pool_block_capacity(int segments);
+
+/**
+ * Get a block of exactly `capacity` segments (as returned by
+ * segment_pool_block_capacity). Returns NULL on allocation failure.
+ */
+Vec2 *segment_pool_alloc(SegmentPool *pool, int capacity);
+
+/**
+ * Return a block to the pool for reuse. `capacity` must match the allocation.
+ */
+void segment_pool_release(SegmentPool *pool, Vec2 *block, int capacity);
+
+#endif
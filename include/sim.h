@@ -0,0 +1,63 @@
+#ifndef SIM_H
+#define SIM_H
+
+#include <stdint.h>
+#include "game.h"
+#include "config.h"
+
+/**
+ * Outcome of one simulated singleplayer game.
+ */
+typedef struct {
+    int score;                 // Final score
+    int fruits_eaten;          // Food eaten
+    int combo_best;            // Longest combo streak
+    int ticks;                 // Game ticks played (death animation excluded)
+    unsigned int duration_ms;  // Virtual play time until death
+    int won;                   // 1 if the snake filled the board
+} SimResult;
+
+/**
+ * Bot/script that picks the next direction for a running game.
+ */
+typedef Direction (*SimPolicy)(const Game *g, void *user);
+
+/**
+ * Greedy bot: head for the food, avoid walls and the body whenever a safe
+ * move exists. `user` is unused.
+ */
+Direction sim_greedy_policy(const Game *g, void *user);
+
+/**
+ * Virtual clock a simulated Game is stepped on.
+ */
+typedef struct {
+    unsigned int now;          // Virtual time of the last tick (ms)
+    int tick_ms;               // Duration of the next tick at the current speed
+} SimClock;
+
+/**
+ * Re-initialize `g` from `seed` on the singleplayer board size in `cfg` and
+ * start `clock` at 0. The Game must be zero-filled or hold a previous game.
+ */
+void sim_start(Game *g, const GameConfig *cfg, uint64_t seed, SimClock *clock);
+
+/**
+ * Play one tick of a running game in virtual time, the way the SDL game does:
+ * a combo that runs out before the tick resets the speed first, and eating
+ * sets the new speed and combo window (game_tick_ms_for_combo /
+ * game_combo_window_ms). Set the direction with game_change_direction first.
+ */
+void sim_tick(Game *g, const GameConfig *cfg, SimClock *clock);
+
+/**
+ * Play one singleplayer game to the end without a window, in virtual time.
+ * Speed and combo windows follow `cfg` exactly as the SDL game does
+ * (game_tick_ms_for_combo / game_combo_window_ms, combo expiry between ticks
+ * resets the speed). The Game is re-initialized from `seed` first, so it must
+ * be zero-filled or hold a previous game. Stops after max_ticks ticks.
+ */
+void sim_play_game(Game *g, const GameConfig *cfg, uint64_t seed, int max_ticks,
+                   SimPolicy policy, void *user, SimResult *out);
+
+#endif
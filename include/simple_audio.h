@@ -50,4 +50,10 @@ void simple_audio_cleanup(void);
 void simple_audio_pause(int sound_id);
 void simple_audio_resume(int sound_id);
 
+/**
+ * Duration of the last mixing callback in microseconds.
+ * calls receives how many callbacks have run, to tell a new sample from the last
+ */
+unsigned int simple_audio_mix_time_us(unsigned int *calls);
+
 #endif /* SIMPLE_AUDIO_H */
@@ -2,30 +2,89 @@
 #define SNAKE_H
 
 #include "common.h"
+#include "segment_pool.h"
+#include "occupancy.h"
 
-#define MAX_SNAKE_LEN 256
+#define SNAKE_MIN_CAPACITY SEGMENT_POOL_MIN_BLOCK  // Storage for a freshly spawned snake
+#define SNAKE_AGE_BASE 0x80000000u  // Head age after a spawn or clear
 
 /**
  * Snake state: position segments, length, and current direction.
- * Segments are stored from head (index 0) to tail (index length-1).
+ * Segments live in a circular buffer taken from the game's SegmentPool:
+ * the head is at segments[head] and segment i (0 = head, length-1 = tail)
+ * is at (head + i) & (capacity - 1). The buffer doubles when the snake
+ * outgrows it, so a snake can fill a board of any size.
+ * Moving, growing (amortized) and removing the head are all O(1).
+ *
+ * A snake bound to an OccupancyGrid records every segment in its owner plane.
+ * Segment i has age `age - i`, so collision queries are a single grid read.
  */
 typedef struct {
-    Vec2 segments[MAX_SNAKE_LEN];  // Position of each segment
-    int length;                     // Current number of segments
-    Direction dir;                  // Current movement direction
+    Vec2 *segments;         // Ring buffer of segment positions (pool block)
+    int capacity;           // Ring buffer size (power of two, 0 if no storage)
+    int head;               // Ring index of the head segment
+    int length;             // Current number of segments
+    Direction dir;          // Current movement direction
+    SegmentPool *pool;      // Pool that owns the segment storage
+    OccupancyGrid *grid;    // Board occupancy kept in sync (NULL = none)
+    int owner;              // Plane of `grid` this snake writes
+    unsigned int age;       // Age of the head segment
+    Vec2 prev_tail;         // Cell the tail left on the last step (the tail itself if it grew)
+    int moved;              // 1 if the last change was a step (renderers may interpolate)
 } Snake;
 
+/**
+ * Get segment i of the snake (0 = head, length-1 = tail).
+ */
+static inline Vec2 snake_segment(const Snake *s, int i)
+{
+    return s->segments[(s->head + i) & (s->capacity - 1)];
+}
+
+/**
+ * Bind a snake to the pool its segments are allocated from and, optionally,
+ * to the board occupancy grid plane `owner` (grid may be NULL).
+ * The snake starts empty with no storage. Call once before any other
+ * snake function; release with snake_storage_free.
+ */
+void snake_storage_init(Snake *s, SegmentPool *pool, OccupancyGrid *grid, int owner);
+
+/**
+ * Return the snake's segment storage to its pool (snake becomes empty).
+ * Must be called before the occupancy grid it is bound to is freed.
+ */
+void snake_storage_free(Snake *s);
+
 /**
  * Initialize snake at starting position with initial direction.
- * Snake starts with length 1 (just the head).
+ * Snake starts with length 2 (head plus one body segment behind it).
+ * Storage left over from a long previous life is returned to the pool.
  */
 void snake_init(Snake *s, Vec2 start, Direction dir);
 
+/**
+ * Remove all segments (snake is despawned / not yet placed).
+ * Storage is kept so the snake can be refilled without reallocating.
+ */
+void snake_clear(Snake *s);
+
+/**
+ * Append a segment behind the current tail.
+ * Used to rebuild a snake from a head-to-tail segment list (network sync).
+ * Returns 1 if appended, 0 if storage could not be grown.
+ */
+int snake_push_tail(Snake *s, Vec2 pos);
+
 /**
  * Get position of snake's head (first segment).
  */
 Vec2 snake_head(const Snake *s);
 
+/**
+ * Get position of snake's tail (last segment).
+ */
+Vec2 snake_tail(const Snake *s);
+
 /**
  * Change snake's direction. Prevents 180-degree turns.
  */
@@ -33,13 +92,16 @@ void snake_change_direction(Snake *s, Direction newDir);
 
 /**
  * Move snake to new head position. If grow is true, tail remains in place.
- * If grow is false, all segments shift forward and tail moves.
+ * If grow is false, the tail segment is dropped.
+ * Records the step (moved, prev_tail) so a renderer can draw the head and
+ * tail between their old and new cells; every other change clears moved.
  */
 void snake_step_to(Snake *s, Vec2 newHead, int grow);
 
 /**
  * Check if snake occupies a position (collision detection).
  * Returns 1 if any segment is at the given position.
+ * O(1) when the snake is bound to an occupancy grid.
  */
 int snake_occupies(const Snake *s, Vec2 pos);
 
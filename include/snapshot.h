@@ -0,0 +1,118 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include "game.h"
+#include "multiplayer_game.h"
+
+#define SNAPSHOT_VERSION 1   // Bump when the saved layout or meaning changes
+
+typedef enum {
+    SNAPSHOT_EMPTY,
+    SNAPSHOT_GAME,
+    SNAPSHOT_MULTIPLAYER
+} SnapshotKind;
+
+/**
+ * Full state of one Game or MultiplayerGame_s at one tick: every scalar field
+ * (RNG state, combo timers, input buffers, food, scores), each snake's cells
+ * and last step (for interpolation), and the board occupancy grid including
+ * its free-cell order, so food drawn after a restore matches the original run
+ * exactly.
+ *
+ * Slots only live inside a SnapshotRing; their arrays are allocated once when
+ * the ring is created.
+ */
+typedef struct {
+    SnapshotKind kind;
+    int version;                  // SNAPSHOT_VERSION when written
+    unsigned int frame;           // Caller's tick number for this state
+    union {
+        Game game;                // Struct copy; pointer members are not used
+        MultiplayerGame_s mp;
+    } state;
+    int lengths[MAX_PLAYERS];     // Cells saved per snake
+    Vec2 *cells;                  // Snake cells, head first, `cells` per snake
+    unsigned int *ages;           // Copy of OccupancyGrid.ages
+    unsigned short *takers;       // Copy of OccupancyGrid.takers
+    int *free_cells;              // Copy of OccupancyGrid.free_cells
+    int *free_slot;               // Copy of OccupancyGrid.free_slot
+} Snapshot;
+
+/**
+ * Ring of the last N snapshots of one game, for rollback, instant replay and
+ * trying moves ahead. Saving and restoring never allocate (restoring may
+ * reuse blocks from the game's own segment pool); a save overwrites the
+ * oldest slot. Cost is linear in the board size.
+ */
+typedef struct {
+    Snapshot *slots;
+    int capacity;                 // Number of slots
+    int count;                    // Slots written so far (up to capacity)
+    int next;                     // Slot the next save writes
+    int width;                    // Board the ring was sized for
+    int height;
+    int cells;                    // width * height
+    int owners;                   // Snake planes per snapshot
+    void *storage;                // Backing block for every slot's arrays
+} SnapshotRing;
+
+/**
+ * Allocate a ring of `slots` snapshots for a width x height board with up to
+ * `owners` snakes (1 for Game, MAX_PLAYERS for MultiplayerGame_s).
+ * Returns 1 on success, 0 on bad arguments or allocation failure.
+ */
+int snapshot_ring_init(SnapshotRing *r, int slots, int width, int height, int owners);
+
+/**
+ * Free the ring. Safe on a zero-filled ring.
+ */
+void snapshot_ring_free(SnapshotRing *r);
+
+/**
+ * Forget every saved snapshot.
+ */
+void snapshot_ring_clear(SnapshotRing *r);
+
+/**
+ * Save `g` as `frame`. Returns 1 on success, 0 if the board does not match
+ * the ring.
+ */
+int snapshot_save_game(SnapshotRing *r, const Game *g, unsigned int frame);
+
+/**
+ * Save `mg` as `frame`. Returns 1 on success, 0 if the board does not match
+ * the ring.
+ */
+int snapshot_save_multiplayer(SnapshotRing *r, const MultiplayerGame_s *mg, unsigned int frame);
+
+/**
+ * Newest snapshot saved as `frame`, or NULL if it has been overwritten.
+ */
+const Snapshot *snapshot_find(const SnapshotRing *r, unsigned int frame);
+
+/**
+ * Newest snapshot in the ring, or NULL if it is empty.
+ */
+const Snapshot *snapshot_latest(const SnapshotRing *r);
+
+/**
+ * Make `s` (a slot of this ring) the newest snapshot, dropping every later
+ * one. Call after rolling back so re-simulated ticks reuse the dropped slots
+ * instead of evicting older history.
+ */
+void snapshot_ring_truncate(SnapshotRing *r, const Snapshot *s);
+
+/**
+ * Put `g` back in the saved state. `g` must be a live game on the same board
+ * size. Returns 1 on success, 0 on a kind, version or size mismatch.
+ */
+int snapshot_restore_game(const SnapshotRing *r, const Snapshot *s, Game *g);
+
+/**
+ * Put `mg` back in the saved state. `mg` must be a live game on the same
+ * board size. Returns 1 on success, 0 on a kind, version or size mismatch.
+ */
+int snapshot_restore_multiplayer(const SnapshotRing *r, const Snapshot *s, MultiplayerGame_s *mg);
+
+#endif
@@ -68,12 +68,20 @@ extern "C"
     // Draw particles on top (uses additive blending internally)
     void speedfx_render_particles(SDL_Renderer *ren, const SpeedFX *f);
 
+    // Same, for the software renderer: points batched by alpha level, a
+    // handful of draw calls instead of one per particle
+    void speedfx_render_particles_batched(SDL_Renderer *ren, const SpeedFX *f);
+
     void speedfx_combo_punch(SpeedFX *f, float tier, float ttl_sec);
 
     void speedfx_combo_ring(SpeedFX *f, float x, float y, int tier, float amp);
     void speedfx_update_rings(SpeedFX *f, float dt);
     void speedfx_render_rings(SDL_Renderer *ren, const SpeedFX *f, Uint8 r, Uint8 g, Uint8 b);
 
+    // Same, for the software renderer: each ring is filled as horizontal
+    // spans in one draw call instead of hundreds of line segments
+    void speedfx_render_rings_spans(SDL_Renderer *ren, const SpeedFX *f, Uint8 r, Uint8 g, Uint8 b);
+
 #ifdef __cplusplus
 }
 #endif
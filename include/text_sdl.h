@@ -3,9 +3,68 @@
 
 #include <SDL2/SDL.h>
 #include <SDL2/SDL_ttf.h>
+#include <stdint.h>
 
+#define TEXT_ATLAS_SIZE 512         // Glyph atlas texture width and height in pixels
+#define TEXT_ATLAS_GLYPHS 256       // Code points kept in the atlas (Latin-1)
+#define TEXT_CACHE_LINES 32         // Laid-out strings kept, least recently used replaced
+#define TEXT_LINE_MAX_GLYPHS 64     // Longest string that is laid out and cached
+#define TEXT_LINE_MAX_BYTES 128     // ... in UTF-8 bytes
+
+/**
+ * Where a glyph sits in the atlas. `state` is 0 until the glyph is first
+ * needed, then 1 once rasterized, or -1 if it could not be (no room, or the
+ * font lacks it).
+ */
+typedef struct {
+    SDL_Rect src;
+    int advance;
+    int state;
+} TextGlyph;
+
+typedef struct {
+    SDL_Rect src;               // In the atlas
+    SDL_Rect dst;               // Relative to the string's top left corner
+} TextQuad;
+
+/**
+ * A string laid out as atlas quads.
+ */
+typedef struct {
+    char text[TEXT_LINE_MAX_BYTES];
+    uint32_t hash;              // Of text; 0 marks an empty slot
+    unsigned int last_used;     // Use stamp for LRU replacement
+    int w, h;                   // Size of the whole string
+    int count;
+    TextQuad quads[TEXT_LINE_MAX_GLYPHS];
+} TextLine;
+
+/**
+ * White text in one font and size.
+ *
+ * Each glyph is rasterized once into a shared atlas texture, and strings
+ * are drawn as batches of textured quads from it, one draw call per string,
+ * with the font's pair kerning applied as the whole-string path does.
+ * Recently drawn strings keep their layout in a small LRU cache, so a
+ * menu or HUD label costs a hash lookup and a draw call per frame. Strings
+ * with glyphs outside the atlas, or longer than TEXT_LINE_MAX_GLYPHS, are
+ * rendered whole each call as before.
+ */
 typedef struct {
     TTF_Font *font;
+    int height;                 // Line height of the font
+
+    SDL_Renderer *atlas_ren;    // Renderer the atlas belongs to
+    SDL_Texture *atlas;
+    int pen_x, pen_y;           // Next free spot on the current atlas row
+    TextGlyph glyphs[TEXT_ATLAS_GLYPHS];
+
+    TextLine lines[TEXT_CACHE_LINES];
+    TextLine scratch;           // Layout in progress, copied into a slot once it succeeds
+    unsigned int clock;         // Use stamp source
+
+    int copy_glyphs;            // One SDL_RenderCopy per glyph instead of a geometry
+                                // batch (blits beat triangles on the software renderer)
 } TextRenderer;
 
 int  text_init(TextRenderer *tr, const char *font_path, int pt_size);
@@ -0,0 +1,73 @@
+#ifndef TICK_SCHEDULER_H
+#define TICK_SCHEDULER_H
+
+#include <stdint.h>
+
+#define TICK_SCHEDULER_MAX_CATCH_UP 4  // Ticks run in one frame before late time is dropped
+
+/**
+ * Fixed-timestep tick clock on a high-resolution counter
+ * (SDL_GetPerformanceCounter in the game).
+ *
+ * Each tick is due exactly one period after the previous tick's deadline,
+ * not after the frame that happened to run it, so late frames never add
+ * drift: the ticks they missed run on the next frame (up to max_catch_up)
+ * and the cadence stays on its grid. Changing the period moves only the
+ * next deadline. Ticks are numbered from 0 at start.
+ */
+typedef struct {
+    uint64_t freq;          // Counter units per second
+    uint64_t period;        // Counter units per tick
+    uint64_t last;          // Deadline of the last tick run
+    uint64_t tick;          // Ticks run since start
+    uint64_t dropped;       // Ticks skipped because the game fell too far behind
+    int max_catch_up;       // Most ticks run for one frame
+    int paused;             // 1 between tick_scheduler_pause and _resume
+    uint64_t paused_elapsed; // Time into the current tick when paused
+} TickScheduler;
+
+/**
+ * Set up a scheduler for a counter running at `freq` units per second.
+ */
+void tick_scheduler_init(TickScheduler *ts, uint64_t freq, int max_catch_up);
+
+/**
+ * Restart at tick 0 with the first tick due one period after `now`.
+ */
+void tick_scheduler_start(TickScheduler *ts, uint64_t now, unsigned int period_ms);
+
+/**
+ * Stop the clock at `now`. No ticks are due until tick_scheduler_resume.
+ */
+void tick_scheduler_pause(TickScheduler *ts, uint64_t now);
+
+/**
+ * Restart the clock at `now`, part way into the tick it was paused in, so
+ * the game and its interpolated drawing carry on exactly where they stopped.
+ */
+void tick_scheduler_resume(TickScheduler *ts, uint64_t now);
+
+/**
+ * Change the tick length. The next tick is due one new period after the
+ * last one (it may already be due).
+ */
+void tick_scheduler_set_period_ms(TickScheduler *ts, unsigned int period_ms);
+
+/**
+ * Returns 1 and consumes one tick if a tick is due at `now`, else 0.
+ * Call in a loop each frame and run one simulation tick per 1.
+ */
+int tick_scheduler_due(TickScheduler *ts, uint64_t now);
+
+/**
+ * How far `now` is between the last tick and the next one, in [0, 1].
+ * Renderers blend the previous and current tick state by this amount.
+ */
+float tick_scheduler_alpha(const TickScheduler *ts, uint64_t now);
+
+/**
+ * Convert a length in ms to counter units.
+ */
+uint64_t tick_scheduler_from_ms(const TickScheduler *ts, unsigned int ms);
+
+#endif
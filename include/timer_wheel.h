@@ -0,0 +1,81 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include <stdint.h>
+
+#define TIMER_WHEEL_BITS 6
+#define TIMER_WHEEL_SLOTS (1 << TIMER_WHEEL_BITS)   // Slots per level
+#define TIMER_WHEEL_LEVELS 4        // Slots of 1 ms, 64 ms, 4.1 s and 4.4 min
+#define TIMER_WHEEL_CAPACITY 16     // Timers pending at once per wheel
+#define TIMER_NONE (-1)             // Handle of no timer
+
+/**
+ * Hierarchical timer wheel on a millisecond clock (SDL_GetTicks, or a
+ * simulation's virtual time).
+ *
+ * Level 0 has one slot per millisecond for the next 64 ms; each level above
+ * covers 64 times the span of the one below. A timer is filed by how far
+ * away it is and moves down a level each time the clock reaches its slot, so
+ * scheduling, cancelling and firing are O(1), and advancing the clock skips
+ * empty slots via per-level bitmaps: a frame costs O(timers that fire).
+ *
+ * Timers live in a fixed array linked by index, so a wheel embedded in a
+ * Game is copied along with it (snapshots, the render thread's frames).
+ * Timers carry a caller-defined kind and data instead of a function, and
+ * timer_wheel_advance hands every expired one to the caller's callback.
+ */
+typedef struct {
+    unsigned int due;       // Expiry time
+    int kind;               // What the timer is for (owner's enum)
+    int data;               // Owner's payload (player index, ...)
+    int16_t next;           // Next timer in the same slot (or the free list), -1 ends
+    int16_t prev;           // Previous timer in the same slot, -1 at the head
+    int16_t slot;           // Slot it is filed in (level * SLOTS + index), -1 when free
+    uint16_t generation;    // Bumped on release so stale handles miss
+} Timer;
+
+typedef struct {
+    Timer timers[TIMER_WHEEL_CAPACITY];
+    int16_t heads[TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS]; // First timer per slot, -1 empty
+    uint64_t occupied[TIMER_WHEEL_LEVELS];                 // Bit per non-empty slot
+    int16_t free_head;      // First unused timer
+    int active;             // Timers pending
+    unsigned int next;      // First millisecond not yet processed
+} TimerWheel;
+
+/**
+ * Called for every timer that expires, in expiry order. May schedule or
+ * cancel timers on the same wheel.
+ */
+typedef void (*TimerFireFn)(void *user, int kind, int data, unsigned int due);
+
+/**
+ * Empty wheel whose clock stands at `now`.
+ */
+void timer_wheel_init(TimerWheel *w, unsigned int now);
+
+/**
+ * Fire once the clock reaches `due` (a `due` the clock already reached fires
+ * on the next advance to a later time). Returns a handle, or TIMER_NONE if
+ * the wheel is full.
+ */
+int timer_wheel_schedule(TimerWheel *w, unsigned int due, int kind, int data);
+
+/**
+ * Drop a pending timer. Returns 1 if it was pending; handles of timers that
+ * already fired or were cancelled (and TIMER_NONE) are ignored.
+ */
+int timer_wheel_cancel(TimerWheel *w, int handle);
+
+/**
+ * 1 if `handle` is still pending.
+ */
+int timer_wheel_pending(const TimerWheel *w, int handle);
+
+/**
+ * Move the clock to `now`, firing every timer due at or before it.
+ * With nothing pending the clock simply jumps.
+ */
+void timer_wheel_advance(TimerWheel *w, unsigned int now, TimerFireFn fire, void *user);
+
+#endif
@@ -0,0 +1,68 @@
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <stdint.h>
+
+#define TRACE_MAX_THREADS 16        // Tracks (threads) recorded at once
+#define TRACE_RING_EVENTS 65536     // Events kept per track; older ones are overwritten
+
+/**
+ * Hot-path profiler writing Chrome trace-event JSON (chrome://tracing,
+ * ui.perfetto.dev).
+ *
+ * A marker is a pair of calls around the code it measures:
+ *
+ *     uint64_t t = trace_begin();
+ *     game_update(g);
+ *     trace_end("game_update", t);
+ *
+ * Each thread records into its own ring, so markers never contend; a ring
+ * keeps the last TRACE_RING_EVENTS events. With tracing off, trace_begin
+ * returns 0 and trace_end ignores it, so markers cost one load each.
+ */
+
+/**
+ * Monotonic clock in ticks of `frequency` per second
+ * (SDL_GetPerformanceCounter / SDL_GetPerformanceFrequency).
+ */
+typedef uint64_t (*TraceClockFn)(void);
+
+/**
+ * Start recording. Event times are reported relative to this call.
+ */
+void trace_start(TraceClockFn clock, uint64_t frequency);
+
+/**
+ * Put the calling thread's events on the track `name` (a static string),
+ * created on first use. A thread that is replaced by another (a new game
+ * thread per game) can hand its track on this way, once it has stopped.
+ * Cheap when the thread is already on that track, so callbacks running on a
+ * thread they do not own may call it every time. Threads that never call it
+ * get a track of their own on their first event.
+ */
+void trace_thread_name(const char *name);
+
+/**
+ * Timestamp for trace_end, or 0 when tracing is off.
+ */
+uint64_t trace_begin(void);
+
+/**
+ * Record that `name` (a static string, used as-is in the JSON) ran from
+ * `begin` until now on the calling thread.
+ */
+void trace_end(const char *name, uint64_t begin);
+
+/**
+ * Write every recorded event to `path`. Call once traced threads have
+ * stopped or are idle. Returns 0 on success, -1 if the file could not be
+ * written.
+ */
+int trace_write_json(const char *path);
+
+/**
+ * Stop recording and free the rings. Tracing cannot be started again.
+ */
+void trace_stop(void);
+
+#endif
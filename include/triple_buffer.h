@@ -0,0 +1,53 @@
+#ifndef TRIPLE_BUFFER_H
+#define TRIPLE_BUFFER_H
+
+#include <stdatomic.h>
+
+/**
+ * Lock-free handoff of the newest state from one producer thread to one
+ * consumer thread through three caller-owned slots.
+ *
+ * The producer always has a slot of its own to fill (back), the consumer a
+ * slot of its own to read (front), and the third is shared. Publishing swaps
+ * back with the shared slot; acquiring swaps front with it when it holds
+ * something newer. Neither side ever waits for the other: a slow consumer
+ * just skips to the newest state, and a slow producer leaves the consumer
+ * reading the last one.
+ */
+typedef struct {
+    void *slots[3];
+    atomic_int shared;      // Index of the shared slot | TRIPLE_BUFFER_FRESH
+    int back;               // Producer's slot
+    int front;              // Consumer's slot
+} TripleBuffer;
+
+/**
+ * Set up a buffer over three slots. The consumer starts on `a`, which
+ * should hold a valid initial state.
+ */
+void triple_buffer_init(TripleBuffer *tb, void *a, void *b, void *c);
+
+/**
+ * Slot the producer writes next. Producer thread only.
+ */
+void *triple_buffer_back(const TripleBuffer *tb);
+
+/**
+ * Hand the filled back slot to the consumer and take another to fill.
+ * Producer thread only.
+ */
+void triple_buffer_publish(TripleBuffer *tb);
+
+/**
+ * Switch the front slot to the newest published state, if there is one.
+ * Returns 1 if the front slot changed. Consumer thread only.
+ */
+int triple_buffer_acquire(TripleBuffer *tb);
+
+/**
+ * Slot the consumer reads. Valid until the next triple_buffer_acquire.
+ * Consumer thread only.
+ */
+void *triple_buffer_front(const TripleBuffer *tb);
+
+#endif
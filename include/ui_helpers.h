@@ -4,6 +4,13 @@
 #include <SDL2/SDL.h>
 #include "text_sdl.h"
 
+/**
+ * SDL draw calls (fills, outlines, lines, texture copies) issued since the
+ * last frame was presented, for the debug performance HUD. Every drawing
+ * site bumps it; render thread only.
+ */
+extern unsigned int ui_draw_calls;
+
 /**
  * Draw a filled rectangle with specified color.
  *
@@ -9,8 +9,13 @@
 #include "game.h"
 #include "scoreboard.h"
 #include "text_sdl.h"
+#include "draw_list.h"
+#include "dirty_grid.h"
 #include "settings.h"
 #include "speedfx.h"
+#include "input_buffer.h"
+#include "latency.h"
+#include "perf_stats.h"
 
 typedef struct
 {
@@ -19,11 +24,30 @@ typedef struct
     int w, h;
     TextRenderer text;
     int text_ok;
+    DrawList draw; // Board, snake and bar quads of the frame being drawn
 
     // rendering scale
     int cell; // pixel size per cell
     int pad;  // padding around board
 
+    // Layout cache: compute_layout only recomputes when these change
+    int layout_w, layout_h;             // Window size the layout is for
+    int layout_board_w, layout_board_h; // Board size the layout is for
+    int layout_ox, layout_oy;           // Board origin in pixels
+
+    // Static board layer (background and border), drawn once per layout
+    int target_textures;         // 1 if the renderer can draw into textures
+    SDL_Texture *board_layer;    // NULL until first needed
+    int board_layer_cell;        // Cell size and board size it was drawn for
+    int board_layer_w, board_layer_h;
+    int board_layer_resets;      // target_resets when it was drawn
+    SDL_atomic_t target_resets;  // Times the renderer lost its target textures
+
+    // Incremental world rendering
+    int incremental;             // Repaint only the changed cells of world_target
+    DirtyGrid world_cells;       // What world_target shows on each board cell
+    int world_resets;            // target_resets when world_target was last drawn in full
+
     // Speedfx
     SDL_Texture *world_target; // render-to-texture for world (shake applies here)
     SDL_Texture *snake_target;
@@ -32,6 +56,20 @@ typedef struct
     int last_combo_count;
     int last_combo_tier;
     Uint32 combo_flash_until_ms; // HUD flash timer
+
+    // Frame pacing
+    int vsync;                   // 1 if SDL_RenderPresent waits for the display
+    int software;                // Renderer draws with the CPU (fill and blit fast paths)
+    int refresh_hz;              // Display refresh rate, 0 if unknown
+    SDL_atomic_t events_pending; // Set by any input or window event since the last menu frame
+    int shown_screen;            // Static screen and cursor on display (menus skip
+    int shown_state;             // drawing while these are unchanged and no events came)
+
+    // Debug overlay
+    const LatencyChannel *latency; // Input latency figures to show, NULL: none
+    PerfStats *perf;             // Frame timings to collect and graph, NULL: none
+    Uint64 frame_begin;          // Performance counter when drawing of this frame began
+    Uint64 last_present;         // ... when the last frame was presented
 } UiSdl;
 
 typedef enum
@@ -56,23 +94,42 @@ typedef enum
     UI_PAUSE_SELECT,
     UI_PAUSE_ESCAPE
 } UiPauseAction;
-void ui_sdl_render_pause_menu(UiSdl *ui, const Game *g, const char *player_name, int selected_index, int debug_mode, unsigned int current_tick_ms);
+void ui_sdl_render_pause_menu(UiSdl *ui, const Game *g, const char *player_name, int selected_index, int debug_mode, unsigned int current_tick_ms, float alpha);
 UiPauseAction ui_sdl_poll_pause(UiSdl *ui, const Settings *settings, int *out_quit);
-void ui_sdl_render_pause_options(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms);
+void ui_sdl_render_pause_options(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms, float alpha);
 
-UiSdl *ui_sdl_create(const char *title, int window_w, int window_h);
+UiSdl *ui_sdl_create(const char *title, int window_w, int window_h, int vsync);
 void ui_sdl_destroy(UiSdl *ui);
+
+/**
+ * Keep the last world frame in world_target and repaint only the board
+ * cells that changed since (on by default with the software renderer).
+ */
+void ui_sdl_set_incremental(UiSdl *ui, int on);
+
+// Present the frame drawn so far (the next menu frame is drawn in full)
+void ui_sdl_present(UiSdl *ui);
+// Sleep until an event is queued or timeout_ms passes; the event is left queued
+void ui_sdl_wait_event(unsigned int timeout_ms);
+// Show p50/p95/p99 input latency of `ch` on gameplay screens (NULL hides it)
+void ui_sdl_set_latency_overlay(UiSdl *ui, const LatencyChannel *ch);
+// Time every frame into `perf` and graph it on gameplay screens (NULL: off)
+void ui_sdl_set_perf_overlay(UiSdl *ui, PerfStats *perf);
 void ui_sdl_render_options(UiSdl *ui);
 
 // Forward declaration of MultiplayerGame from multiplayer_game.h
 // Include multiplayer_game.h in your source file to use these functions
 typedef struct MultiplayerGame_s MultiplayerGame_s;
 
-int ui_sdl_poll(UiSdl *ui, const Settings *settings, int *out_has_dir, Direction *out_dir, int *out_pause);
+// Gameplay input: queues every direction key press (with its event time) on
+// `input`. Returns 0 if the window was closed.
+int ui_sdl_poll(UiSdl *ui, const Settings *settings, InputBuffer *input, int *out_pause);
 
 // Render
+// alpha (0..1) is how far the frame is between the last tick and the next
+// (tick_scheduler_alpha); a snake that moved is drawn that far along its step
 void ui_sdl_draw_game(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms);
-void ui_sdl_render(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms);
+void ui_sdl_render(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms, float alpha);
 
 // Name input: minimal (no text rendering), uses SDL's text input
 // Returns 1 if name was retrieved, 0 if user canceled
@@ -100,7 +157,7 @@ UiMenuAction ui_sdl_poll_sound_settings(UiSdl *ui, const Settings *settings, int
 
 // Game over screen
 #include "scoreboard.h"
-void ui_sdl_render_game_over(UiSdl *ui, int score, int fruits, int time_seconds, int combo_best, const Scoreboard *sb, int selected_index);
+void ui_sdl_render_game_over(UiSdl *ui, int score, int fruits, int time_seconds, int combo_best, int won, const Scoreboard *sb, int selected_index);
 UiMenuAction ui_sdl_poll_game_over(UiSdl *ui, const Settings *settings, int *out_quit);
 
 // Online multiplayer - include the header for OnlineMultiplayerContext
@@ -135,9 +192,12 @@ UiMenuAction ui_sdl_poll_online_lobby(UiSdl *ui, const Settings *settings, int *
 // Online countdown (3-2-1 countdown)
 void ui_sdl_render_online_countdown(UiSdl *ui, const OnlineMultiplayerContext *ctx, int countdown);
 
-// Online game (Main gameplay)
-void ui_sdl_render_online_game(UiSdl *ui, const OnlineMultiplayerContext *ctx);
-Direction ui_sdl_poll_online_game_input(UiSdl *ui, const Settings *settings, int *out_quit);
+// Online game (Main gameplay); alpha as for ui_sdl_render
+void ui_sdl_render_online_game(UiSdl *ui, const OnlineMultiplayerContext *ctx, float alpha);
+// Online gameplay input: drains the event queue like ui_sdl_poll, queueing
+// every direction key press (with its event time) on `input`.
+// Returns 0 if the window was closed.
+int ui_sdl_poll_online_game_input(UiSdl *ui, const Settings *settings, InputBuffer *input);
 
 // Online game over (Final standings)
 void ui_sdl_render_online_gameover(UiSdl *ui, const OnlineMultiplayerContext *ctx);
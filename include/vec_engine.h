@@ -0,0 +1,107 @@
+#ifndef VEC_ENGINE_H
+#define VEC_ENGINE_H
+
+#include <stdint.h>
+#include "common.h"
+#include "config.h"
+#include "rng.h"
+
+#define VEC_ENGINE_MAX_CELLS 65536   // Body cells are stored as uint16_t
+#define VEC_ACTION_NONE 0xFF         // Keep the current direction
+
+/**
+ * Many independent singleplayer games stepped in lockstep, for bots and
+ * training. State is kept as structure-of-arrays (one array per field,
+ * indexed by game) so the per-tick work runs as flat loops over all games
+ * instead of chasing pointers through one Game at a time.
+ *
+ * The rules are those of game_update: walls, self-collision (the tail is
+ * excluded unless the snake grows), growth, score, combo multiplier and a
+ * combo window measured in ticks (combo_window_ticks plus
+ * combo_window_increase_per_tier per tier, as main.c sets it). A collision
+ * ends the game at once (GAME_OVER, no death animation), and a full board
+ * ends it with won set. Food is drawn uniformly from the free cells with
+ * each game's own Rng. The draw order differs from Game, so the same seed
+ * does not give the same food sequence as game_init.
+ *
+ * All games share one board size. Snake bodies are rings of cell indices
+ * (y * width + x) and occupancy is one bit per cell per game.
+ */
+typedef struct {
+    int count;              // Number of games
+    int width;
+    int height;
+    int cells;              // width * height
+    int ring_mask;          // Body ring size - 1 (ring size is a power of two)
+    int words;              // 64-bit occupancy words per game
+    int combo_window_ticks; // Tier 1 combo window in ticks
+    int combo_window_increase_per_tier;
+
+    // Per-game state, indexed by game
+    int32_t *head_x;
+    int32_t *head_y;
+    int32_t *dir;           // Direction
+    int32_t *length;
+    int32_t *state;         // GameState: GAME_RUNNING or GAME_OVER
+    int32_t *won;           // 1 if the snake filled the board
+    int32_t *score;
+    int32_t *fruits_eaten;
+    int32_t *combo_count;
+    int32_t *combo_best;
+    int32_t *combo_expiry;  // Tick at which the combo runs out (0 = none)
+    int32_t *ticks;         // Updates played this game
+    int32_t *food;          // Food cell
+    int32_t *ate;           // 1 if food was eaten by the last step
+    int32_t *body_head;     // Ring index of the head cell
+    uint16_t *body;         // count rings of (ring_mask + 1) cells
+    uint64_t *occupancy;    // count planes of `words` bits, bit set = snake
+    Rng *rng;
+
+    // Per-step scratch
+    int32_t *next_cell;
+    int32_t *grow;
+    int32_t *hit;
+} VecEngine;
+
+/**
+ * Allocate `count` games on a width x height board with the combo settings
+ * from cfg. Games start GAME_OVER; reset them before stepping.
+ * Returns 1 on success, 0 on bad size or allocation failure.
+ */
+int vec_engine_init(VecEngine *e, int count, int width, int height, const GameConfig *cfg);
+
+/**
+ * Free all engine storage. Safe on a zero-filled engine.
+ */
+void vec_engine_free(VecEngine *e);
+
+/**
+ * Start game i over from `seed`: snake of length 2 at the center heading
+ * right, food on a random free cell.
+ */
+void vec_engine_reset(VecEngine *e, int i, uint64_t seed);
+
+/**
+ * Reset every game; game i is seeded with seed + i.
+ */
+void vec_engine_reset_all(VecEngine *e, uint64_t seed);
+
+/**
+ * Advance every running game by one tick. actions[i] is the Direction for
+ * game i (180-degree turns are ignored, like snake_change_direction) or
+ * VEC_ACTION_NONE. Games that are over are left untouched.
+ */
+void vec_engine_step(VecEngine *e, const uint8_t *actions);
+
+/**
+ * Get cell (x, y) of game i's segment k (0 = head).
+ */
+static inline Vec2 vec_engine_segment(const VecEngine *e, int i, int k)
+{
+    int ring = e->ring_mask + 1;
+    int cell = e->body[i * ring + ((e->body_head[i] + k) & e->ring_mask)];
+    Vec2 pos = {cell % e->width, cell / e->width};
+    return pos;
+}
+
+#endif
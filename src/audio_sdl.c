@@ -215,6 +215,17 @@ int audio_sdl_get_effects_volume(const AudioSdl *audio)
     return audio->effects_volume;
 }
 
+unsigned int audio_sdl_mix_time_us(const AudioSdl *audio, unsigned int *calls)
+{
+    if (!audio)
+    {
+        *calls = 0;
+        return 0;
+    }
+
+    return simple_audio_mix_time_us(calls);
+}
+
 int audio_sdl_load_sound(AudioSdl *audio, const char *sound_path, const char *sound_name)
 {
     if (!audio || !audio->initialized || !sound_path || !sound_name)
@@ -1,26 +1,34 @@
 #include "board.h"
-#include <stdlib.h>
 
-void board_init(Board *b, int width, int height) {
+void board_init(Board *b, int width, int height, int owners) {
     b->width = width;
     b->height = height;
     b->food.x = width / 2;
     b->food.y = height / 2;
+    occupancy_init(&b->occupancy, width, height, owners);
+}
+
+void board_free(Board *b) {
+    occupancy_free(&b->occupancy);
 }
 
 int board_out_of_bounds(const Board *b, Vec2 pos) {
     return pos.x < 0 || pos.x >= b->width || pos.y < 0 || pos.y >= b->height;
 }
 
-void board_place_food(Board *b, const Snake *s) {
-    while (1) {
-        Vec2 pos;
-        pos.x = rand() % b->width;
-        pos.y = rand() % b->height;
+int board_random_free_cell(const Board *b, Rng *rng, Vec2 *out) {
+    if (b->occupancy.free_count <= 0) {
+        return 0;
+    }
+    return occupancy_free_cell(&b->occupancy, rng_below(rng, b->occupancy.free_count), out);
+}
 
-        if (!snake_occupies(s, pos)) {
-            b->food = pos;
-            break;
-        }
+int board_place_food(Board *b, Rng *rng) {
+    if (!b->occupancy.ages) {
+        // No occupancy storage (allocation failed): place blindly
+        b->food.x = rng_below(rng, b->width);
+        b->food.y = rng_below(rng, b->height);
+        return 1;
     }
+    return board_random_free_cell(b, rng, &b->food);
 }
@@ -1,5 +1,6 @@
 #include "config.h"
 #include "constants.h"
+#include "input_buffer.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -26,6 +27,9 @@ void config_init_defaults(GameConfig *cfg)
     cfg->combo_window_ticks = BASE_COMBO_WINDOW_TICKS;
     cfg->combo_window_increase_per_tier = COMBO_WINDOW_INCREASE_PER_TIER;
 
+    // Input
+    cfg->input_queue_depth = INPUT_BUFFER_DEFAULT_DEPTH;
+
     // Multiplayer settings
     cfg->initial_lives = INITIAL_LIVES;
     cfg->max_players = MAX_PLAYERS;
@@ -35,6 +39,7 @@ void config_init_defaults(GameConfig *cfg)
     cfg->window_height = WINDOW_HEIGHT;
     cfg->max_cell_size = MAX_CELL_SIZE;
     cfg->min_cell_size = MIN_CELL_SIZE;
+    cfg->vsync = VSYNC_ENABLED;
 }
 
 int config_load(GameConfig *cfg, const char *filename)
@@ -118,6 +123,8 @@ int config_load(GameConfig *cfg, const char *filename)
                 cfg->initial_lives = atoi(value);
             } else if (strcmp(key, "max_players") == 0) {
                 cfg->max_players = atoi(value);
+            } else if (strcmp(key, "input_queue_depth") == 0) {
+                cfg->input_queue_depth = atoi(value);
             }
         } else if (strcmp(section, "Display") == 0) {
             if (strcmp(key, "window_width") == 0) {
@@ -128,6 +135,8 @@ int config_load(GameConfig *cfg, const char *filename)
                 cfg->max_cell_size = atoi(value);
             } else if (strcmp(key, "min_cell_size") == 0) {
                 cfg->min_cell_size = atoi(value);
+            } else if (strcmp(key, "vsync") == 0) {
+                cfg->vsync = atoi(value);
             }
         }
     }
@@ -172,11 +181,15 @@ int config_save(const GameConfig *cfg, const char *filename)
     fprintf(f, "initial_lives=%d\n", cfg->initial_lives);
     fprintf(f, "max_players=%d\n\n", cfg->max_players);
 
+    fprintf(f, "# Direction presses queued between ticks (up to %d)\n", INPUT_BUFFER_MAX_DEPTH);
+    fprintf(f, "input_queue_depth=%d\n\n", cfg->input_queue_depth);
+
     fprintf(f, "[Display]\n");
     fprintf(f, "window_width=%d\n", cfg->window_width);
     fprintf(f, "window_height=%d\n", cfg->window_height);
     fprintf(f, "max_cell_size=%d\n", cfg->max_cell_size);
     fprintf(f, "min_cell_size=%d\n", cfg->min_cell_size);
+    fprintf(f, "vsync=%d\n", cfg->vsync);
 
     fclose(f);
     return 0;
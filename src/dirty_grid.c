@@ -0,0 +1,161 @@
+#include "dirty_grid.h"
+#include <stdlib.h>
+#include <string.h>
+
+#define DIRTY_GRID_EMPTY 0u             // Nothing drawn over the cell
+#define DIRTY_GRID_STRADDLED 0xFFFFFFFFu // A quad lies across it and its neighbour
+
+void dirty_grid_init(DirtyGrid *g) {
+    memset(g, 0, sizeof(*g));
+}
+
+void dirty_grid_free(DirtyGrid *g) {
+    free(g->keys);
+    free(g->next);
+    free(g->kept);
+    memset(g, 0, sizeof(*g));
+}
+
+void dirty_grid_invalidate(DirtyGrid *g) {
+    g->valid = 0;
+}
+
+int dirty_grid_begin(DirtyGrid *g, int origin_x, int origin_y, int cell, int width, int height) {
+    if (g->keys && g->origin_x == origin_x && g->origin_y == origin_y && g->cell == cell &&
+        g->width == width && g->height == height) {
+        return g->valid;
+    }
+
+    free(g->keys);
+    free(g->next);
+    size_t cells = (size_t)width * (size_t)height;
+    g->keys = calloc(cells, sizeof(*g->keys));
+    g->next = calloc(cells, sizeof(*g->next));
+    if (!g->keys || !g->next) {
+        free(g->keys);
+        free(g->next);
+        g->keys = NULL;
+        g->next = NULL;
+    }
+    g->origin_x = origin_x;
+    g->origin_y = origin_y;
+    g->cell = cell;
+    g->width = width;
+    g->height = height;
+    g->valid = 0;
+    return 0;
+}
+
+// Cells covered by `q`; 0 if any part of it is off the board
+static int dirty_grid_span(const DirtyGrid *g, const DrawQuad *q, int *cx0, int *cy0, int *cx1, int *cy1) {
+    int x = q->rect.x - g->origin_x;
+    int y = q->rect.y - g->origin_y;
+    if (x < 0 || y < 0) return 0;
+
+    *cx0 = x / g->cell;
+    *cy0 = y / g->cell;
+    *cx1 = (x + q->rect.w - 1) / g->cell;
+    *cy1 = (y + q->rect.h - 1) / g->cell;
+    return *cx1 < g->width && *cy1 < g->height;
+}
+
+static uint32_t dirty_grid_mix(uint32_t key, uint32_t v) {
+    // FNV-1a over the value's bytes
+    for (int i = 0; i < 4; i++) {
+        key ^= v & 0xFFu;
+        key *= 16777619u;
+        v >>= 8;
+    }
+    return key;
+}
+
+// Digest this frame's quads into g->next; 0 if one is off the board
+static int dirty_grid_digest(DirtyGrid *g, const DrawList *dl) {
+    memset(g->next, 0, (size_t)g->width * (size_t)g->height * sizeof(*g->next));
+
+    for (int i = 0; i < dl->count; i++) {
+        const DrawQuad *q = &dl->quads[i];
+        int cx0, cy0, cx1, cy1;
+        if (!dirty_grid_span(g, q, &cx0, &cy0, &cx1, &cy1)) return 0;
+
+        if (cx0 != cx1 || cy0 != cy1) {
+            for (int cy = cy0; cy <= cy1; cy++) {
+                for (int cx = cx0; cx <= cx1; cx++) {
+                    g->next[cy * g->width + cx] = DIRTY_GRID_STRADDLED;
+                }
+            }
+            continue;
+        }
+
+        uint32_t *key = &g->next[cy0 * g->width + cx0];
+        if (*key == DIRTY_GRID_STRADDLED) continue;
+
+        uint32_t k = *key ? *key : 2166136261u;
+        k = dirty_grid_mix(k, (uint32_t)(q->rect.x - g->origin_x - cx0 * g->cell) |
+                              (uint32_t)(q->rect.y - g->origin_y - cy0 * g->cell) << 16);
+        k = dirty_grid_mix(k, (uint32_t)q->rect.w | (uint32_t)q->rect.h << 16);
+        k = dirty_grid_mix(k, (uint32_t)q->color.r | (uint32_t)q->color.g << 8 |
+                              (uint32_t)q->color.b << 16 | (uint32_t)q->color.a << 24);
+        // Keep the two reserved values for empty and straddled cells
+        if (k == DIRTY_GRID_EMPTY || k == DIRTY_GRID_STRADDLED) k = 1;
+        *key = k;
+    }
+    return 1;
+}
+
+static int dirty_grid_changed(const DirtyGrid *g, int i) {
+    return g->next[i] != g->keys[i] || g->next[i] == DIRTY_GRID_STRADDLED;
+}
+
+static void dirty_grid_swap(DirtyGrid *g) {
+    uint32_t *keys = g->keys;
+    g->keys = g->next;
+    g->next = keys;
+}
+
+int dirty_grid_repaint(DirtyGrid *g, DrawList *dl, SDL_Color background) {
+    if (!g->valid || !g->keys) return 0;
+    if (!dirty_grid_digest(g, dl)) return 0;
+
+    if (g->kept_capacity < dl->count) {
+        DrawQuad *kept = realloc(g->kept, (size_t)dl->count * sizeof(*kept));
+        if (!kept) return 0;
+        g->kept = kept;
+        g->kept_capacity = dl->count;
+    }
+
+    // A quad either sits on one cell or straddles cells that all changed,
+    // so keeping the quads of changed cells never draws over a kept cell
+    int kept = 0;
+    for (int i = 0; i < dl->count; i++) {
+        int cx0, cy0, cx1, cy1;
+        dirty_grid_span(g, &dl->quads[i], &cx0, &cy0, &cx1, &cy1);
+        if (dirty_grid_changed(g, cy0 * g->width + cx0)) {
+            g->kept[kept++] = dl->quads[i];
+        }
+    }
+
+    draw_list_clear(dl);
+    for (int cy = 0; cy < g->height; cy++) {
+        for (int cx = 0; cx < g->width; cx++) {
+            if (dirty_grid_changed(g, cy * g->width + cx)) {
+                draw_list_rect(dl, g->origin_x + cx * g->cell, g->origin_y + cy * g->cell,
+                               g->cell, g->cell, background);
+            }
+        }
+    }
+    for (int i = 0; i < kept; i++) {
+        const DrawQuad *q = &g->kept[i];
+        draw_list_rect(dl, q->rect.x, q->rect.y, q->rect.w, q->rect.h, q->color);
+    }
+
+    dirty_grid_swap(g);
+    return 1;
+}
+
+void dirty_grid_record(DirtyGrid *g, const DrawList *dl) {
+    g->valid = 0;
+    if (!g->keys || !dirty_grid_digest(g, dl)) return;
+    dirty_grid_swap(g);
+    g->valid = 1;
+}
@@ -0,0 +1,152 @@
+#include "draw_list.h"
+#include "ui_helpers.h"
+#include <stdlib.h>
+#include <string.h>
+
+void draw_list_init(DrawList *dl, SDL_Renderer *ren) {
+    memset(dl, 0, sizeof(*dl));
+    dl->ren = ren;
+}
+
+void draw_list_free(DrawList *dl) {
+    free(dl->quads);
+    free(dl->verts);
+    free(dl->indices);
+    memset(dl, 0, sizeof(*dl));
+}
+
+static int draw_list_grow(DrawList *dl) {
+    int capacity = dl->capacity ? dl->capacity * 2 : DRAW_LIST_INITIAL_QUADS;
+    DrawQuad *quads = realloc(dl->quads, (size_t)capacity * sizeof(*quads));
+    if (!quads) return 0;
+    dl->quads = quads;
+    dl->capacity = capacity;
+    return 1;
+}
+
+void draw_list_rect(DrawList *dl, int x, int y, int w, int h, SDL_Color c) {
+    if (w <= 0 || h <= 0) return;
+
+    if (dl->count == dl->capacity && !draw_list_grow(dl)) {
+        // Out of memory: submit what is queued so this quad still lands on top
+        draw_list_flush(dl);
+        if (dl->capacity == 0) {
+            SDL_Rect rect = {x, y, w, h};
+            SDL_SetRenderDrawColor(dl->ren, c.r, c.g, c.b, c.a);
+            SDL_RenderFillRect(dl->ren, &rect);
+            ui_draw_calls++;
+            return;
+        }
+    }
+
+    DrawQuad *q = &dl->quads[dl->count++];
+    q->rect.x = x;
+    q->rect.y = y;
+    q->rect.w = w;
+    q->rect.h = h;
+    q->color = c;
+}
+
+void draw_list_rect_outlined(DrawList *dl, int x, int y, int w, int h, SDL_Color c) {
+    const SDL_Color black = {0, 0, 0, 255};
+    draw_list_rect(dl, x, y, w, h, black);
+    draw_list_rect(dl, x + 1, y + 1, w - 2, h - 2, c);
+}
+
+void draw_list_outline(DrawList *dl, int x, int y, int w, int h, SDL_Color c) {
+    draw_list_rect(dl, x, y, w, 1, c);
+    if (h > 1) draw_list_rect(dl, x, y + h - 1, w, 1, c);
+    draw_list_rect(dl, x, y + 1, 1, h - 2, c);
+    if (w > 1) draw_list_rect(dl, x + w - 1, y + 1, 1, h - 2, c);
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+static int draw_list_scratch(DrawList *dl) {
+    if (dl->scratch_capacity >= dl->count) return 1;
+
+    int capacity = dl->capacity;
+    SDL_Vertex *verts = realloc(dl->verts, (size_t)capacity * 4 * sizeof(*verts));
+    if (!verts) return 0;
+    dl->verts = verts;
+    int *indices = realloc(dl->indices, (size_t)capacity * 6 * sizeof(*indices));
+    if (!indices) return 0;
+    dl->indices = indices;
+    dl->scratch_capacity = capacity;
+    return 1;
+}
+#endif
+
+// One SDL_RenderFillRects call per run of same-colored quads
+static void draw_list_fill_runs(DrawList *dl) {
+    SDL_Rect run[64];
+    int n = 0;
+
+    // Opaque quads look the same unblended, and unblended fills are plain
+    // memory fills on the software renderer
+    SDL_BlendMode mode = SDL_BLENDMODE_NONE;
+    SDL_GetRenderDrawBlendMode(dl->ren, &mode);
+    SDL_BlendMode current = mode;
+
+    for (int i = 0; i < dl->count; i++) {
+        const DrawQuad *q = &dl->quads[i];
+        run[n++] = q->rect;
+
+        const SDL_Color *next = i + 1 < dl->count ? &dl->quads[i + 1].color : NULL;
+        if (n == (int)(sizeof(run) / sizeof(run[0])) || !next ||
+            next->r != q->color.r || next->g != q->color.g ||
+            next->b != q->color.b || next->a != q->color.a) {
+            SDL_BlendMode want = mode == SDL_BLENDMODE_BLEND && q->color.a == 255 ? SDL_BLENDMODE_NONE : mode;
+            if (want != current) {
+                SDL_SetRenderDrawBlendMode(dl->ren, want);
+                current = want;
+            }
+            SDL_SetRenderDrawColor(dl->ren, q->color.r, q->color.g, q->color.b, q->color.a);
+            SDL_RenderFillRects(dl->ren, run, n);
+            ui_draw_calls++;
+            n = 0;
+        }
+    }
+
+    if (current != mode) SDL_SetRenderDrawBlendMode(dl->ren, mode);
+}
+
+void draw_list_flush(DrawList *dl) {
+    if (dl->count == 0) return;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (!dl->fill_rects && draw_list_scratch(dl)) {
+        const SDL_FPoint uv = {0.0f, 0.0f};
+        for (int i = 0; i < dl->count; i++) {
+            const DrawQuad *q = &dl->quads[i];
+            float x0 = (float)q->rect.x, y0 = (float)q->rect.y;
+            float x1 = x0 + (float)q->rect.w, y1 = y0 + (float)q->rect.h;
+
+            SDL_Vertex *v = &dl->verts[i * 4];
+            v[0] = (SDL_Vertex){{x0, y0}, q->color, uv};
+            v[1] = (SDL_Vertex){{x1, y0}, q->color, uv};
+            v[2] = (SDL_Vertex){{x1, y1}, q->color, uv};
+            v[3] = (SDL_Vertex){{x0, y1}, q->color, uv};
+
+            int *ix = &dl->indices[i * 6];
+            ix[0] = i * 4;
+            ix[1] = i * 4 + 1;
+            ix[2] = i * 4 + 2;
+            ix[3] = i * 4;
+            ix[4] = i * 4 + 2;
+            ix[5] = i * 4 + 3;
+        }
+        SDL_RenderGeometry(dl->ren, NULL, dl->verts, dl->count * 4, dl->indices, dl->count * 6);
+        ui_draw_calls++;
+        dl->count = 0;
+        return;
+    }
+#endif
+
+    // No geometry API before SDL 2.0.18 (or not wanted, or no memory for the vertices)
+    draw_list_fill_runs(dl);
+    dl->count = 0;
+}
+
+void draw_list_clear(DrawList *dl) {
+    dl->count = 0;
+}
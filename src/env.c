@@ -0,0 +1,241 @@
+#include "env.h"
+#include "constants.h"
+#include <string.h>
+
+int env_init(Env *env, EnvMode mode, int agents, const GameConfig *cfg) {
+    memset(env, 0, sizeof(*env));
+
+    if (mode == ENV_SINGLEPLAYER) {
+        if (agents != 1 || cfg->sp_board_width < 2 || cfg->sp_board_height < 1) {
+            return 0;
+        }
+        env->width = cfg->sp_board_width;
+        env->height = cfg->sp_board_height;
+    } else {
+        if (agents < 1 || agents > MAX_PLAYERS ||
+            cfg->mp_board_width < MULTIPLAYER_BOARD_WIDTH ||
+            cfg->mp_board_height < MULTIPLAYER_BOARD_HEIGHT) {
+            return 0;
+        }
+        env->width = cfg->mp_board_width;
+        env->height = cfg->mp_board_height;
+    }
+
+    env->mode = mode;
+    env->agents = agents;
+    env->obs_width = env->width + 2;
+    env->obs_height = env->height + 2;
+    env->cfg = *cfg;
+    env->done = 1;
+    return 1;
+}
+
+void env_free(Env *env) {
+    game_free(&env->game);
+    multiplayer_game_free(&env->mp);
+}
+
+static void env_reset_multiplayer(Env *env, uint64_t seed) {
+    MultiplayerGame_s *mg = &env->mp;
+
+    multiplayer_game_free(mg);
+    memset(mg, 0, sizeof(*mg));
+    multiplayer_game_init(mg, env->width, env->height, seed);
+    mg->is_host = 1;
+    mg->local_player_index = 0;
+    mg->combo_window_ms = (unsigned int)(env->cfg.tick_ms * env->cfg.combo_window_ticks);
+
+    // Every agent is simulated here, so each one gets the local-player
+    // rules (walls, self-collision, own movement)
+    for (int a = 0; a < env->agents; a++) {
+        multiplayer_game_join_player(mg, a);
+        mg->players[a].is_local_player = 1;
+        mg->players[a].lives = 1;
+        env->mp_done[a] = 0;
+    }
+    multiplayer_game_start(mg);
+    env->mp_time = 0;
+}
+
+void env_reset(Env *env, uint64_t seed) {
+    if (env->mode == ENV_SINGLEPLAYER) {
+        sim_start(&env->game, &env->cfg, seed, &env->clock);
+    } else {
+        env_reset_multiplayer(env, seed);
+    }
+    env->done = 0;
+}
+
+static int env_step_singleplayer(Env *env, const uint8_t *actions, float *rewards) {
+    Game *g = &env->game;
+    int prev_score = g->score;
+
+    if (actions && actions[0] < 4) {
+        game_change_direction(g, (Direction)actions[0]);
+    }
+    sim_tick(g, &env->cfg, &env->clock);
+
+    if (rewards) {
+        rewards[0] = (float)(g->score - prev_score);
+    }
+
+    if (g->state == GAME_RUNNING) {
+        return 0;
+    }
+    while (game_update_death_animation(g)) {
+        // Play the death animation out so the episode ends in GAME_OVER
+    }
+    return 1;
+}
+
+static int env_step_multiplayer(Env *env, const uint8_t *actions, float *rewards) {
+    MultiplayerGame_s *mg = &env->mp;
+    int prev_score[MAX_PLAYERS];
+
+    for (int a = 0; a < env->agents; a++) {
+        prev_score[a] = mg->players[a].score;
+        if (actions && actions[a] < 4) {
+            multiplayer_game_change_direction(mg, a, (Direction)actions[a]);
+        }
+    }
+
+    // Same order as the host tick in online_multiplayer.c: move, play out
+    // deaths, then combo timers
+    env->mp_time += (unsigned int)env->cfg.tick_ms;
+    multiplayer_game_update(mg, 1);
+    while (multiplayer_game_update_death_animations(mg)) {
+        // Dying snakes turn into food segment by segment
+    }
+    for (int a = 0; a < env->agents; a++) {
+        MultiplayerPlayer *p = &mg->players[a];
+        if (!p->alive) {
+            // A finished agent's combo stays as it was
+            timer_wheel_cancel(&mg->timers, p->combo_timer);
+        } else if (p->food_eaten_this_frame) {
+            multiplayer_game_start_combo_timer(mg, a, env->mp_time);
+        }
+    }
+    multiplayer_game_update_timers(mg, env->mp_time);
+
+    int alive = 0;
+    for (int a = 0; a < env->agents; a++) {
+        MultiplayerPlayer *p = &mg->players[a];
+        if (p->alive) {
+            alive++;
+        } else if (!env->mp_done[a]) {
+            env->mp_done[a] = 1;
+            p->lives = 0;
+        }
+
+        if (rewards) {
+            rewards[a] = (float)(p->score - prev_score[a]);
+        }
+    }
+
+    // The last snake standing has won; a lone agent plays until it dies
+    return alive <= (env->agents > 1 ? 1 : 0);
+}
+
+int env_step(Env *env, const uint8_t *actions, float *rewards, uint8_t *dones,
+             int32_t *combo_counts) {
+    if (env->done) {
+        if (rewards) {
+            memset(rewards, 0, (size_t)env->agents * sizeof(float));
+        }
+    } else if (env->mode == ENV_SINGLEPLAYER) {
+        env->done = env_step_singleplayer(env, actions, rewards);
+    } else {
+        env->done = env_step_multiplayer(env, actions, rewards);
+    }
+
+    for (int a = 0; a < env->agents; a++) {
+        if (dones) {
+            dones[a] = (uint8_t)(env->done || (env->mode == ENV_MULTIPLAYER && env->mp_done[a]));
+        }
+        if (combo_counts) {
+            combo_counts[a] = env->mode == ENV_SINGLEPLAYER ? env->game.combo_count
+                                                            : env->mp.players[a].combo_count;
+        }
+    }
+    return env->done;
+}
+
+static size_t env_plane_size(const Env *env, EnvObsFormat format) {
+    size_t cells = (size_t)env->obs_width * (size_t)env->obs_height;
+    return format == ENV_OBS_U8 ? cells : (cells + 7) / 8;
+}
+
+size_t env_obs_size(const Env *env, EnvObsFormat format) {
+    return ENV_PLANE_COUNT * env_plane_size(env, format);
+}
+
+typedef struct {
+    uint8_t *out;
+    EnvObsFormat format;
+    size_t plane_size;
+    int obs_width;
+} ObsWriter;
+
+// Set cell (x, y) of the bordered grid; value is clamped to 255 in U8 mode
+static void obs_put_cell(const ObsWriter *w, EnvPlane plane, int x, int y, int value) {
+    size_t cell = (size_t)y * (size_t)w->obs_width + (size_t)x;
+    uint8_t *p = w->out + (size_t)plane * w->plane_size;
+
+    if (w->format == ENV_OBS_U8) {
+        p[cell] = (uint8_t)(value > 255 ? 255 : value);
+    } else {
+        p[cell >> 3] |= (uint8_t)(1u << (cell & 7));
+    }
+}
+
+// Set board position pos (shifted past the wall border)
+static void obs_put(const ObsWriter *w, EnvPlane plane, Vec2 pos, int value) {
+    obs_put_cell(w, plane, pos.x + 1, pos.y + 1, value);
+}
+
+static void obs_put_snake(const ObsWriter *w, const Snake *s) {
+    for (int k = 0; k < s->length; k++) {
+        obs_put(w, ENV_PLANE_BODY_AGE, snake_segment(s, k), s->length - k);
+    }
+}
+
+void env_observe(const Env *env, int agent, EnvObsFormat format, uint8_t *out) {
+    ObsWriter w = {out, format, env_plane_size(env, format), env->obs_width};
+    memset(out, 0, env_obs_size(env, format));
+
+    for (int x = 0; x < env->obs_width; x++) {
+        obs_put_cell(&w, ENV_PLANE_WALL, x, 0, 255);
+        obs_put_cell(&w, ENV_PLANE_WALL, x, env->obs_height - 1, 255);
+    }
+    for (int y = 1; y < env->obs_height - 1; y++) {
+        obs_put_cell(&w, ENV_PLANE_WALL, 0, y, 255);
+        obs_put_cell(&w, ENV_PLANE_WALL, env->obs_width - 1, y, 255);
+    }
+
+    if (env->mode == ENV_SINGLEPLAYER) {
+        const Game *g = &env->game;
+        obs_put_snake(&w, &g->snake);
+        if (g->snake.length > 0) {
+            obs_put(&w, ENV_PLANE_HEAD, snake_head(&g->snake), 255);
+        }
+        if (g->state == GAME_RUNNING) {
+            obs_put(&w, ENV_PLANE_FOOD, g->board.food, 255);
+        }
+        return;
+    }
+
+    const MultiplayerGame_s *mg = &env->mp;
+    for (int a = 0; a < env->agents; a++) {
+        const MultiplayerPlayer *p = &mg->players[a];
+        if (!p->alive) continue;
+
+        obs_put_snake(&w, &p->snake);
+        if (a == agent) {
+            obs_put(&w, ENV_PLANE_HEAD, snake_head(&p->snake), 255);
+        }
+    }
+    obs_put(&w, ENV_PLANE_FOOD, mg->board.food, 255);
+    for (int f = 0; f < mg->food_count; f++) {
+        obs_put(&w, ENV_PLANE_FOOD, mg->food[f], 255);
+    }
+}
@@ -0,0 +1,39 @@
+#include "frame_pacer.h"
+
+#define FRAME_PACER_DEFAULT_HZ 60
+
+void frame_pacer_init(FramePacer *fp, uint64_t freq, int refresh_hz, int vsync) {
+    fp->freq = freq > 0 ? freq : 1000;
+    if (refresh_hz <= 0) {
+        refresh_hz = FRAME_PACER_DEFAULT_HZ;
+    }
+    fp->period = vsync ? 0 : fp->freq / (uint64_t)refresh_hz;
+    fp->next = 0;
+}
+
+void frame_pacer_presented(FramePacer *fp, uint64_t now) {
+    // Schedule from the previous deadline to hold the rate, but never let a
+    // slow frame bank time for a burst of back-to-back frames
+    uint64_t next = fp->next + fp->period;
+    fp->next = (int64_t)(next - now) > 0 ? next : now + fp->period;
+}
+
+// Counter units from `now` until `deadline`, 0 if it has passed
+static uint64_t frame_pacer_until(uint64_t now, uint64_t deadline) {
+    int64_t left = (int64_t)(deadline - now);
+    return left > 0 ? (uint64_t)left : 0;
+}
+
+unsigned int frame_pacer_wait_ms(const FramePacer *fp, const TickScheduler *ts, uint64_t now,
+                                 unsigned int max_ms) {
+    uint64_t wait = frame_pacer_until(now, fp->next);
+    if (ts && !ts->paused) {
+        uint64_t tick = frame_pacer_until(now, ts->last + ts->period);
+        if (tick < wait) {
+            wait = tick;
+        }
+    }
+
+    uint64_t ms = (wait * 1000 + fp->freq - 1) / fp->freq;
+    return ms < max_ms ? (unsigned int)ms : max_ms;
+}
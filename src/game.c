@@ -1,6 +1,5 @@
 #include "game.h"
-
-#define POINTS_PER_FOOD 10
+#include <math.h>
 
 static void game_spawn_snake(Game *g) {
     Vec2 start;
@@ -9,10 +8,15 @@ static void game_spawn_snake(Game *g) {
     snake_init(&g->snake, start, DIR_RIGHT);
 }
 
-void game_init(Game *g, int width, int height) {
-    board_init(&g->board, width, height);
+void game_init(Game *g, int width, int height, uint64_t seed) {
+    board_init(&g->board, width, height, 1);
+    g->seed = seed;
+    rng_seed(&g->rng, seed);
+    segment_pool_init(&g->pool);
+    snake_storage_init(&g->snake, &g->pool, &g->board.occupancy, 0);
     game_spawn_snake(g);
     g->state = GAME_RUNNING;
+    g->won = 0;
     g->score = 0;
     g->fruits_eaten = 0;
     g->start_time = 0;
@@ -25,11 +29,28 @@ void game_init(Game *g, int width, int height) {
     g->combo_best = 0;
     g->food_eaten_this_frame = 0;
 
-    board_place_food(&g->board, &g->snake);
+    timer_wheel_init(&g->timers, 0);
+    g->combo_timer = TIMER_NONE;
+
+    // A board the starting snake already fills (e.g. 2x1) is won at once
+    if (!board_place_food(&g->board, &g->rng)) {
+        g->won = 1;
+        g->state = GAME_OVER;
+    }
+}
+
+void game_free(Game *g) {
+    snake_storage_free(&g->snake);
+    segment_pool_destroy(&g->pool);
+    board_free(&g->board);
 }
 
 void game_reset(Game *g) {
-    game_init(g, g->board.width, g->board.height);
+    int width = g->board.width;
+    int height = g->board.height;
+    uint64_t seed = g->seed;
+    game_free(g);
+    game_init(g, width, height, seed);
 }
 
 void game_change_direction(Game *g, Direction dir) {
@@ -80,8 +101,8 @@ void game_update(Game *g) {
     snake_step_to(&g->snake, newHead, grow);
 
     if (grow) {
-        // Handle combo
-        if (g->combo_count > 0 && g->combo_expiry_time > 0) {
+        // Handle combo (the count drops to 0 when its timer fires)
+        if (g->combo_count > 0) {
             // Combo continues
             g->combo_count++;
         } else {
@@ -94,10 +115,6 @@ void game_update(Game *g) {
             g->combo_best = g->combo_count;
         }
 
-        // Reset combo timer (will be set to actual time in main.c)
-        // For now we just mark that we need a timer update
-        g->combo_expiry_time = 1; // Placeholder, updated in main.c
-
         // Calculate score with multiplier
         int multiplier = game_get_combo_multiplier(g->combo_count);
         g->score += POINTS_PER_FOOD * multiplier;
@@ -106,7 +123,11 @@ void game_update(Game *g) {
         // Set flag for SFX
         g->food_eaten_this_frame = 1;
 
-        board_place_food(&g->board, &g->snake);
+        // No free cell left: the snake covers the whole board
+        if (!board_place_food(&g->board, &g->rng)) {
+            g->won = 1;
+            g->state = GAME_OVER;
+        }
     }
 }
 
@@ -129,14 +150,32 @@ int game_update_death_animation(Game *g) {
     return 0;
 }
 
-void game_update_combo_timer(Game *g, unsigned int current_time) {
-    if (g->combo_count > 0 && current_time >= g->combo_expiry_time) {
+static void game_on_timer(void *user, int kind, int data, unsigned int due) {
+    Game *g = (Game *)user;
+    (void)data;
+    (void)due;
+
+    if (kind == GAME_TIMER_COMBO) {
         // Combo expired
         g->combo_count = 0;
         g->combo_expiry_time = 0;
+        g->combo_timer = TIMER_NONE;
     }
 }
 
+void game_update_timers(Game *g, unsigned int now) {
+    timer_wheel_advance(&g->timers, now, game_on_timer, g);
+}
+
+void game_start_combo_timer(Game *g, unsigned int now) {
+    // Bring the clock up first so the window is measured from `now`
+    game_update_timers(g, now);
+    timer_wheel_cancel(&g->timers, g->combo_timer);
+
+    g->combo_expiry_time = now + (unsigned int)g->combo_window_ms;
+    g->combo_timer = timer_wheel_schedule(&g->timers, g->combo_expiry_time, GAME_TIMER_COMBO, 0);
+}
+
 int game_get_combo_tier(int combo_count) {
     if (combo_count <= 1) return 1;
     if (combo_count <= 3) return 2;
@@ -156,3 +195,16 @@ int game_get_combo_multiplier(int combo_count) {
     if (combo_count <= 21) return 6;
     return 7;
 }
+
+int game_tick_ms_for_combo(const GameConfig *cfg, int combo_count) {
+    float start = (float)cfg->tick_ms;
+    float floor_ms = (float)cfg->speed_floor_ms;
+    float t = floor_ms + (start - floor_ms) * expf(-cfg->speed_curve_k * (float)combo_count);
+    return (int)(t + 0.5f);
+}
+
+unsigned int game_combo_window_ms(const GameConfig *cfg, int tick_ms, int combo_count) {
+    int tier = game_get_combo_tier(combo_count);
+    int window_ticks = cfg->combo_window_ticks + (tier - 1) * cfg->combo_window_increase_per_tier;
+    return (unsigned int)(tick_ms * window_ticks);
+}
@@ -0,0 +1,265 @@
+#include "game_thread.h"
+#include "constants.h"
+#include "trace.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Copy the game into a frame, unwrapping the snake into the frame's cells
+static void game_frame_fill(GameFrame *f, const Game *g)
+{
+    memcpy(&f->game, g, sizeof(f->game));
+    memset(&f->game.pool, 0, sizeof(f->game.pool));
+    memset(&f->game.board.occupancy, 0, sizeof(f->game.board.occupancy));
+
+    Snake *s = &f->game.snake;
+    for (int i = 0; i < g->snake.length; i++)
+    {
+        f->cells[i] = snake_segment(&g->snake, i);
+    }
+    s->segments = f->cells;
+    s->capacity = f->cells_capacity;
+    s->head = 0;
+    s->pool = NULL;
+    s->grid = NULL;
+}
+
+static void game_thread_fill(GameThread *gt, GameFrame *f)
+{
+    game_frame_fill(f, gt->game);
+    f->ticks = gt->ticks;
+    f->tick_ms = gt->tick_ms;
+    f->tick_late_ms = gt->tick_late_ms;
+    f->combo_sounds = gt->combo_sounds;
+    f->combo_tier = gt->combo_tier;
+    f->explosions = gt->explosions;
+    f->inputs = gt->inputs;
+}
+
+// Make every frame able to hold a snake covering `cells` cells
+static int game_thread_reserve(GameThread *gt, int cells)
+{
+    int capacity = SNAKE_MIN_CAPACITY;
+    while (capacity < cells)
+    {
+        capacity <<= 1;
+    }
+
+    for (int i = 0; i < 3; i++)
+    {
+        GameFrame *f = &gt->frames[i];
+        if (f->cells_capacity >= capacity)
+            continue;
+
+        Vec2 *cells = realloc(f->cells, (size_t)capacity * sizeof(Vec2));
+        if (!cells)
+            return 0;
+        f->cells = cells;
+        f->cells_capacity = capacity;
+    }
+    return 1;
+}
+
+// Run every tick that is due. Same rules as the game loop always had:
+// speed follows the combo, death animation steps run on the same clock.
+static void game_thread_step(GameThread *gt)
+{
+    Game *g = gt->game;
+    const GameConfig *cfg = gt->config;
+    unsigned int now = (unsigned int)SDL_GetTicks();
+    uint64_t counter = SDL_GetPerformanceCounter();
+
+    // Presses made just before pausing are dropped, not replayed on resume
+    if (gt->paused)
+    {
+        input_buffer_clear(&gt->input);
+    }
+
+    if (g->state == GAME_RUNNING && !gt->paused)
+    {
+        int prev_combo = g->combo_count;
+        game_update_timers(g, now);
+
+        // If combo was lost, reset speed to starting speed
+        if (prev_combo > 0 && g->combo_count == 0)
+        {
+            gt->tick_ms = game_tick_ms_for_combo(cfg, 0);
+            tick_scheduler_set_period_ms(&gt->ticks, gt->tick_ms);
+        }
+    }
+
+    while (g->state == GAME_RUNNING && tick_scheduler_due(&gt->ticks, counter))
+    {
+        gt->tick_late_ms = (float)((double)(counter - gt->ticks.last) * 1000.0 / (double)gt->ticks.freq);
+        InputEvent press;
+        if (input_buffer_pop(&gt->input, g->snake.dir, &press))
+        {
+            game_change_direction(g, press.dir);
+            latency_trail_add(&gt->inputs, press.time_ms, (unsigned int)SDL_GetTicks(), gt->ticks.tick);
+        }
+        uint64_t trace_t = trace_begin();
+        game_update(g);
+        trace_end("game_update", trace_t);
+
+        if (g->food_eaten_this_frame)
+        {
+            gt->tick_ms = game_tick_ms_for_combo(cfg, g->combo_count);
+            tick_scheduler_set_period_ms(&gt->ticks, gt->tick_ms);
+
+            // Higher tiers get more time to maintain combo
+            g->combo_window_ms = game_combo_window_ms(cfg, (int)gt->tick_ms, g->combo_count);
+            game_start_combo_timer(g, now);
+
+            gt->combo_tier = game_get_combo_tier(g->combo_count);
+            gt->combo_sounds++;
+        }
+
+        if (g->state == GAME_DYING)
+        {
+            tick_scheduler_set_period_ms(&gt->ticks, DEATH_ANIMATION_TICK_MS);
+        }
+    }
+
+    // One segment per DEATH_ANIMATION_TICK_MS
+    while (g->state == GAME_DYING && tick_scheduler_due(&gt->ticks, counter))
+    {
+        game_update_death_animation(g);
+        gt->explosions++;
+    }
+}
+
+static int game_thread_main(void *data)
+{
+    GameThread *gt = (GameThread *)data;
+    trace_thread_name("game");
+
+    SDL_LockMutex(gt->lock);
+    while (!gt->stop)
+    {
+        game_thread_step(gt);
+        game_thread_fill(gt, triple_buffer_back(&gt->buffer));
+        triple_buffer_publish(&gt->buffer);
+
+        if (gt->game->state == GAME_OVER)
+            break;
+
+        // Sleep until the next tick is due or a request arrives
+        if (gt->paused)
+        {
+            SDL_CondWait(gt->wake, gt->lock);
+            continue;
+        }
+        uint64_t now = SDL_GetPerformanceCounter();
+        int64_t left = (int64_t)(gt->ticks.last + gt->ticks.period - now);
+        if (left > 0)
+        {
+            Uint32 ms = (Uint32)(((uint64_t)left * 1000 + gt->ticks.freq - 1) / gt->ticks.freq);
+            SDL_CondWaitTimeout(gt->wake, gt->lock, ms);
+        }
+    }
+    SDL_UnlockMutex(gt->lock);
+    return 0;
+}
+
+int game_thread_init(GameThread *gt)
+{
+    memset(gt, 0, sizeof(*gt));
+    gt->lock = SDL_CreateMutex();
+    gt->wake = SDL_CreateCond();
+    if (!gt->lock || !gt->wake)
+    {
+        game_thread_free(gt);
+        return 0;
+    }
+    input_buffer_init(&gt->input);
+    return 1;
+}
+
+void game_thread_free(GameThread *gt)
+{
+    game_thread_stop(gt);
+    for (int i = 0; i < 3; i++)
+    {
+        free(gt->frames[i].cells);
+    }
+    if (gt->wake)
+        SDL_DestroyCond(gt->wake);
+    if (gt->lock)
+        SDL_DestroyMutex(gt->lock);
+    memset(gt, 0, sizeof(*gt));
+}
+
+int game_thread_start(GameThread *gt, Game *g, const GameConfig *cfg, unsigned int tick_ms)
+{
+    game_thread_stop(gt);
+    if (!game_thread_reserve(gt, g->board.width * g->board.height))
+        return 0;
+
+    gt->game = g;
+    gt->config = cfg;
+    gt->tick_ms = tick_ms;
+    gt->stop = 0;
+    gt->paused = 0;
+    gt->combo_sounds = 0;
+    gt->combo_tier = 0;
+    gt->explosions = 0;
+    gt->heard_combo_sounds = 0;
+    gt->heard_explosions = 0;
+    gt->seen_inputs = 0;
+    gt->tick_late_ms = 0.0f;
+    latency_trail_clear(&gt->inputs);
+    input_buffer_init_depth(&gt->input, cfg->input_queue_depth);
+
+    tick_scheduler_init(&gt->ticks, SDL_GetPerformanceFrequency(), TICK_SCHEDULER_MAX_CATCH_UP);
+    tick_scheduler_start(&gt->ticks, SDL_GetPerformanceCounter(), tick_ms);
+
+    // The renderer starts on the initial state
+    triple_buffer_init(&gt->buffer, &gt->frames[0], &gt->frames[1], &gt->frames[2]);
+    game_thread_fill(gt, &gt->frames[0]);
+
+    gt->thread = SDL_CreateThread(game_thread_main, "game", gt);
+    return gt->thread != NULL;
+}
+
+void game_thread_stop(GameThread *gt)
+{
+    if (!gt->thread)
+        return;
+
+    SDL_LockMutex(gt->lock);
+    gt->stop = 1;
+    SDL_CondSignal(gt->wake);
+    SDL_UnlockMutex(gt->lock);
+
+    SDL_WaitThread(gt->thread, NULL);
+    gt->thread = NULL;
+}
+
+void game_thread_pause(GameThread *gt)
+{
+    SDL_LockMutex(gt->lock);
+    if (!gt->paused)
+    {
+        gt->paused = 1;
+        tick_scheduler_pause(&gt->ticks, SDL_GetPerformanceCounter());
+    }
+    SDL_CondSignal(gt->wake);
+    SDL_UnlockMutex(gt->lock);
+}
+
+void game_thread_resume(GameThread *gt)
+{
+    SDL_LockMutex(gt->lock);
+    if (gt->paused)
+    {
+        gt->paused = 0;
+        tick_scheduler_resume(&gt->ticks, SDL_GetPerformanceCounter());
+    }
+    SDL_CondSignal(gt->wake);
+    SDL_UnlockMutex(gt->lock);
+}
+
+const GameFrame *game_thread_latest(GameThread *gt)
+{
+    triple_buffer_acquire(&gt->buffer);
+    return triple_buffer_front(&gt->buffer);
+}
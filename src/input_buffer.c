@@ -8,43 +8,61 @@ static int is_opposite(Direction a, Direction b) {
 }
 
 void input_buffer_init(InputBuffer *ib) {
-    ib->count = 0;
+    input_buffer_init_depth(ib, INPUT_BUFFER_DEFAULT_DEPTH);
+}
+
+void input_buffer_init_depth(InputBuffer *ib, int depth) {
+    unsigned int size = 1;
+    while ((int)size < depth && size < INPUT_BUFFER_MAX_DEPTH) {
+        size <<= 1;
+    }
+    ib->mask = size - 1;
+    atomic_init(&ib->head, 0);
+    atomic_init(&ib->tail, 0);
 }
 
 void input_buffer_clear(InputBuffer *ib) {
-    ib->count = 0;
+    unsigned int head = atomic_load_explicit(&ib->head, memory_order_acquire);
+    atomic_store_explicit(&ib->tail, head, memory_order_release);
 }
 
-int input_buffer_push(InputBuffer *ib, Direction dir, Direction current_dir) {
-    if (ib->count >= INPUT_BUFFER_SIZE)
+int input_buffer_push(InputBuffer *ib, Direction dir, unsigned int time_ms) {
+    unsigned int head = atomic_load_explicit(&ib->head, memory_order_relaxed);
+    unsigned int tail = atomic_load_explicit(&ib->tail, memory_order_acquire);
+    if (head - tail > ib->mask)
         return 0;
 
-    Direction last =
-        (ib->count > 0) ? ib->buf[ib->count - 1] : current_dir;
+    InputEvent *slot = &ib->buf[head & ib->mask];
+    slot->dir = dir;
+    slot->time_ms = time_ms;
 
-    // Ignore same direction
-    if (dir == last)
-        return 0;
-
-    // Block 180-degree turns
-    if (is_opposite(dir, last))
-        return 0;
-
-    ib->buf[ib->count++] = dir;
+    // Release publishes the slot before the consumer can see the new head
+    atomic_store_explicit(&ib->head, head + 1, memory_order_release);
     return 1;
 }
 
-int input_buffer_pop(InputBuffer *ib, Direction *out_dir) {
-    if (ib->count <= 0)
-        return 0;
+int input_buffer_pop(InputBuffer *ib, Direction current_dir, InputEvent *out) {
+    unsigned int tail = atomic_load_explicit(&ib->tail, memory_order_relaxed);
+    unsigned int head = atomic_load_explicit(&ib->head, memory_order_acquire);
 
-    *out_dir = ib->buf[0];
+    while (tail != head) {
+        InputEvent ev = ib->buf[tail & ib->mask];
+        tail++;
 
-    // shift
-    for (int i = 1; i < ib->count; ++i) {
-        ib->buf[i - 1] = ib->buf[i];
+        // Ignore same direction and block 180-degree turns
+        if (ev.dir != current_dir && !is_opposite(ev.dir, current_dir)) {
+            atomic_store_explicit(&ib->tail, tail, memory_order_release);
+            *out = ev;
+            return 1;
+        }
     }
-    ib->count--;
 
-    return 1;
+    atomic_store_explicit(&ib->tail, tail, memory_order_release);
+    return 0;
+}
+
+int input_buffer_count(const InputBuffer *ib) {
+    unsigned int head = atomic_load_explicit(&ib->head, memory_order_acquire);
+    unsigned int tail = atomic_load_explicit(&ib->tail, memory_order_acquire);
+    return (int)(head - tail);
 }
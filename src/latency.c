@@ -0,0 +1,114 @@
+#include "latency.h"
+#include <stdio.h>
+#include <string.h>
+
+void latency_trail_clear(LatencyTrail *t) {
+    memset(t, 0, sizeof(*t));
+}
+
+void latency_trail_add(LatencyTrail *t, unsigned int input_ms, unsigned int tick_ms, uint64_t tick) {
+    LatencySample *s = &t->samples[t->count % LATENCY_TRAIL_SIZE];
+    s->input_ms = input_ms;
+    s->tick_ms = tick_ms;
+    s->tick = tick;
+    t->count++;
+}
+
+void latency_histogram_add(LatencyHistogram *h, unsigned int ms) {
+    h->buckets[ms < LATENCY_MAX_MS ? ms : LATENCY_MAX_MS]++;
+    h->count++;
+    h->total_ms += ms;
+    if (ms > h->max_ms) {
+        h->max_ms = ms;
+    }
+}
+
+unsigned int latency_histogram_percentile(const LatencyHistogram *h, int pct) {
+    if (h->count == 0) {
+        return 0;
+    }
+
+    // Rank of the sample we want, 1-based and rounded up
+    uint64_t rank = ((uint64_t)h->count * (uint64_t)pct + 99) / 100;
+    if (rank == 0) {
+        rank = 1;
+    }
+
+    uint64_t seen = 0;
+    for (unsigned int ms = 0; ms < LATENCY_MAX_MS; ms++) {
+        seen += h->buckets[ms];
+        if (seen >= rank) {
+            return ms;
+        }
+    }
+    return h->max_ms;
+}
+
+void latency_report_init(LatencyReport *r) {
+    memset(r, 0, sizeof(*r));
+}
+
+LatencyChannel *latency_report_channel(LatencyReport *r, const char *state) {
+    for (int i = 0; i < r->count; i++) {
+        if (strcmp(r->channels[i].state, state) == 0) {
+            return &r->channels[i];
+        }
+    }
+    if (r->count >= LATENCY_MAX_CHANNELS) {
+        return NULL;
+    }
+
+    LatencyChannel *ch = &r->channels[r->count++];
+    memset(ch, 0, sizeof(*ch));
+    ch->state = state;
+    return ch;
+}
+
+// Clock differences are taken unsigned, so a sample stamped a moment after
+// the frame read the clock counts as 0 instead of wrapping
+static unsigned int latency_elapsed(unsigned int from, unsigned int to) {
+    return (int)(to - from) > 0 ? to - from : 0;
+}
+
+void latency_channel_present(LatencyChannel *ch, const LatencyTrail *t, unsigned int *seen,
+                             unsigned int present_ms) {
+    unsigned int first = *seen;
+    // Entries older than the trail holds are gone
+    if (t->count - first > LATENCY_TRAIL_SIZE) {
+        first = t->count - LATENCY_TRAIL_SIZE;
+    }
+
+    for (unsigned int i = first; ch && i != t->count; i++) {
+        const LatencySample *s = &t->samples[i % LATENCY_TRAIL_SIZE];
+        latency_histogram_add(&ch->stages[LATENCY_STAGE_TICK], latency_elapsed(s->input_ms, s->tick_ms));
+        latency_histogram_add(&ch->stages[LATENCY_STAGE_PRESENT], latency_elapsed(s->input_ms, present_ms));
+    }
+    *seen = t->count;
+}
+
+int latency_report_write_csv(const LatencyReport *r, const char *path) {
+    static const char *stage_names[LATENCY_STAGE_COUNT] = {"input_to_tick", "input_to_present"};
+
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        return -1;
+    }
+
+    fprintf(f, "state,stage,samples,mean_ms,p50_ms,p95_ms,p99_ms,max_ms\n");
+    for (int i = 0; i < r->count; i++) {
+        const LatencyChannel *ch = &r->channels[i];
+        for (int s = 0; s < LATENCY_STAGE_COUNT; s++) {
+            const LatencyHistogram *h = &ch->stages[s];
+            double mean = h->count ? (double)h->total_ms / (double)h->count : 0.0;
+            fprintf(f, "%s,%s,%u,%.2f,%u,%u,%u,%u\n", ch->state, stage_names[s], h->count, mean,
+                    latency_histogram_percentile(h, 50), latency_histogram_percentile(h, 95),
+                    latency_histogram_percentile(h, 99), h->max_ms);
+        }
+    }
+
+    int ok = !ferror(f);
+    if (fclose(f) != 0) {
+        ok = 0;
+    }
+    return ok ? 0 : -1;
+}
@@ -0,0 +1,163 @@
+#include "logger.h"
+#include <stdarg.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <time.h>
+
+#define LOG_RING_MASK (LOG_RING_SIZE - 1)
+
+typedef struct {
+    atomic_uint sequence;   // == position when free to write, position + 1 once written
+    LogLevel level;
+    const char *tag;        // Static string
+    double seconds;
+    char text[LOG_LINE_MAX];
+} LogRecord;
+
+static const char *level_names[LOG_LEVEL_OFF] = {"DEBUG", "INFO", "WARN", "ERROR"};
+
+static LogRecord ring[LOG_RING_SIZE];
+static atomic_uint enqueue_pos;     // Next position a producer claims
+static unsigned int dequeue_pos;    // Next position the consumer reads (consumer-owned)
+static atomic_int async_mode;
+static atomic_int min_level = LOG_LEVEL_INFO;
+static atomic_uint dropped;
+static FILE *sink;                  // NULL: stderr
+static atomic_flag clock_started = ATOMIC_FLAG_INIT;
+static struct timespec clock_origin;
+
+static double log_seconds(void) {
+    struct timespec now;
+    timespec_get(&now, TIME_UTC);
+    if (!atomic_flag_test_and_set(&clock_started)) {
+        clock_origin = now;
+    }
+    return (double)(now.tv_sec - clock_origin.tv_sec) + (double)(now.tv_nsec - clock_origin.tv_nsec) / 1e9;
+}
+
+static void log_emit(LogLevel level, const char *tag, double seconds, const char *text) {
+    FILE *out = sink ? sink : stderr;
+    fprintf(out, "%9.3f %-5s [%s] %s\n", seconds, level_names[level], tag, text);
+}
+
+void log_set_level(LogLevel level) {
+    atomic_store(&min_level, (int)level);
+}
+
+int log_enabled(LogLevel level) {
+    return (int)level >= atomic_load_explicit(&min_level, memory_order_relaxed) && level < LOG_LEVEL_OFF;
+}
+
+int log_open(const char *path) {
+    if (!path) {
+        sink = NULL;
+        return 0;
+    }
+    FILE *f = fopen(path, "a");
+    if (!f) {
+        return -1;
+    }
+    sink = f;
+    return 0;
+}
+
+void log_set_async(int async) {
+    if (async) {
+        log_seconds(); // Start the clock before producer threads race for it
+        for (unsigned int i = 0; i < LOG_RING_SIZE; i++) {
+            atomic_store_explicit(&ring[i].sequence, i, memory_order_relaxed);
+        }
+        atomic_store_explicit(&enqueue_pos, 0, memory_order_relaxed);
+        dequeue_pos = 0;
+        atomic_store_explicit(&async_mode, 1, memory_order_release);
+        return;
+    }
+    atomic_store_explicit(&async_mode, 0, memory_order_release);
+    log_drain();
+}
+
+void log_write(LogLevel level, const char *tag, const char *fmt, ...) {
+    if ((int)level < atomic_load_explicit(&min_level, memory_order_relaxed) || level >= LOG_LEVEL_OFF) {
+        return;
+    }
+
+    va_list args;
+    double seconds = log_seconds();
+
+    if (!atomic_load_explicit(&async_mode, memory_order_acquire)) {
+        char text[LOG_LINE_MAX];
+        va_start(args, fmt);
+        vsnprintf(text, sizeof(text), fmt, args);
+        va_end(args);
+        log_emit(level, tag, seconds, text);
+        return;
+    }
+
+    // Claim a slot: bounded MPMC ring with a sequence number per slot, so
+    // producers only contend on the position counter and never wait on the
+    // consumer
+    LogRecord *r;
+    unsigned int pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+    for (;;) {
+        r = &ring[pos & LOG_RING_MASK];
+        unsigned int seq = atomic_load_explicit(&r->sequence, memory_order_acquire);
+        int diff = (int)(seq - pos);
+        if (diff == 0) {
+            if (atomic_compare_exchange_weak_explicit(&enqueue_pos, &pos, pos + 1,
+                                                      memory_order_relaxed, memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            // Full: the consumer has not freed this slot yet
+            atomic_fetch_add_explicit(&dropped, 1, memory_order_relaxed);
+            return;
+        } else {
+            pos = atomic_load_explicit(&enqueue_pos, memory_order_relaxed);
+        }
+    }
+
+    r->level = level;
+    r->tag = tag;
+    r->seconds = seconds;
+    va_start(args, fmt);
+    vsnprintf(r->text, sizeof(r->text), fmt, args);
+    va_end(args);
+    atomic_store_explicit(&r->sequence, pos + 1, memory_order_release);
+}
+
+int log_drain(void) {
+    int written = 0;
+    for (;;) {
+        LogRecord *r = &ring[dequeue_pos & LOG_RING_MASK];
+        unsigned int seq = atomic_load_explicit(&r->sequence, memory_order_acquire);
+        if (seq != dequeue_pos + 1) {
+            break;
+        }
+        log_emit(r->level, r->tag, r->seconds, r->text);
+        atomic_store_explicit(&r->sequence, dequeue_pos + LOG_RING_SIZE, memory_order_release);
+        dequeue_pos++;
+        written++;
+    }
+    if (written > 0) {
+        fflush(sink ? sink : stderr);
+    }
+    return written;
+}
+
+unsigned int log_dropped(void) {
+    return atomic_load_explicit(&dropped, memory_order_relaxed);
+}
+
+void log_close(void) {
+    log_set_async(0);
+    unsigned int lost = log_dropped();
+    if (lost > 0) {
+        char text[64];
+        snprintf(text, sizeof(text), "%u records dropped (ring full)", lost);
+        log_emit(LOG_LEVEL_WARN, "log", log_seconds(), text);
+    }
+    if (sink) {
+        fclose(sink);
+        sink = NULL;
+    }
+}
@@ -2,7 +2,6 @@
 #include <time.h>
 #include <stdio.h>
 #include <string.h>
-#include <math.h>
 #include "constants.h"
 #include "config.h"
 #include "game.h"
@@ -14,17 +13,17 @@
 #include "input_buffer.h"
 #include "settings.h"
 #include "audio_sdl.h"
+#include "tick_scheduler.h"
+#include "frame_pacer.h"
+#include "game_thread.h"
+#include "latency.h"
+#include "logger.h"
+#include "trace.h"
+#include "timer_wheel.h"
 #include <SDL2/SDL_ttf.h>
 
 
 #define UUID "c609c6cf-ad69-4957-9aa4-6e7cac06a862"
-// Calculate tick time based on combo count (smooth exponential curve)
-static int tick_ms_for_combo(int combo_count)
-{
-    float t = SPEED_FLOOR_MS + (SPEED_START_MS - SPEED_FLOOR_MS) * expf(-SPEED_CURVE_K * (float)combo_count);
-    return (int)(t + 0.5f);
-}
-
 typedef enum
 {
     APP_MENU = 0,
@@ -43,6 +42,14 @@ typedef enum
     APP_SOUND_SETTINGS
 } AppState;
 
+// Deadlines on the app's timer wheel (state changes that wait on the clock)
+typedef enum
+{
+    APP_TIMER_COUNTDOWN_END = 0, // Online countdown reached the synchronized start
+    APP_TIMER_GAMEOVER_END,      // Online final standings shown long enough
+    APP_TIMER_COUNT
+} AppTimerKind;
+
 typedef enum
 {
     MENU_SINGLEPLAYER = 0,
@@ -110,19 +117,146 @@ typedef struct
     MultiplayerGame_s *mp_game;   // Multiplayer game state
     OnlineMultiplayerContext *online_ctx; // Online multiplayer context
     mpapi *mpapi_inst;            // MPAPI instance
-    InputBuffer *input;           // Input buffer for gameplay
+    GameThread *sim;              // Runs the singleplayer game off the render thread
     char *player_name;            // Current player name
     int *paused;                  // Whether game is paused
     int *pause_selected;          // Pause menu cursor position (0-2)
     int *pause_in_options;        // Whether in pause options screen
     int *game_over_selected;      // Game over menu cursor position (0-1)
-    unsigned int *last_tick;      // Last game update tick (ms)
-    unsigned int *countdown_start; // Countdown start time (ms)
-    unsigned int *gameover_start;  // Game over screen start time (ms)
+    TickScheduler *ticks;         // Game tick clock (singleplayer and online)
+    FramePacer *frames;           // Gameplay frame deadlines (sleep between frames)
+    LatencyReport *latency;       // Input-to-photon figures per state, NULL unless --latency
+    LatencyTrail *online_inputs;  // Presses applied by online ticks
+    unsigned int *online_inputs_seen; // ... of which already on screen
+    PerfStats *perf;              // Performance HUD figures, NULL unless --debug
+    TimerWheel *timers;           // App deadlines (AppTimerKind), advanced every frame
+    int *timer_handles;           // Pending handle per AppTimerKind
     int *pending_save_this_round; // Whether score should be saved on game over
     int debug_mode;               // Debug mode flag (shows game speed)
+    int seed_fixed;               // 1 if --seed was given (every game replays it)
+    uint64_t seed;                // Seed from --seed
 } AppContext;
 
+/**
+ * Sleep after presenting a gameplay frame until the next tick of `ticks`
+ * (NULL: none pending) or the next frame is due, or input arrives.
+ */
+static void wait_for_next_frame(AppContext *ctx, const TickScheduler *ticks)
+{
+    uint64_t now = SDL_GetPerformanceCounter();
+    frame_pacer_presented(ctx->frames, now);
+    ui_sdl_wait_event(frame_pacer_wait_ms(ctx->frames, ticks, now, GAME_MAX_WAIT_MS));
+}
+
+/**
+ * Account for a frame of app state `state` just presented: every press in
+ * `trail` after `*seen` has now reached the screen. With --latency the
+ * state's figures also go into the debug overlay for the next frames.
+ */
+static void latency_presented(AppContext *ctx, const char *state, const LatencyTrail *trail, unsigned int *seen)
+{
+    LatencyChannel *ch = ctx->latency ? latency_report_channel(ctx->latency, state) : NULL;
+    latency_channel_present(ch, trail, seen, (unsigned int)SDL_GetTicks());
+    ui_sdl_set_latency_overlay(ctx->ui, ch);
+}
+
+/**
+ * Collect the performance HUD figures other subsystems keep: the audio
+ * callback's mix time and the network message rates.
+ */
+static void perf_sample(AppContext *ctx)
+{
+    if (!ctx->perf)
+        return;
+
+    unsigned int calls;
+    unsigned int mix_us = audio_sdl_mix_time_us(ctx->audio, &calls);
+    perf_stats_audio(ctx->perf, calls, mix_us);
+
+    unsigned int sent, received;
+    online_multiplayer_traffic(&sent, &received);
+    perf_stats_net(ctx->perf, (unsigned int)SDL_GetTicks(), sent, received);
+}
+
+/**
+ * Fire `kind` at `due`, replacing a pending timer of the same kind.
+ */
+static void app_timer_start(AppContext *ctx, AppTimerKind kind, unsigned int due)
+{
+    timer_wheel_cancel(ctx->timers, ctx->timer_handles[kind]);
+    ctx->timer_handles[kind] = timer_wheel_schedule(ctx->timers, due, kind, 0);
+}
+
+/**
+ * Start the online round whose synchronized start time `start` has come.
+ */
+static void start_online_round(AppContext *ctx, unsigned int start)
+{
+    unsigned int current_time = SDL_GetTicks();
+    ctx->online_ctx->state = ONLINE_STATE_PLAYING;
+    *ctx->state = APP_MULTIPLAYER_ONLINE_GAME;
+    // Anchor tick 0 at the synchronized start time, not at this frame
+    uint64_t since_start = tick_scheduler_from_ms(ctx->ticks, current_time - start);
+    tick_scheduler_start(ctx->ticks, SDL_GetPerformanceCounter() - since_start, *ctx->current_tick_ms);
+    latency_trail_clear(ctx->online_inputs);
+    *ctx->online_inputs_seen = 0;
+    LOG_INFO("app", "Game starting at synchronized timestamp %u (current: %u)", start, current_time);
+}
+
+/**
+ * App timer callback. A deadline only acts if the app is still in the state
+ * that set it (the player may have quit in between).
+ */
+static void on_app_timer(void *user, int kind, int data, unsigned int due)
+{
+    AppContext *ctx = (AppContext *)user;
+    (void)data;
+
+    ctx->timer_handles[kind] = TIMER_NONE;
+    if (kind == APP_TIMER_COUNTDOWN_END && *ctx->state == APP_MULTIPLAYER_ONLINE_COUNTDOWN)
+    {
+        start_online_round(ctx, due);
+    }
+    else if (kind == APP_TIMER_GAMEOVER_END && *ctx->state == APP_MULTIPLAYER_ONLINE_GAMEOVER)
+    {
+        // Return to online lobby
+        online_multiplayer_reset_ready_states(ctx->online_ctx);
+        ctx->online_ctx->state = ONLINE_STATE_LOBBY;
+        *ctx->state = APP_MULTIPLAYER_ONLINE_LOBBY;
+    }
+}
+
+/**
+ * Show the online final standings for GAMEOVER_DISPLAY_MS, then the lobby.
+ */
+static void enter_online_gameover(AppContext *ctx)
+{
+    app_timer_start(ctx, APP_TIMER_GAMEOVER_END, (unsigned int)SDL_GetTicks() + GAMEOVER_DISPLAY_MS);
+    *ctx->state = APP_MULTIPLAYER_ONLINE_GAMEOVER;
+}
+
+/**
+ * Count down to the synchronized start time of the online round.
+ */
+static void enter_online_countdown(AppContext *ctx)
+{
+    app_timer_start(ctx, APP_TIMER_COUNTDOWN_END, ctx->online_ctx->game_start_timestamp);
+    *ctx->state = APP_MULTIPLAYER_ONLINE_COUNTDOWN;
+}
+
+/**
+ * Start a fresh singleplayer game, seeded from --seed if given.
+ * The seed is printed so any run can be reproduced with --seed.
+ */
+static void start_singleplayer_game(AppContext *ctx)
+{
+    uint64_t seed = ctx->seed_fixed ? ctx->seed : rng_entropy_seed();
+    game_thread_stop(ctx->sim);
+    game_free(ctx->game);
+    game_init(ctx->game, ctx->config->sp_board_width, ctx->config->sp_board_height, seed);
+    LOG_INFO("app", "Game seed: %llu", (unsigned long long)seed);
+}
+
 /**
  * Handle main menu state - navigate menu and launch game modes.
  * Updates state to transition to selected mode (singleplayer, multiplayer, options, etc.)
@@ -152,14 +286,19 @@ static void handle_menu_state(AppContext *ctx)
         {
         case MENU_SINGLEPLAYER:
             *ctx->current_tick_ms = ctx->config->tick_ms;
-            game_init(ctx->game, ctx->config->sp_board_width, ctx->config->sp_board_height);
+            start_singleplayer_game(ctx);
             ctx->game->start_time = (unsigned int)SDL_GetTicks();
             ctx->game->combo_window_ms = ctx->config->tick_ms * ctx->config->combo_window_ticks; // Initialize combo window (tier 1)
             *ctx->paused = 0;
             *ctx->pending_save_this_round = 1;
-            *ctx->last_tick = (unsigned int)SDL_GetTicks();
-            input_buffer_clear(ctx->input);
-            *ctx->state = APP_SINGLEPLAYER;
+            if (game_thread_start(ctx->sim, ctx->game, ctx->config, *ctx->current_tick_ms))
+            {
+                *ctx->state = APP_SINGLEPLAYER;
+            }
+            else
+            {
+                LOG_ERROR("app", "Failed to start game thread: %s", SDL_GetError());
+            }
             break;
 
         case MENU_MULTIPLAYER:
@@ -183,7 +322,7 @@ static void handle_menu_state(AppContext *ctx)
     }
 
     ui_sdl_render_menu(ctx->ui, ctx->settings, *ctx->menu_selected);
-    SDL_Delay(MENU_FRAME_DELAY_MS);
+    ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
 }
 
 /**
@@ -231,7 +370,7 @@ static void handle_options_menu_state(AppContext *ctx)
     }
 
     ui_sdl_render_options_menu(ctx->ui, ctx->settings, *ctx->options_menu_selected);
-    SDL_Delay(MENU_FRAME_DELAY_MS);
+    ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
 }
 
 /**
@@ -284,7 +423,7 @@ static void handle_keybinds_binding_state(AppContext *ctx)
     // Render current binding prompt
     SettingAction current = (SettingAction)*ctx->keybind_current_action;
     ui_sdl_render_keybind_prompt(ctx->ui, ctx->settings, current);
-    SDL_Delay(MENU_FRAME_DELAY_MS);
+    ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
 }
 
 /**
@@ -360,7 +499,7 @@ static void handle_sound_settings_state(AppContext *ctx)
     }
 
     ui_sdl_render_sound_settings(ctx->ui, ctx->settings, ctx->audio, *ctx->sound_selected);
-    SDL_Delay(MENU_FRAME_DELAY_MS);
+    ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
 }
 
 /**
@@ -414,7 +553,7 @@ static void handle_multiplayer_online_menu_state(AppContext *ctx)
     }
 
     ui_sdl_render_multiplayer_online_menu(ctx->ui, *ctx->multiplayer_menu_selected);
-    SDL_Delay(MENU_FRAME_DELAY_MS);
+    ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
 }
 
 /**
@@ -442,7 +581,7 @@ static void handle_multiplayer_session_input_state(AppContext *ctx)
                 text_draw_center(ctx->ui->ren, &ctx->ui->text, ctx->ui->w / 2, ctx->ui->h / 2 - 40, "Failed to Join");
                 text_draw_center(ctx->ui->ren, &ctx->ui->text, ctx->ui->w / 2, ctx->ui->h / 2 + 10, ctx->online_ctx->error_message);
                 text_draw_center(ctx->ui->ren, &ctx->ui->text, ctx->ui->w / 2, ctx->ui->h / 2 + 60, "Press any key to continue");
-                SDL_RenderPresent(ctx->ui->ren);
+                ui_sdl_present(ctx->ui);
 
                 // Wait for keypress
                 SDL_Event e;
@@ -456,7 +595,7 @@ static void handle_multiplayer_session_input_state(AppContext *ctx)
                             waiting = 0;
                         }
                     }
-                    SDL_Delay(16);
+                    ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
                 }
 
                 // Reset connection lost flag
@@ -490,22 +629,20 @@ static void handle_multiplayer_online_lobby_state(AppContext *ctx)
     // Check if game started (for clients receiving start command from host)
     if (ctx->online_ctx->state == ONLINE_STATE_COUNTDOWN)
     {
-        *ctx->countdown_start = SDL_GetTicks();
-        *ctx->state = APP_MULTIPLAYER_ONLINE_COUNTDOWN;
+        enter_online_countdown(ctx);
         return;
     }
 
     if (action == UI_MENU_BACK)
     {
         // Leave lobby - send disconnect notification and cleanup
-        printf("DEBUG: Player leaving lobby, sending disconnect notification\n");
-        fflush(stdout);
+        LOG_DEBUG("app", "Player leaving lobby, sending disconnect notification");
 
         // Send a disconnect notification via game message
         if (ctx->mpapi_inst) {
             json_t *disconnect_msg = json_object();
             json_object_set_new(disconnect_msg, "command", json_string("player_disconnect"));
-            mpapi_game(ctx->mpapi_inst, disconnect_msg, NULL);
+            online_multiplayer_send(ctx->mpapi_inst, disconnect_msg);
             json_decref(disconnect_msg);
         }
 
@@ -531,6 +668,8 @@ static void handle_multiplayer_online_lobby_state(AppContext *ctx)
         {
             ctx->online_ctx->api = ctx->mpapi_inst;
             ctx->online_ctx->game = ctx->mp_game;
+            ctx->online_ctx->seed_fixed = ctx->seed_fixed;
+            ctx->online_ctx->seed = ctx->seed;
         }
 
         *ctx->state = APP_MULTIPLAYER_ONLINE_MENU;
@@ -542,31 +681,27 @@ static void handle_multiplayer_online_lobby_state(AppContext *ctx)
     }
     else if (action == UI_MENU_SELECT)
     {
-        printf("DEBUG: ENTER pressed in lobby, is_host=%d\n", ctx->online_ctx->game->is_host);
-        fflush(stdout);
+        LOG_DEBUG("app", "ENTER pressed in lobby, is_host=%d", ctx->online_ctx->game->is_host);
 
         if (ctx->online_ctx->game->is_host)
         {
             // Host pressed ENTER to start game - only allowed if all players are ready
             if (online_multiplayer_all_players_ready(ctx->online_ctx))
             {
-                printf("DEBUG: All players ready, starting game\n");
-                fflush(stdout);
+                LOG_DEBUG("app", "All players ready, starting game");
                 *ctx->current_tick_ms = TICK_MS; // Reset to default speed for multiplayer
                 online_multiplayer_start_game(ctx->online_ctx);
-                *ctx->countdown_start = SDL_GetTicks();
-                *ctx->state = APP_MULTIPLAYER_ONLINE_COUNTDOWN;
+                enter_online_countdown(ctx);
             }
             else
             {
-                printf("DEBUG: Not all players ready yet\n");
-                fflush(stdout);
+                LOG_DEBUG("app", "Not all players ready yet");
             }
         }
     }
 
     ui_sdl_render_online_lobby(ctx->ui, ctx->online_ctx);
-    SDL_Delay(MENU_FRAME_DELAY_MS);
+    ui_sdl_wait_event(MENU_FRAME_DELAY_MS);
 }
 
 /**
@@ -583,91 +718,63 @@ static void handle_multiplayer_online_countdown_state(AppContext *ctx)
 
     // Debug output (only print occasionally to avoid spam)
     static int debug_counter = 0;
-    if (debug_counter++ % 30 == 0) {
-        printf("DEBUG COUNTDOWN: is_host=%d, game_start_timestamp=%u, current_time=%u, ms_remaining=%d, countdown=%d\n",
-               ctx->online_ctx->game->is_host, ctx->online_ctx->game_start_timestamp, current_time, ms_remaining, countdown);
-        fflush(stdout);
-    }
-
-    if (ms_remaining <= 0)
-    {
-        // Start game at the synchronized timestamp
-        ctx->online_ctx->state = ONLINE_STATE_PLAYING;
-        *ctx->state = APP_MULTIPLAYER_ONLINE_GAME;
-        *ctx->last_tick = ctx->online_ctx->game_start_timestamp; // Use synchronized start time for first tick
-        printf("DEBUG: Game starting at synchronized timestamp %u (current: %u)\n",
-               ctx->online_ctx->game_start_timestamp, current_time);
-        fflush(stdout);
-        return;
+    if (debug_counter++ % 30 == 0 && LOG_ENABLED(LOG_LEVEL_DEBUG)) {
+        LOG_DEBUG("app", "Countdown: is_host=%d, game_start_timestamp=%u, current_time=%u, ms_remaining=%d, countdown=%d",
+                  ctx->online_ctx->game->is_host, ctx->online_ctx->game_start_timestamp, current_time, ms_remaining, countdown);
     }
 
+    // The round itself starts from APP_TIMER_COUNTDOWN_END
     ui_sdl_render_online_countdown(ctx->ui, ctx->online_ctx, countdown);
-    SDL_Delay(MENU_FRAME_DELAY_MS);
+    ui_sdl_wait_event(MENU_FRAME_DELAY_MS);
 }
 
 /**
  * Handle online game - Main gameplay loop.
+ * Unlike singleplayer, online ticks still run here on the render thread
+ * (see GameThread), so a stalled present can delay them.
  */
 static void handle_multiplayer_online_game_state(AppContext *ctx)
 {
-    int quit = 0;
-    Direction input_dir = ui_sdl_poll_online_game_input(ctx->ui, ctx->settings, &quit);
-    if (quit)
+    // The host queues its presses straight on its player's input buffer
+    // (same as singleplayer); a client collects this frame's presses to send
+    int local_idx = ctx->online_ctx->game->local_player_index;
+    int has_local = local_idx >= 0 && local_idx < MAX_PLAYERS;
+    InputBuffer presses;
+    input_buffer_init_depth(&presses, INPUT_BUFFER_MAX_DEPTH);
+    InputBuffer *input = &presses;
+    if (ctx->online_ctx->game->is_host && has_local)
+    {
+        input = &ctx->online_ctx->game->players[local_idx].input;
+    }
+    if (!ui_sdl_poll_online_game_input(ctx->ui, ctx->settings, input))
     {
         *ctx->state = APP_QUIT;
         return;
     }
 
-    // Validate and send input for client
-    if (input_dir != -1 && !ctx->online_ctx->game->is_host)
+    // Client: validate and send every press in order
+    if (!ctx->online_ctx->game->is_host && has_local)
     {
-        int local_idx = ctx->online_ctx->game->local_player_index;
-        if (local_idx >= 0 && local_idx < MAX_PLAYERS)
-        {
-            // Validate input locally using the same logic as singleplayer
-            Direction current_dir = ctx->online_ctx->game->players[local_idx].snake.dir;
-
-            // Check if buffer has a pending direction
-            Direction last_dir = current_dir;
-            if (ctx->online_ctx->has_pending_input) {
-                last_dir = ctx->online_ctx->pending_input;
-            }
-
-            // Validate: not same, not opposite
-            int is_opposite = (last_dir == DIR_UP && input_dir == DIR_DOWN) ||
-                             (last_dir == DIR_DOWN && input_dir == DIR_UP) ||
-                             (last_dir == DIR_LEFT && input_dir == DIR_RIGHT) ||
-                             (last_dir == DIR_RIGHT && input_dir == DIR_LEFT);
-
-            if (input_dir != last_dir && !is_opposite)
-            {
-                // Valid input - store as pending and send to host
-                ctx->online_ctx->pending_input = input_dir;
-                ctx->online_ctx->has_pending_input = 1;
-                online_multiplayer_client_send_input(ctx->online_ctx, input_dir);
-            }
+        // Each press must turn from the last direction already sent (or the
+        // snake's own): not the same, not opposite
+        Direction last_dir = ctx->online_ctx->game->players[local_idx].snake.dir;
+        if (ctx->online_ctx->has_pending_input) {
+            last_dir = ctx->online_ctx->pending_input;
         }
-    }
 
-    unsigned int current_time = SDL_GetTicks();
-
-    // Host updates game logic
-    if (ctx->online_ctx->game->is_host)
-    {
-        // Process host's own input using input buffer (same as singleplayer)
-        if (input_dir != -1)
+        InputEvent press;
+        while (input_buffer_pop(&presses, last_dir, &press))
         {
-            int local_idx = ctx->online_ctx->game->local_player_index;
-            if (local_idx >= 0 && local_idx < MAX_PLAYERS)
-            {
-                MultiplayerPlayer *local_player = &ctx->online_ctx->game->players[local_idx];
-                // Use the input buffer (same as singleplayer!)
-                input_buffer_push(&local_player->input, input_dir, local_player->snake.dir);
-            }
+            // Valid input - store as the newest pending turn and send to host
+            ctx->online_ctx->pending_input = press.dir;
+            ctx->online_ctx->has_pending_input = 1;
+            online_multiplayer_client_send_input(ctx->online_ctx, press.dir, press.time_ms);
+            last_dir = press.dir;
         }
-
     }
 
+    unsigned int current_time = SDL_GetTicks();
+
     // Both host and join client run the SAME simulation code for their own snake
     {
         // Send position updates 4x per game tick for smooth remote rendering
@@ -676,8 +783,7 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
 
         if (current_time - last_position_send >= position_send_interval)
         {
-            int local_idx = ctx->online_ctx->game->local_player_index;
-            if (local_idx >= 0 && local_idx < MAX_PLAYERS) {
+            if (has_local) {
                 MultiplayerPlayer *local_player = &ctx->online_ctx->game->players[local_idx];
                 // Send updates even when dying (include death_state)
                 if (local_player->joined) {
@@ -687,15 +793,16 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
 
                     json_t *segments = json_array();
                     for (int i = 0; i < local_player->snake.length; i++) {
-                        json_array_append_new(segments, json_integer(local_player->snake.segments[i].x));
-                        json_array_append_new(segments, json_integer(local_player->snake.segments[i].y));
+                        Vec2 seg = snake_segment(&local_player->snake, i);
+                        json_array_append_new(segments, json_integer(seg.x));
+                        json_array_append_new(segments, json_integer(seg.y));
                     }
                     json_object_set_new(pos_update, "segments", segments);
                     json_object_set_new(pos_update, "direction", json_integer(local_player->snake.dir));
                     json_object_set_new(pos_update, "death_state", json_integer(local_player->death_state));
                     json_object_set_new(pos_update, "alive", json_boolean(local_player->alive));
 
-                    mpapi_game(ctx->online_ctx->api, pos_update, NULL);
+                    online_multiplayer_send(ctx->online_ctx->api, pos_update);
                     json_decref(pos_update);
                 }
             }
@@ -703,17 +810,23 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
         }
 
         // Simulate local player's snake using SAME function for both host and client
-        if (current_time - *ctx->last_tick >= *ctx->current_tick_ms)
+        uint64_t frame_counter = SDL_GetPerformanceCounter();
+        while (tick_scheduler_due(ctx->ticks, frame_counter))
         {
-            int local_idx = ctx->online_ctx->game->local_player_index;
-            if (local_idx >= 0 && local_idx < MAX_PLAYERS) {
+            if (ctx->perf)
+            {
+                float late_ms = (float)((double)(frame_counter - ctx->ticks->last) * 1000.0 / (double)ctx->ticks->freq);
+                perf_stats_tick(ctx->perf, ctx->ticks->tick, late_ms);
+            }
+            if (has_local) {
                 MultiplayerPlayer *local_player = &ctx->online_ctx->game->players[local_idx];
                 MultiplayerGame_s *game = ctx->online_ctx->game;
 
                 // Process input for local player
-                Direction dir;
-                if (input_buffer_pop(&local_player->input, &dir)) {
-                    snake_change_direction(&local_player->snake, dir);
+                InputEvent press;
+                if (input_buffer_pop(&local_player->input, local_player->snake.dir, &press)) {
+                    snake_change_direction(&local_player->snake, press.dir);
+                    latency_trail_add(ctx->online_inputs, press.time_ms, (unsigned int)SDL_GetTicks(), ctx->ticks->tick);
                 }
 
                 // Track death state changes for notifications
@@ -724,7 +837,15 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                 int old_length = local_player->snake.length;
 
                 // Both host and client use multiplayer_game_update() for movement
+                uint64_t trace_t = trace_begin();
                 multiplayer_game_update(game, game->is_host);
+                trace_end("multiplayer_game_update", trace_t);
+
+                // Each instance runs the combo window of its own snake
+                if (local_player->food_eaten_this_frame) {
+                    multiplayer_game_start_combo_timer(game, local_idx, current_time);
+                }
+                multiplayer_game_update_timers(game, current_time);
 
                 // Join client: send food_eaten notification when snake grows
                 if (!game->is_host && local_player->snake.length > old_length) {
@@ -735,7 +856,7 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                     json_object_set_new(food_msg, "food_eaten", json_boolean(1));
                     json_object_set_new(food_msg, "food_x", json_integer(head.x));
                     json_object_set_new(food_msg, "food_y", json_integer(head.y));
-                    mpapi_game(ctx->online_ctx->api, food_msg, NULL);
+                    online_multiplayer_send(ctx->online_ctx->api, food_msg);
                     json_decref(food_msg);
                 }
 
@@ -750,7 +871,7 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                         json_t *death_msg = json_object();
                         json_object_set_new(death_msg, "player_died", json_boolean(1));
                         json_object_set_new(death_msg, "lives", json_integer(local_player->lives));
-                        mpapi_game(ctx->online_ctx->api, death_msg, NULL);
+                        online_multiplayer_send(ctx->online_ctx->api, death_msg);
                         json_decref(death_msg);
                     }
                 }
@@ -763,7 +884,7 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                     json_object_set_new(food_msg, "food_added", json_boolean(1));
                     json_object_set_new(food_msg, "food_x", json_integer(head.x));
                     json_object_set_new(food_msg, "food_y", json_integer(head.y));
-                    mpapi_game(ctx->online_ctx->api, food_msg, NULL);
+                    online_multiplayer_send(ctx->online_ctx->api, food_msg);
                     json_decref(food_msg);
                 }
 
@@ -776,14 +897,16 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                         // Find safe spawn position (client-authoritative)
                         Vec2 spawn_pos = {game->board.width / 2, game->board.height / 2};  // Default center
 
-                        // Try to find a safe position (3x3 area check)
+                        // Draw random free cells until one has a clear 3x3 area
                         int max_attempts = 100;
                         for (int attempt = 0; attempt < max_attempts; attempt++) {
                             int margin = 3;
-                            Vec2 candidate = {
-                                margin + (rand() % (game->board.width - 2 * margin)),
-                                margin + (rand() % (game->board.height - 2 * margin))
-                            };
+                            Vec2 candidate;
+                            if (!board_random_free_cell(&game->board, &game->rng, &candidate)) break;
+                            if (candidate.x < margin || candidate.x >= game->board.width - margin ||
+                                candidate.y < margin || candidate.y >= game->board.height - margin) {
+                                continue;
+                            }
 
                             int safe = 1;
                             for (int dx = -1; dx <= 1 && safe; dx++) {
@@ -791,12 +914,9 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                                     Vec2 check = {candidate.x + dx, candidate.y + dy};
 
                                     // Check all snakes
-                                    for (int i = 0; i < MAX_PLAYERS; i++) {
-                                        if (game->players[i].snake.length > 0 &&
-                                            snake_occupies(&game->players[i].snake, check)) {
-                                            safe = 0;
-                                            break;
-                                        }
+                                    if (!occupancy_is_free(&game->board.occupancy, check)) {
+                                        safe = 0;
+                                        break;
                                     }
 
                                     // Check main food
@@ -827,8 +947,7 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                         // Don't clear input buffer - preserve inputs pressed during death animation
 
                         // Reset combo
-                        local_player->combo_count = 0;
-                        local_player->combo_expiry_time = 0;
+                        multiplayer_game_clear_combo(game, local_idx);
 
                         // Join client sends respawn notification to host
                         if (!game->is_host) {
@@ -836,7 +955,7 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                             json_object_set_new(respawn_msg, "player_respawned", json_boolean(1));
                             json_object_set_new(respawn_msg, "spawn_x", json_integer(spawn_pos.x));
                             json_object_set_new(respawn_msg, "spawn_y", json_integer(spawn_pos.y));
-                            mpapi_game(ctx->online_ctx->api, respawn_msg, NULL);
+                            online_multiplayer_send(ctx->online_ctx->api, respawn_msg);
                             json_decref(respawn_msg);
                         }
                     }
@@ -846,7 +965,7 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                 // Update death state tracker
                 prev_death_state[local_idx] = local_player->death_state;
 
-                // Host broadcasts state after simulation (before updating last_tick)
+                // Host broadcasts state after simulation
                 if (game->is_host) {
                     online_multiplayer_host_broadcast_state(ctx->online_ctx);
 
@@ -856,17 +975,14 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
                         // Send game_over command to all clients
                         json_t *game_over_cmd = json_object();
                         json_object_set_new(game_over_cmd, "command", json_string("game_over"));
-                        mpapi_game(ctx->online_ctx->api, game_over_cmd, NULL);
+                        online_multiplayer_send(ctx->online_ctx->api, game_over_cmd);
                         json_decref(game_over_cmd);
 
-                        *ctx->gameover_start = (unsigned int)SDL_GetTicks();
-                        *ctx->state = APP_MULTIPLAYER_ONLINE_GAMEOVER;
+                        enter_online_gameover(ctx);
                         return;
                     }
                 }
             }
-
-            *ctx->last_tick = current_time;
         }
     }
 
@@ -915,16 +1031,17 @@ static void handle_multiplayer_online_game_state(AppContext *ctx)
     {
         if (ctx->online_ctx->state == ONLINE_STATE_GAME_OVER)
         {
-            printf("DEBUG: Client detected ONLINE_STATE_GAME_OVER, transitioning to APP_MULTIPLAYER_ONLINE_GAMEOVER\n");
-            fflush(stdout);
-            *ctx->gameover_start = (unsigned int)SDL_GetTicks();
-            *ctx->state = APP_MULTIPLAYER_ONLINE_GAMEOVER;
+            LOG_DEBUG("app", "Client detected ONLINE_STATE_GAME_OVER, transitioning to APP_MULTIPLAYER_ONLINE_GAMEOVER");
+            enter_online_gameover(ctx);
             return;
         }
     }
 
-    ui_sdl_render_online_game(ctx->ui, ctx->online_ctx);
-    SDL_Delay(GAME_FRAME_DELAY_MS);
+    uint64_t trace_t = trace_begin();
+    ui_sdl_render_online_game(ctx->ui, ctx->online_ctx, tick_scheduler_alpha(ctx->ticks, SDL_GetPerformanceCounter()));
+    trace_end("ui_sdl_render_online_game", trace_t);
+    latency_presented(ctx, "online", ctx->online_inputs, ctx->online_inputs_seen);
+    wait_for_next_frame(ctx, ctx->ticks);
 }
 
 /**
@@ -941,20 +1058,9 @@ static void handle_multiplayer_online_gameover_state(AppContext *ctx)
         return;
     }
 
-    // Check if 3 seconds have passed (3000ms)
-    unsigned int current_time = (unsigned int)SDL_GetTicks();
-    unsigned int elapsed = current_time - *ctx->gameover_start;
-
-    if (elapsed >= 3000)
-    {
-        // Return to online lobby
-        online_multiplayer_reset_ready_states(ctx->online_ctx);
-        ctx->online_ctx->state = ONLINE_STATE_LOBBY;
-        *ctx->state = APP_MULTIPLAYER_ONLINE_LOBBY;
-    }
-
+    // Back to the lobby from APP_TIMER_GAMEOVER_END
     ui_sdl_render_online_gameover(ctx->ui, ctx->online_ctx);
-    SDL_Delay(MENU_FRAME_DELAY_MS);
+    ui_sdl_wait_event(MENU_FRAME_DELAY_MS);
 }
 
 /**
@@ -967,8 +1073,8 @@ static void handle_game_over_state(AppContext *ctx)
     int time_seconds = (int)((ctx->game->death_time - ctx->game->start_time) / 1000);
 
     // Render game over screen with scoreboard
-    ui_sdl_render_game_over(ctx->ui, ctx->game->score, ctx->game->fruits_eaten, time_seconds, ctx->game->combo_best, ctx->sb, *ctx->game_over_selected);
-    SDL_Delay(MENU_FRAME_DELAY_MS);
+    ui_sdl_render_game_over(ctx->ui, ctx->game->score, ctx->game->fruits_eaten, time_seconds, ctx->game->combo_best, ctx->game->won, ctx->sb, *ctx->game_over_selected);
+    ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
 
     // Poll for input
     int quit = 0;
@@ -993,14 +1099,20 @@ static void handle_game_over_state(AppContext *ctx)
         {
             // Try again - restart game
             *ctx->current_tick_ms = ctx->config->tick_ms; // Reset to normal speed
-            game_init(ctx->game, ctx->config->sp_board_width, ctx->config->sp_board_height);
+            start_singleplayer_game(ctx);
             ctx->game->start_time = (unsigned int)SDL_GetTicks();
             ctx->game->combo_window_ms = ctx->config->tick_ms * ctx->config->combo_window_ticks; // Reset combo window (tier 1)
             *ctx->paused = 0;
             *ctx->pending_save_this_round = 1;
-            *ctx->last_tick = (unsigned int)SDL_GetTicks();
-            input_buffer_clear(ctx->input);
-            *ctx->state = APP_SINGLEPLAYER;
+            if (game_thread_start(ctx->sim, ctx->game, ctx->config, *ctx->current_tick_ms))
+            {
+                *ctx->state = APP_SINGLEPLAYER;
+            }
+            else
+            {
+                LOG_ERROR("app", "Failed to start game thread: %s", SDL_GetError());
+                *ctx->state = APP_MENU;
+            }
         }
         else
         {
@@ -1021,13 +1133,41 @@ static void handle_scoreboard_state(AppContext *ctx)
     *ctx->state = APP_MENU;
 }
 
+/**
+ * Play the sounds for everything the game thread did since the last frame.
+ */
+static void play_game_thread_sounds(AppContext *ctx, const GameFrame *frame)
+{
+    GameThread *sim = ctx->sim;
+    if (ctx->audio && frame->combo_sounds != sim->heard_combo_sounds)
+    {
+        char sfx_name[32];
+        snprintf(sfx_name, sizeof(sfx_name), "combo%d", frame->combo_tier);
+        audio_sdl_play_sound(ctx->audio, sfx_name);
+    }
+    if (ctx->audio && frame->explosions != sim->heard_explosions)
+    {
+        audio_sdl_play_sound(ctx->audio, "explosion");
+    }
+    sim->heard_combo_sounds = frame->combo_sounds;
+    sim->heard_explosions = frame->explosions;
+}
+
 /**
  * Handle singleplayer gameplay state.
- * Manages pause menu, game loop (input, tick, collision), and game over.
- * On game over, prompts for name and saves score to scoreboard.
+ * The game itself ticks on the game thread; this draws its newest frame,
+ * forwards input and runs the pause menu and the game over transition.
+ * On game over, saves the score to the scoreboard.
  */
 static void handle_singleplayer_state(AppContext *ctx)
 {
+    const GameFrame *frame = game_thread_latest(ctx->sim);
+    const Game *view = &frame->game;
+    float alpha = tick_scheduler_alpha(&frame->ticks, SDL_GetPerformanceCounter());
+    play_game_thread_sounds(ctx, frame);
+    if (ctx->perf)
+        perf_stats_tick(ctx->perf, frame->ticks.tick, frame->tick_late_ms);
+
     if (*ctx->paused)
     {
         // If we're in the pause-options screen, ESC returns to pause menu
@@ -1047,8 +1187,9 @@ static void handle_singleplayer_state(AppContext *ctx)
                 }
             }
 
-            ui_sdl_render_pause_options(ctx->ui, ctx->game, ctx->player_name, ctx->debug_mode, *ctx->current_tick_ms);
-            SDL_Delay(MENU_FRAME_DELAY_MS);
+            ui_sdl_render_pause_options(ctx->ui, view, ctx->player_name, ctx->debug_mode, frame->tick_ms, alpha);
+            latency_presented(ctx, "singleplayer", &frame->inputs, &ctx->sim->seen_inputs);
+            ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
             return;
         }
 
@@ -1071,7 +1212,7 @@ static void handle_singleplayer_state(AppContext *ctx)
         else if (pause_action == UI_PAUSE_ESCAPE)
         {
             *ctx->paused = 0;
-            *ctx->last_tick = (unsigned int)SDL_GetTicks();
+            game_thread_resume(ctx->sim);
             if (ctx->audio)
             {
                 audio_sdl_resume_music(ctx->audio);
@@ -1083,7 +1224,7 @@ static void handle_singleplayer_state(AppContext *ctx)
             {
                 // Continue
                 *ctx->paused = 0;
-                *ctx->last_tick = (unsigned int)SDL_GetTicks();
+                game_thread_resume(ctx->sim);
                 if (ctx->audio)
                 {
                     audio_sdl_resume_music(ctx->audio);
@@ -1098,6 +1239,7 @@ static void handle_singleplayer_state(AppContext *ctx)
             {
                 // Quit -> back to main menu
                 *ctx->paused = 0;
+                game_thread_stop(ctx->sim);
                 if (ctx->audio)
                 {
                     audio_sdl_resume_music(ctx->audio);
@@ -1107,21 +1249,23 @@ static void handle_singleplayer_state(AppContext *ctx)
             }
         }
 
-        ui_sdl_render_pause_menu(ctx->ui, ctx->game, ctx->player_name, *ctx->pause_selected, ctx->debug_mode, *ctx->current_tick_ms);
-        SDL_Delay(MENU_FRAME_DELAY_MS);
+        ui_sdl_render_pause_menu(ctx->ui, view, ctx->player_name, *ctx->pause_selected, ctx->debug_mode, frame->tick_ms, alpha);
+        latency_presented(ctx, "singleplayer", &frame->inputs, &ctx->sim->seen_inputs);
+        ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
         return;
     }
 
 
-    ui_sdl_render(ctx->ui, ctx->game, ctx->player_name, ctx->debug_mode, *ctx->current_tick_ms);
-    SDL_Delay(GAME_FRAME_DELAY_MS);
-
-    // Gameplay input + tick
-    int out_has_dir = 0;
-    Direction raw_dir = DIR_RIGHT;
+    uint64_t trace_t = trace_begin();
+    ui_sdl_render(ctx->ui, view, ctx->player_name, ctx->debug_mode, frame->tick_ms, alpha);
+    trace_end("ui_sdl_render", trace_t);
+    latency_presented(ctx, "singleplayer", &frame->inputs, &ctx->sim->seen_inputs);
+    int ticking = view->state == GAME_RUNNING || view->state == GAME_DYING;
+    wait_for_next_frame(ctx, ticking ? &frame->ticks : NULL);
 
+    // Gameplay input goes straight onto the game thread's input queue
     int pause = 0;
-    int running = ui_sdl_poll(ctx->ui, ctx->settings, &out_has_dir, &raw_dir, &pause);
+    int running = ui_sdl_poll(ctx->ui, ctx->settings, &ctx->sim->input, &pause);
     if (!running)
     {
         *ctx->state = APP_QUIT;
@@ -1129,12 +1273,12 @@ static void handle_singleplayer_state(AppContext *ctx)
     }
 
     // Only allow pausing during gameplay (not during death animation or game over)
-    if (pause && ctx->game->state == GAME_RUNNING)
+    if (pause && view->state == GAME_RUNNING)
     {
         *ctx->paused = 1;
+        game_thread_pause(ctx->sim);
         *ctx->pause_selected = 0;
         *ctx->pause_in_options = 0;
-        input_buffer_clear(ctx->input);
         if (ctx->audio)
         {
             audio_sdl_pause_music(ctx->audio);
@@ -1142,82 +1286,11 @@ static void handle_singleplayer_state(AppContext *ctx)
         return;
     }
 
-    if (out_has_dir)
+    // Transition to game over screen once the game thread has finished
+    if (view->state == GAME_OVER && *ctx->pending_save_this_round)
     {
-        input_buffer_push(ctx->input, raw_dir, ctx->game->snake.dir);
-    }
-
-    unsigned int now = (unsigned int)SDL_GetTicks();
-
-    // Update combo timer (every frame)
-    if (ctx->game->state == GAME_RUNNING)
-    {
-        int prev_combo = ctx->game->combo_count;
-        game_update_combo_timer(ctx->game, now);
-
-        // If combo was lost, reset speed to starting speed
-        if (prev_combo > 0 && ctx->game->combo_count == 0)
-        {
-            *ctx->current_tick_ms = tick_ms_for_combo(0);
-        }
-    }
-
-    if (ctx->game->state == GAME_RUNNING && (now - *ctx->last_tick) >= *ctx->current_tick_ms)
-    {
-        *ctx->last_tick = now;
+        game_thread_stop(ctx->sim);
 
-        Direction next_dir;
-        if (input_buffer_pop(ctx->input, &next_dir))
-        {
-            game_change_direction(ctx->game, next_dir);
-        }
-        game_update(ctx->game);
-
-        // Update speed based on combo count (smooth exponential curve)
-        if (ctx->game->food_eaten_this_frame)
-        {
-            *ctx->current_tick_ms = tick_ms_for_combo(ctx->game->combo_count);
-        }
-
-        // Handle combo SFX and timer update if food was eaten
-        if (ctx->game->food_eaten_this_frame)
-        {
-            // Update combo window based on current game speed and tier
-            // Higher tiers get more time to maintain combo
-            int tier = game_get_combo_tier(ctx->game->combo_count);
-            int window_ticks = ctx->config->combo_window_ticks + (tier - 1) * ctx->config->combo_window_increase_per_tier;
-            ctx->game->combo_window_ms = *ctx->current_tick_ms * window_ticks;
-
-            // Update combo expiry time
-            ctx->game->combo_expiry_time = now + ctx->game->combo_window_ms;
-
-            // Play combo SFX
-            if (ctx->audio)
-            {
-                char sfx_name[32];
-                snprintf(sfx_name, sizeof(sfx_name), "combo%d", tier);
-                audio_sdl_play_sound(ctx->audio, sfx_name);
-            }
-        }
-    }
-
-    // Handle death animation (fixed 50ms per segment)
-    if (ctx->game->state == GAME_DYING && (now - *ctx->last_tick) >= 50)
-    {
-        *ctx->last_tick = now;
-
-        // Remove one segment and play explosion sound
-        if (ctx->audio)
-        {
-            audio_sdl_play_sound(ctx->audio, "explosion");
-        }
-
-        game_update_death_animation(ctx->game);
-    }
-
-    // Transition to game over screen on GAME_OVER
-    if (ctx->game->state == GAME_OVER && *ctx->pending_save_this_round)
-    {
         // Freeze time at death
         ctx->game->death_time = (unsigned int)SDL_GetTicks();
 
@@ -1243,13 +1316,66 @@ static void handle_singleplayer_state(AppContext *ctx)
     }
 }
 
+typedef struct
+{
+    SDL_Thread *thread;
+    SDL_atomic_t stop;
+} LogDrainThread;
+
+/**
+ * Writes the logger's queue out every LOG_DRAIN_INTERVAL_MS, so a log call
+ * on the main or simulation thread costs a format into memory, never I/O.
+ */
+static int log_drain_main(void *data)
+{
+    LogDrainThread *t = (LogDrainThread *)data;
+    while (!SDL_AtomicGet(&t->stop))
+    {
+        log_drain();
+        SDL_Delay(LOG_DRAIN_INTERVAL_MS);
+    }
+    return 0;
+}
+
+static void log_drain_start(LogDrainThread *t)
+{
+    SDL_AtomicSet(&t->stop, 0);
+    log_set_async(1);
+    t->thread = SDL_CreateThread(log_drain_main, "log", t);
+    if (!t->thread)
+    {
+        // Stay synchronous: records are written as they are logged
+        log_set_async(0);
+        LOG_WARN("app", "Failed to create log thread: %s", SDL_GetError());
+    }
+}
+
+static void log_drain_stop(LogDrainThread *t)
+{
+    if (t->thread)
+    {
+        SDL_AtomicSet(&t->stop, 1);
+        SDL_WaitThread(t->thread, NULL);
+        t->thread = NULL;
+    }
+    log_close();
+}
+
 int main(int argc, char *argv[])
 {
-    srand((unsigned int)time(NULL));
+    srand((unsigned int)time(NULL));  // Visual effects only; gameplay uses each game's Rng
 
     // Parse command-line arguments
     int enable_audio = 1; // Audio enabled by default
     int debug_mode = 0;   // Debug mode disabled by default
+    int seed_fixed = 0;   // Random seed per game by default
+    int no_vsync = 0;     // Vsync as configured by default
+    int incremental = 0;  // Incremental world rendering only on the software renderer by default
+    int software = 0;     // Renderer picked by SDL by default
+    const char *latency_path = NULL; // No latency measurement by default
+    const char *log_path = NULL;     // Log to stderr by default
+    const char *trace_path = NULL;   // No profiling by default
+    uint64_t seed = 0;
     for (int i = 1; i < argc; i++)
     {
         if (strcmp(argv[i], "--no-audio") == 0 || strcmp(argv[i], "-na") == 0)
@@ -1260,20 +1386,72 @@ int main(int argc, char *argv[])
         else if (strcmp(argv[i], "--debug") == 0 || strcmp(argv[i], "-d") == 0)
         {
             debug_mode = 1;
+            log_set_level(LOG_LEVEL_DEBUG);
             fprintf(stderr, "Debug mode enabled\n");
         }
+        else if (strcmp(argv[i], "--no-vsync") == 0)
+        {
+            no_vsync = 1;
+            fprintf(stderr, "Vsync disabled via command-line flag\n");
+        }
+        else if (strcmp(argv[i], "--incremental") == 0)
+        {
+            incremental = 1;
+        }
+        else if (strcmp(argv[i], "--software") == 0)
+        {
+            software = 1;
+        }
+        else if (strcmp(argv[i], "--seed") == 0 && i + 1 < argc)
+        {
+            seed = strtoull(argv[++i], NULL, 10);
+            seed_fixed = 1;
+            fprintf(stderr, "Using fixed game seed %llu\n", (unsigned long long)seed);
+        }
+        else if (strcmp(argv[i], "--latency") == 0 && i + 1 < argc)
+        {
+            latency_path = argv[++i];
+            fprintf(stderr, "Measuring input latency into %s\n", latency_path);
+        }
+        else if (strcmp(argv[i], "--log") == 0 && i + 1 < argc)
+        {
+            log_path = argv[++i];
+        }
+        else if (strcmp(argv[i], "--trace") == 0 && i + 1 < argc)
+        {
+            trace_path = argv[++i];
+            fprintf(stderr, "Tracing hot paths into %s\n", trace_path);
+        }
         else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0)
         {
             printf("Snake - Snake Game\n");
             printf("Usage: %s [options]\n", argv[0]);
             printf("Options:\n");
             printf("  --no-audio, -na    Disable audio (useful for WSL2)\n");
-            printf("  --debug, -d        Enable debug mode (shows game speed)\n");
+            printf("  --debug, -d        Enable debug mode (game speed, performance graphs, debug log records)\n");
+            printf("  --seed N           Seed singleplayer games and hosted rounds with N (reproduces a run)\n");
+            printf("  --no-vsync         Pace frames with a timer instead of the display\n");
+            printf("  --incremental      Repaint only the board cells that changed each frame\n");
+            printf("  --software         Draw with the CPU (faster than an emulated GPU, e.g. llvmpipe)\n");
+            printf("  --latency FILE     Measure key-to-screen latency, write p50/p95/p99 CSV to FILE\n");
+            printf("  --trace FILE       Profile ticks, rendering, networking and audio into a Chrome trace\n");
+            printf("  --log FILE         Append log records to FILE instead of stderr\n");
             printf("  --help, -h         Show this help message\n");
             return 0;
         }
     }
 
+    if (log_path && log_open(log_path) != 0)
+    {
+        fprintf(stderr, "Warning: Failed to open log file %s, logging to stderr\n", log_path);
+    }
+
+    if (trace_path)
+    {
+        trace_start(SDL_GetPerformanceCounter, SDL_GetPerformanceFrequency());
+        trace_thread_name("main");
+    }
+
     // Set SDL audio driver hint for better WSL2/Linux compatibility
     if (enable_audio)
     {
@@ -1291,9 +1469,22 @@ int main(int argc, char *argv[])
     }
 
     // Create UI with configured window dimensions
-    UiSdl *ui = ui_sdl_create("Snake", game_config.window_width, game_config.window_height);
+    if (no_vsync)
+    {
+        game_config.vsync = 0;
+    }
+    if (software)
+    {
+        // Emulated GPUs report themselves as accelerated, so this is opt-in
+        SDL_SetHint(SDL_HINT_RENDER_DRIVER, "software");
+    }
+    UiSdl *ui = ui_sdl_create("Snake", game_config.window_width, game_config.window_height, game_config.vsync);
     if (!ui)
         return 1;
+    if (incremental)
+    {
+        ui_sdl_set_incremental(ui, 1);
+    }
 
     // Initialize settings first
     Settings settings;
@@ -1399,8 +1590,8 @@ int main(int argc, char *argv[])
     int sound_selected = 0;
     unsigned int current_tick_ms = TICK_MS;
 
-    Game game;
-    MultiplayerGame_s mp_game;
+    Game game = {0};
+    MultiplayerGame_s mp_game = {0};
     OnlineMultiplayerContext *online_ctx = online_multiplayer_create();
     if (!online_ctx)
     {
@@ -1419,9 +1610,9 @@ int main(int argc, char *argv[])
     }
     online_ctx->api = mpapi_instance;
     online_ctx->game = &mp_game;
+    online_ctx->seed_fixed = seed_fixed;
+    online_ctx->seed = seed;
 
-    InputBuffer input;
-    input_buffer_init(&input);
 
     // Use profile name from settings
     char player_name[SB_MAX_NAME_LEN];
@@ -1432,10 +1623,35 @@ int main(int argc, char *argv[])
     int pause_in_options = 0; // 0=pause menu, 1=options screen
     int game_over_selected = 0; // 0..1 (Try again, Quit)
 
-    unsigned int last_tick = 0;
-    unsigned int countdown_start = 0;
-    unsigned int gameover_start = 0;
+    TickScheduler ticks;
+    tick_scheduler_init(&ticks, SDL_GetPerformanceFrequency(), TICK_SCHEDULER_MAX_CATCH_UP);
+    GameThread sim;
+    if (!game_thread_init(&sim))
+    {
+        fprintf(stderr, "Failed to create game thread state: %s\n", SDL_GetError());
+        return 1;
+    }
+    FramePacer frames;
+    frame_pacer_init(&frames, SDL_GetPerformanceFrequency(), ui->refresh_hz, ui->vsync);
+    TimerWheel app_timers;
+    timer_wheel_init(&app_timers, SDL_GetTicks());
+    int app_timer_handles[APP_TIMER_COUNT];
+    for (int i = 0; i < APP_TIMER_COUNT; i++)
+    {
+        app_timer_handles[i] = TIMER_NONE;
+    }
     int pending_save_this_round = 0;
+    LatencyReport latency;
+    latency_report_init(&latency);
+    LatencyTrail online_inputs;
+    latency_trail_clear(&online_inputs);
+    unsigned int online_inputs_seen = 0;
+    PerfStats perf;
+    perf_stats_init(&perf);
+    if (debug_mode)
+    {
+        ui_sdl_set_perf_overlay(ui, &perf);
+    }
 
     // Initialize context struct
     AppContext ctx = {
@@ -1455,20 +1671,36 @@ int main(int argc, char *argv[])
         .mp_game = &mp_game,
         .online_ctx = online_ctx,
         .mpapi_inst = mpapi_instance,
-        .input = &input,
+        .sim = &sim,
         .player_name = player_name,
         .paused = &paused,
         .pause_selected = &pause_selected,
         .pause_in_options = &pause_in_options,
         .game_over_selected = &game_over_selected,
-        .last_tick = &last_tick,
-        .countdown_start = &countdown_start,
-        .gameover_start = &gameover_start,
+        .ticks = &ticks,
+        .frames = &frames,
+        .latency = latency_path ? &latency : NULL,
+        .online_inputs = &online_inputs,
+        .online_inputs_seen = &online_inputs_seen,
+        .perf = debug_mode ? &perf : NULL,
+        .timers = &app_timers,
+        .timer_handles = app_timer_handles,
         .pending_save_this_round = &pending_save_this_round,
-        .debug_mode = debug_mode};
+        .debug_mode = debug_mode,
+        .seed_fixed = seed_fixed,
+        .seed = seed};
+
+    LogDrainThread log_thread = {0};
+    log_drain_start(&log_thread);
 
     while (state != APP_QUIT)
     {
+        // Deadlines due by now change state before the frame is handled
+        timer_wheel_advance(&app_timers, SDL_GetTicks(), on_app_timer, &ctx);
+        // Network events change the multiplayer game only here, on this thread
+        online_multiplayer_poll(ctx.online_ctx);
+        perf_sample(&ctx);
+
         switch (state)
         {
         case APP_MENU:
@@ -1515,7 +1747,14 @@ int main(int argc, char *argv[])
         }
     }
 
+    if (latency_path && latency_report_write_csv(&latency, latency_path) != 0)
+    {
+        fprintf(stderr, "Failed to write latency report to %s\n", latency_path);
+    }
+
     scoreboard_free(&sb);
+    game_thread_free(&sim);
+    game_free(&game);
 
     // Save settings before cleanup
     settings_save(&settings);
@@ -1531,10 +1770,24 @@ int main(int argc, char *argv[])
         mpapi_destroy(ctx.mpapi_inst);
     }
 
+    // No listener can reach the multiplayer game any more
+    multiplayer_game_free(&mp_game);
+
     if (audio)
     {
         audio_sdl_destroy(audio);
     }
     ui_sdl_destroy(ui);
+
+    // Every traced thread has stopped by now
+    if (trace_path)
+    {
+        if (trace_write_json(trace_path) != 0)
+        {
+            LOG_ERROR("app", "Failed to write trace to %s", trace_path);
+        }
+        trace_stop();
+    }
+    log_drain_stop(&log_thread);
     return 0;
 }
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "multiplayer_game.h"
 #include "game.h"
+#include "constants.h"
+#include "logger.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -19,14 +21,26 @@ static const Direction START_DIRECTIONS[MAX_PLAYERS] = {
     DIR_LEFT    // Player 4
 };
 
-void multiplayer_game_init(MultiplayerGame_s *mg, int width, int height)
+void multiplayer_game_init(MultiplayerGame_s *mg, int width, int height, uint64_t seed)
 {
-    board_init(&mg->board, width, height);
+    board_init(&mg->board, width, height, MAX_PLAYERS);
+    mg->seed = seed;
+    rng_seed(&mg->rng, seed);
+    segment_pool_init(&mg->pool);
     mg->food_count = 0;
     mg->active_players = 0;
     mg->total_joined = 0;
-    // Note: is_host, local_player_index, combo_window_ms, session_id, and host_client_id
-    // are set by the caller (online_multiplayer_host/join), so don't initialize them here
+    mg->updates = 0;
+
+    // Offline defaults; online_multiplayer_host/join override the network
+    // fields right after init
+    mg->is_host = 0;
+    mg->local_player_index = -1;
+    mg->combo_window_ms = TICK_MS * BASE_COMBO_WINDOW_TICKS;
+    timer_wheel_init(&mg->timers, 0);
+    mg->session_id[0] = '\0';
+    mg->host_client_id[0] = '\0';
+    memset(mg->food, 0, sizeof(mg->food));
 
     for (int i = 0; i < MAX_PLAYERS; i++)
     {
@@ -41,16 +55,26 @@ void multiplayer_game_init(MultiplayerGame_s *mg, int width, int height)
         mg->players[i].combo_expiry_time = 0;
         mg->players[i].combo_best = 0;
         mg->players[i].food_eaten_this_frame = 0;
+        mg->players[i].combo_timer = TIMER_NONE;
         mg->players[i].is_local_player = 0;
-        mg->players[i].client_id[0] = '\0';
-        mg->players[i].name[0] = '\0';
-        mg->players[i].snake.length = 0;
-        mg->players[i].snake.dir = DIR_RIGHT;
+        memset(mg->players[i].client_id, 0, sizeof(mg->players[i].client_id));
+        memset(mg->players[i].name, 0, sizeof(mg->players[i].name));
+        snake_storage_init(&mg->players[i].snake, &mg->pool, &mg->board.occupancy, i);
         mg->players[i].ready = 0;
         input_buffer_init(&mg->players[i].input);
     }
 }
 
+void multiplayer_game_free(MultiplayerGame_s *mg)
+{
+    for (int i = 0; i < MAX_PLAYERS; i++)
+    {
+        snake_storage_free(&mg->players[i].snake);
+    }
+    segment_pool_destroy(&mg->pool);
+    board_free(&mg->board);
+}
+
 int multiplayer_game_join_player(MultiplayerGame_s *mg, int player_index)
 {
     if (player_index < 0 || player_index >= MAX_PLAYERS)
@@ -79,22 +103,21 @@ int multiplayer_game_leave_player(MultiplayerGame_s *mg, int player_index)
 
 void multiplayer_game_start(MultiplayerGame_s *mg)
 {
-    printf("DEBUG: multiplayer_game_start - entry\n");
-    fflush(stdout);
+    LOG_DEBUG("mp", "multiplayer_game_start - entry");
 
     mg->active_players = 0;
     mg->food_count = 0;
+    // Combo timers of the previous round are dropped with the old wheel
+    timer_wheel_init(&mg->timers, 0);
 
-    printf("DEBUG: multiplayer_game_start - initializing snakes\n");
-    fflush(stdout);
+    LOG_DEBUG("mp", "multiplayer_game_start - initializing snakes");
 
     // Initialize snakes for joined players
     for (int i = 0; i < MAX_PLAYERS; i++)
     {
         if (mg->players[i].joined)
         {
-            printf("DEBUG: Initializing player %d snake\n", i);
-            fflush(stdout);
+            LOG_DEBUG("mp", "Initializing player %d snake", i);
 
             snake_init(&mg->players[i].snake, START_POSITIONS[i], START_DIRECTIONS[i]);
             mg->players[i].alive = 1;
@@ -109,24 +132,16 @@ void multiplayer_game_start(MultiplayerGame_s *mg)
             mg->players[i].combo_expiry_time = 0;
             mg->players[i].combo_best = 0;
             mg->players[i].food_eaten_this_frame = 0;
+            mg->players[i].combo_timer = TIMER_NONE;
         }
     }
 
-    printf("DEBUG: multiplayer_game_start - spawning food\n");
-    fflush(stdout);
+    LOG_DEBUG("mp", "multiplayer_game_start - spawning food");
 
-    // Spawn initial food (use first joined player's snake for placement)
-    for (int i = 0; i < MAX_PLAYERS; i++)
-    {
-        if (mg->players[i].joined)
-        {
-            board_place_food(&mg->board, &mg->players[i].snake);
-            break;
-        }
-    }
+    // Spawn initial food clear of every snake
+    board_place_food(&mg->board, &mg->rng);
 
-    printf("DEBUG: multiplayer_game_start - completed\n");
-    fflush(stdout);
+    LOG_DEBUG("mp", "multiplayer_game_start - completed");
 }
 
 void multiplayer_game_add_food(MultiplayerGame_s *mg, Vec2 pos)
@@ -137,50 +152,31 @@ void multiplayer_game_add_food(MultiplayerGame_s *mg, Vec2 pos)
     }
 }
 
-static int is_position_occupied(const MultiplayerGame_s *mg, Vec2 pos)
+static int spawn_food_avoiding_snakes(MultiplayerGame_s *mg, Vec2 *out_food)
 {
-    // Check if any snake occupies this position
-    for (int i = 0; i < MAX_PLAYERS; i++)
+    // Hold the cells of food already on the board so the draw skips them.
+    // The main food is held too: the snake eating it has not moved there yet.
+    occupancy_hold(&mg->board.occupancy, mg->board.food);
+    for (int i = 0; i < mg->food_count; i++)
     {
-        if (mg->players[i].alive && snake_occupies(&mg->players[i].snake, pos))
-        {
-            return 1;
-        }
+        occupancy_hold(&mg->board.occupancy, mg->food[i]);
     }
 
-    // Check if food is at this position
-    if (vec2_equal(mg->board.food, pos))
-        return 1;
+    Vec2 pos;
+    int placed = board_random_free_cell(&mg->board, &mg->rng, &pos);
 
+    occupancy_unhold(&mg->board.occupancy, mg->board.food);
     for (int i = 0; i < mg->food_count; i++)
     {
-        if (vec2_equal(mg->food[i], pos))
-            return 1;
+        occupancy_unhold(&mg->board.occupancy, mg->food[i]);
     }
 
-    return 0;
-}
-
-static void spawn_food_avoiding_snakes(MultiplayerGame_s *mg, Vec2 *out_food)
-{
-    int max_attempts = 1000;
-    for (int attempt = 0; attempt < max_attempts; attempt++)
+    // Board full: leave the food where it is (under the snake that ate it)
+    if (placed)
     {
-        Vec2 candidate = {
-            rand() % mg->board.width,
-            rand() % mg->board.height
-        };
-
-        if (!is_position_occupied(mg, candidate))
-        {
-            *out_food = candidate;
-            return;
-        }
+        *out_food = pos;
     }
-
-    // Fallback: just place anywhere
-    out_food->x = rand() % mg->board.width;
-    out_food->y = rand() % mg->board.height;
+    return placed;
 }
 
 void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
@@ -239,17 +235,17 @@ void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
     // Second pass: Check collisions for all snakes (don't move yet)
     int has_collision[MAX_PLAYERS];
 
-    // DEBUG: Print alive players
-    static int debug_counter = 0;
-    if (debug_counter++ % 50 == 0) {  // Print every 50 ticks
-        printf("DEBUG: Alive players: ");
-        for (int i = 0; i < MAX_PLAYERS; i++) {
+    // DEBUG: Log alive players every 50 ticks of this game
+    if (mg->updates++ % 50 == 0 && LOG_ENABLED(LOG_LEVEL_DEBUG)) {
+        char alive[LOG_LINE_MAX];
+        int used = 0;
+        alive[0] = '\0';
+        for (int i = 0; i < MAX_PLAYERS && used < (int)sizeof(alive); i++) {
             if (mg->players[i].alive) {
-                printf("P%d(len=%d) ", i, mg->players[i].snake.length);
+                used += snprintf(alive + used, sizeof(alive) - used, "P%d(len=%d) ", i, mg->players[i].snake.length);
             }
         }
-        printf("\n");
-        fflush(stdout);
+        LOG_DEBUG("mp", "Alive players: %s", alive);
     }
 
     // Initialize collision flags
@@ -274,9 +270,8 @@ void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
                 // Both snakes trying to move to same position - both die
                 has_collision[i] = 1;
                 has_collision[j] = 1;
-                printf("DEBUG: Head-to-head collision between P%d and P%d at (%d,%d)\n",
-                       i, j, next_positions[i].x, next_positions[i].y);
-                fflush(stdout);
+                LOG_DEBUG("mp", "Head-to-head collision between P%d and P%d at (%d,%d)",
+                          i, j, next_positions[i].x, next_positions[i].y);
             }
         }
     }
@@ -318,8 +313,7 @@ void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
                     if (snake_occupies_excluding_tail(snake, next))
                     {
                         has_collision[i] = 1;
-                        printf("DEBUG: Player %d collision with own body at (%d,%d)\n", i, next.x, next.y);
-                        fflush(stdout);
+                        LOG_DEBUG("mp", "Player %d collision with own body at (%d,%d)", i, next.x, next.y);
                         break;
                     }
                 }
@@ -334,8 +328,7 @@ void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
                     if (snake_occupies(&mg->players[j].snake, next))
                     {
                         has_collision[i] = 1;
-                        printf("DEBUG: Player %d collision with player %d at (%d,%d) - other eating food\n", i, j, next.x, next.y);
-                        fflush(stdout);
+                        LOG_DEBUG("mp", "Player %d collision with player %d at (%d,%d) - other eating food", i, j, next.x, next.y);
                         break;
                     }
                 }
@@ -345,8 +338,7 @@ void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
                     if (snake_occupies_excluding_tail(&mg->players[j].snake, next))
                     {
                         has_collision[i] = 1;
-                        printf("DEBUG: Player %d collision with player %d at (%d,%d)\n", i, j, next.x, next.y);
-                        fflush(stdout);
+                        LOG_DEBUG("mp", "Player %d collision with player %d at (%d,%d)", i, j, next.x, next.y);
                         break;
                     }
                 }
@@ -379,8 +371,8 @@ void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
         {
             Vec2 next = next_positions[i];
 
-            // Update combo system
-            if (player->combo_count > 0 && player->combo_expiry_time > 0)
+            // Update combo system (the count drops to 0 when its timer fires)
+            if (player->combo_count > 0)
             {
                 player->combo_count++;
             }
@@ -399,7 +391,6 @@ void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
             player->score += 10 * multiplier;
             player->fruits_eaten++;
             player->food_eaten_this_frame = 1;
-            player->combo_expiry_time = 1;  // Placeholder, updated by host timer
 
             // Only host generates new food - clients wait for food position from network
             if (is_host)
@@ -407,7 +398,10 @@ void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
                 // Check main board food
                 if (vec2_equal(next, mg->board.food))
                 {
-                    spawn_food_avoiding_snakes(mg, &mg->board.food);
+                    if (!spawn_food_avoiding_snakes(mg, &mg->board.food))
+                    {
+                        LOG_DEBUG("mp", "Board full, no free cell for food");
+                    }
                 }
                 else
                 {
@@ -436,6 +430,51 @@ void multiplayer_game_update(MultiplayerGame_s *mg, int is_host)
     }
 }
 
+static void multiplayer_game_on_timer(void *user, int kind, int data, unsigned int due)
+{
+    MultiplayerGame_s *mg = (MultiplayerGame_s *)user;
+    (void)due;
+
+    if (kind == MP_TIMER_COMBO && data >= 0 && data < MAX_PLAYERS)
+    {
+        MultiplayerPlayer *p = &mg->players[data];
+        p->combo_count = 0;
+        p->combo_expiry_time = 0;
+        p->combo_timer = TIMER_NONE;
+    }
+}
+
+void multiplayer_game_update_timers(MultiplayerGame_s *mg, unsigned int now)
+{
+    timer_wheel_advance(&mg->timers, now, multiplayer_game_on_timer, mg);
+}
+
+void multiplayer_game_start_combo_timer(MultiplayerGame_s *mg, int player_index, unsigned int now)
+{
+    if (player_index < 0 || player_index >= MAX_PLAYERS)
+        return;
+
+    // Bring the clock up first so the window is measured from `now`
+    multiplayer_game_update_timers(mg, now);
+
+    MultiplayerPlayer *p = &mg->players[player_index];
+    timer_wheel_cancel(&mg->timers, p->combo_timer);
+    p->combo_expiry_time = now + mg->combo_window_ms;
+    p->combo_timer = timer_wheel_schedule(&mg->timers, p->combo_expiry_time, MP_TIMER_COMBO, player_index);
+}
+
+void multiplayer_game_clear_combo(MultiplayerGame_s *mg, int player_index)
+{
+    if (player_index < 0 || player_index >= MAX_PLAYERS)
+        return;
+
+    MultiplayerPlayer *p = &mg->players[player_index];
+    timer_wheel_cancel(&mg->timers, p->combo_timer);
+    p->combo_timer = TIMER_NONE;
+    p->combo_count = 0;
+    p->combo_expiry_time = 0;
+}
+
 void multiplayer_game_change_direction(MultiplayerGame_s *mg, int player_index, Direction dir)
 {
     if (player_index < 0 || player_index >= MAX_PLAYERS)
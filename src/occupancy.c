@@ -0,0 +1,123 @@
+#include "occupancy.h"
+#include <stdlib.h>
+
+static int occupancy_index(const OccupancyGrid *g, Vec2 pos) {
+    if (!g->ages || pos.x < 0 || pos.x >= g->width || pos.y < 0 || pos.y >= g->height) {
+        return -1;
+    }
+    return pos.y * g->width + pos.x;
+}
+
+// A cell gained a taker: drop it from the free set when it was free
+static void occupancy_take(OccupancyGrid *g, int cell) {
+    if (g->takers[cell]++ != 0) return;
+
+    // Swap-remove: move the last free cell into the vacated slot
+    int slot = g->free_slot[cell];
+    int last = g->free_cells[--g->free_count];
+    g->free_cells[slot] = last;
+    g->free_slot[last] = slot;
+    g->free_slot[cell] = -1;
+}
+
+// A cell lost a taker: append it to the free set when it became free
+static void occupancy_give(OccupancyGrid *g, int cell) {
+    if (g->takers[cell] == 0 || --g->takers[cell] != 0) return;
+
+    g->free_slot[cell] = g->free_count;
+    g->free_cells[g->free_count++] = cell;
+}
+
+int occupancy_init(OccupancyGrid *g, int width, int height, int owners) {
+    g->width = width;
+    g->height = height;
+    g->owners = owners;
+    g->ages = NULL;
+    g->takers = NULL;
+    g->free_cells = NULL;
+    g->free_slot = NULL;
+    g->free_count = 0;
+
+    if (width <= 0 || height <= 0 || owners <= 0) {
+        return 0;
+    }
+
+    size_t cells = (size_t)width * (size_t)height;
+    g->ages = calloc((size_t)owners * cells, sizeof(unsigned int));
+    g->takers = calloc(cells, sizeof(unsigned short));
+    g->free_cells = malloc(cells * sizeof(int));
+    g->free_slot = malloc(cells * sizeof(int));
+    if (!g->ages || !g->takers || !g->free_cells || !g->free_slot) {
+        occupancy_free(g);
+        return 0;
+    }
+
+    for (int i = 0; i < (int)cells; i++) {
+        g->free_cells[i] = i;
+        g->free_slot[i] = i;
+    }
+    g->free_count = (int)cells;
+    return 1;
+}
+
+void occupancy_free(OccupancyGrid *g) {
+    free(g->ages);
+    free(g->takers);
+    free(g->free_cells);
+    free(g->free_slot);
+    g->ages = NULL;
+    g->takers = NULL;
+    g->free_cells = NULL;
+    g->free_slot = NULL;
+    g->free_count = 0;
+}
+
+int occupancy_free_cell(const OccupancyGrid *g, int n, Vec2 *out) {
+    if (n < 0 || n >= g->free_count) {
+        return 0;
+    }
+
+    int cell = g->free_cells[n];
+    out->x = cell % g->width;
+    out->y = cell / g->width;
+    return 1;
+}
+
+void occupancy_hold(OccupancyGrid *g, Vec2 pos) {
+    int cell = occupancy_index(g, pos);
+    if (cell >= 0) {
+        occupancy_take(g, cell);
+    }
+}
+
+void occupancy_unhold(OccupancyGrid *g, Vec2 pos) {
+    int cell = occupancy_index(g, pos);
+    if (cell >= 0) {
+        occupancy_give(g, cell);
+    }
+}
+
+void occupancy_mark(OccupancyGrid *g, int owner, Vec2 pos, unsigned int age) {
+    int cell = occupancy_index(g, pos);
+    if (cell < 0 || owner < 0 || owner >= g->owners) return;
+
+    unsigned int *slot = &g->ages[owner * g->width * g->height + cell];
+    if (*slot == 0) {
+        *slot = age;
+        occupancy_take(g, cell);
+    } else if ((int)(age - *slot) > 0) {
+        // Wrap-safe "age is newer than the recorded segment"
+        *slot = age;
+    }
+}
+
+void occupancy_unmark(OccupancyGrid *g, int owner, Vec2 pos, unsigned int age) {
+    int cell = occupancy_index(g, pos);
+    if (cell < 0 || owner < 0 || owner >= g->owners) return;
+
+    unsigned int *slot = &g->ages[owner * g->width * g->height + cell];
+    if (*slot != 0 && *slot == age) {
+        *slot = 0;
+        occupancy_give(g, cell);
+    }
+}
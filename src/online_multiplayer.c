@@ -1,5 +1,7 @@
 #include "online_multiplayer.h"
 #include "game.h"
+#include "logger.h"
+#include "trace.h"
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
@@ -9,17 +11,24 @@
 #define INITIAL_LIVES 3
 #define POINTS_PER_FOOD 10
 
+// Message totals for the performance HUD (sent from the main thread,
+// received on mpapi's listener thread)
+static SDL_atomic_t messages_sent;
+static SDL_atomic_t messages_received;
+
 // Forward declarations of internal functions
 static void mpapi_event_callback(const char *event, int64_t messageId, const char *clientId, json_t *data, void *context);
+static void dispatch_event(OnlineMultiplayerContext *ctx, const OnlineEvent *ev);
+static void free_events(OnlineEvent *ev);
 static void handle_player_joined(OnlineMultiplayerContext *ctx, const char *clientId, json_t *data);
 static void handle_player_left(OnlineMultiplayerContext *ctx, const char *clientId);
-static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clientId, json_t *data);
-static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data);
+static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clientId, json_t *data, unsigned int received_ms);
+static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data, unsigned int received_ms);
+static void seed_round(MultiplayerGame_s *game, uint64_t seed);
 static void respawn_player(MultiplayerGame_s *game, int player_idx);
 static Vec2 find_safe_spawn_position(MultiplayerGame_s *game);
-static void update_player_combo_timer(MultiplayerPlayer *p, unsigned int current_time, unsigned int combo_window_ms);
 static json_t* serialize_player(MultiplayerPlayer *player);
-static void deserialize_player(MultiplayerPlayer *player, json_t *data);
+static void deserialize_player(MultiplayerPlayer *player, json_t *data, int max_segments);
 
 // Lifecycle functions
 
@@ -39,6 +48,12 @@ OnlineMultiplayerContext* online_multiplayer_create(void)
     ctx->error_message[0] = '\0';
     ctx->our_client_id[0] = '\0';
 
+    ctx->inbox_lock = SDL_CreateMutex();
+    if (!ctx->inbox_lock) {
+        free(ctx);
+        return NULL;
+    }
+
     return ctx;
 }
 
@@ -51,50 +66,77 @@ void online_multiplayer_destroy(OnlineMultiplayerContext *ctx)
         mpapi_unlisten(ctx->api, ctx->listener_id);
     }
 
+    // Events nobody will apply any more
+    free_events(ctx->inbox_head);
+    SDL_DestroyMutex(ctx->inbox_lock);
     free(ctx);
 }
 
+void online_multiplayer_poll(OnlineMultiplayerContext *ctx)
+{
+    if (!ctx) return;
+
+    // Take the whole queue so the listener thread never waits on a handler
+    SDL_LockMutex(ctx->inbox_lock);
+    OnlineEvent *events = ctx->inbox_head;
+    ctx->inbox_head = NULL;
+    ctx->inbox_tail = NULL;
+    SDL_UnlockMutex(ctx->inbox_lock);
+
+    for (OnlineEvent *ev = events; ev; ev = ev->next) {
+        dispatch_event(ctx, ev);
+    }
+    free_events(events);
+}
+
 // Host operations
 
 int online_multiplayer_host(OnlineMultiplayerContext *ctx, int is_private, int board_width, int board_height, const char *player_name)
 {
-    printf("DEBUG: online_multiplayer_host called\n");
-    printf("DEBUG: ctx=%p, ctx->api=%p, ctx->game=%p\n", (void*)ctx, (void*)(ctx ? ctx->api : NULL), (void*)(ctx ? ctx->game : NULL));
+    LOG_DEBUG("online", "online_multiplayer_host called");
+    LOG_DEBUG("online", "ctx=%p, ctx->api=%p, ctx->game=%p", (void*)ctx, (void*)(ctx ? ctx->api : NULL), (void*)(ctx ? ctx->game : NULL));
 
     if (!ctx || !ctx->api || !ctx->game) {
-        printf("DEBUG: NULL pointer check failed\n");
+        LOG_ERROR("online", "NULL pointer check failed");
         return MPAPI_ERR_ARGUMENT;
     }
 
-    printf("DEBUG: Setting is_private=%d\n", is_private);
+    LOG_DEBUG("online", "Setting is_private=%d", is_private);
     ctx->is_private = is_private;
 
     // Create host data JSON
-    printf("DEBUG: Creating host data JSON\n");
+    LOG_DEBUG("online", "Creating host data JSON");
     json_t *host_data = json_object();
     json_object_set_new(host_data, "name", json_string("Snake Game"));
     json_object_set_new(host_data, "private", json_boolean(is_private));
 
     char *session_id = NULL;
     char *client_id = NULL;
-    printf("DEBUG: Calling mpapi_host\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "Calling mpapi_host");
 
     int rc = mpapi_host(ctx->api, host_data, &session_id, &client_id, NULL);
 
-    printf("DEBUG: mpapi_host returned %d\n", rc);
-    fflush(stdout);
+    LOG_DEBUG("online", "mpapi_host returned %d", rc);
     json_decref(host_data);
 
     if (rc != MPAPI_OK) {
-        printf("DEBUG: mpapi_host failed with error %d\n", rc);
+        LOG_ERROR("online", "mpapi_host failed with error %d", rc);
         snprintf(ctx->error_message, sizeof(ctx->error_message),
                  "Failed to host session: error %d", rc);
         return rc;
     }
 
-    // Store session info
-    printf("DEBUG: Storing session info\n");
+    // Initialize game as host
+    LOG_DEBUG("online", "Initializing multiplayer game");
+    multiplayer_game_free(ctx->game);
+    multiplayer_game_init(ctx->game, board_width, board_height, ctx->seed_fixed ? ctx->seed : rng_entropy_seed());
+    LOG_INFO("online", "Match seed: %llu", (unsigned long long)ctx->game->seed);
+    ctx->game->is_host = 1;
+    ctx->game->local_player_index = 0; // Host is player 0
+    ctx->game->combo_window_ms = 95 * COMBO_WINDOW_TICKS; // Initial tick speed
+
+    // Store session info (init cleared it)
+    LOG_DEBUG("online", "Storing session info");
     if (session_id) {
         strncpy(ctx->game->session_id, session_id, sizeof(ctx->game->session_id) - 1);
         free(session_id);
@@ -107,20 +149,13 @@ int online_multiplayer_host(OnlineMultiplayerContext *ctx, int is_private, int b
         free(client_id);
     }
 
-    // Initialize game as host
-    printf("DEBUG: Initializing multiplayer game\n");
-    multiplayer_game_init(ctx->game, board_width, board_height);
-    ctx->game->is_host = 1;
-    ctx->game->local_player_index = 0; // Host is player 0
-    ctx->game->combo_window_ms = 95 * COMBO_WINDOW_TICKS; // Initial tick speed
-
     // Host auto-joins as player 0
     MultiplayerPlayer *p = &ctx->game->players[0];
     p->joined = 1;
     p->alive = 0; // Not alive until game starts
 
     // Initialize snake (empty until game starts)
-    p->snake.length = 0;
+    snake_clear(&p->snake);
     p->snake.dir = DIR_RIGHT;
     p->death_state = GAME_RUNNING;
 
@@ -130,8 +165,7 @@ int online_multiplayer_host(OnlineMultiplayerContext *ctx, int is_private, int b
     p->score = 0;
     p->fruits_eaten = 0;
     p->lives = INITIAL_LIVES;
-    p->combo_count = 0;
-    p->combo_expiry_time = 0;
+    multiplayer_game_clear_combo(ctx->game, 0);
     p->combo_best = 0;
     p->food_eaten_this_frame = 0;
     strncpy(p->client_id, ctx->game->host_client_id, sizeof(p->client_id) - 1);
@@ -141,28 +175,22 @@ int online_multiplayer_host(OnlineMultiplayerContext *ctx, int is_private, int b
     ctx->game->total_joined = 1;
 
     // Register event listener
-    printf("DEBUG: Registering event listener\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "Registering event listener");
     ctx->listener_id = mpapi_listen(ctx->api, mpapi_event_callback, ctx);
-    printf("DEBUG: mpapi_listen returned listener_id=%d\n", ctx->listener_id);
-    fflush(stdout);
+    LOG_DEBUG("online", "mpapi_listen returned listener_id=%d", ctx->listener_id);
     if (ctx->listener_id < 0) {
-        printf("DEBUG: Event listener registration FAILED\n");
-        fflush(stdout);
+        LOG_ERROR("online", "Event listener registration FAILED");
         snprintf(ctx->error_message, sizeof(ctx->error_message),
                  "Failed to register event listener");
         return MPAPI_ERR_STATE;
     }
-    printf("DEBUG: Event listener registered successfully\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "Event listener registered successfully");
 
     // Set state to lobby
     ctx->state = ONLINE_STATE_LOBBY;
-    printf("DEBUG: State set to ONLINE_STATE_LOBBY\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "State set to ONLINE_STATE_LOBBY");
 
-    printf("DEBUG: online_multiplayer_host returning MPAPI_OK\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "online_multiplayer_host returning MPAPI_OK");
     return MPAPI_OK;
 }
 
@@ -177,9 +205,10 @@ void online_multiplayer_host_update(OnlineMultiplayerContext *ctx, unsigned int
     // 1. Process input for host's own player only (remote players send their positions)
     int host_player_idx = game->local_player_index;
     if (host_player_idx >= 0 && host_player_idx < MAX_PLAYERS && game->players[host_player_idx].alive) {
-        Direction dir;
-        if (input_buffer_pop(&game->players[host_player_idx].input, &dir)) {
-            snake_change_direction(&game->players[host_player_idx].snake, dir);
+        MultiplayerPlayer *host_player = &game->players[host_player_idx];
+        InputEvent press;
+        if (input_buffer_pop(&host_player->input, host_player->snake.dir, &press)) {
+            snake_change_direction(&host_player->snake, press.dir);
         }
     }
 
@@ -194,10 +223,11 @@ void online_multiplayer_host_update(OnlineMultiplayerContext *ctx, unsigned int
 
     // 5. Update combo timers for all players
     for (int i = 0; i < MAX_PLAYERS; i++) {
-        if (game->players[i].alive) {
-            update_player_combo_timer(&game->players[i], current_time, game->combo_window_ms);
+        if (game->players[i].alive && game->players[i].food_eaten_this_frame) {
+            multiplayer_game_start_combo_timer(game, i, current_time);
         }
     }
+    multiplayer_game_update_timers(game, current_time);
 
     // 6. Broadcast state to all clients
     online_multiplayer_host_broadcast_state(ctx);
@@ -233,22 +263,21 @@ void online_multiplayer_host_update(OnlineMultiplayerContext *ctx, unsigned int
 
         if (winner_idx >= 0) {
             game->players[winner_idx].wins++;
-            printf("DEBUG: Player %d (%s) wins! Total wins: %d\n",
-                   winner_idx, game->players[winner_idx].name, game->players[winner_idx].wins);
+            LOG_INFO("online", "Player %d (%s) wins! Total wins: %d",
+                     winner_idx, game->players[winner_idx].name, game->players[winner_idx].wins);
         }
 
         // Broadcast game over to all clients
         json_t *game_over_cmd = json_object();
         json_object_set_new(game_over_cmd, "command", json_string("game_over"));
 
-        int rc = mpapi_game(ctx->api, game_over_cmd, NULL);
+        int rc = online_multiplayer_send(ctx->api, game_over_cmd);
         if (rc != MPAPI_OK) {
             ctx->connection_lost = 1;
         }
 
         json_decref(game_over_cmd);
-        printf("DEBUG: Broadcast game_over command\n");
-        fflush(stdout);
+        LOG_DEBUG("online", "Broadcast game_over command");
     }
 }
 
@@ -256,10 +285,12 @@ void online_multiplayer_host_broadcast_state(OnlineMultiplayerContext *ctx)
 {
     if (!ctx || !ctx->api) return;
 
+    uint64_t trace_t = trace_begin();
     json_t *state = online_multiplayer_serialize_state(ctx->game);
+    trace_end("serialize_state", trace_t);
 
     // Broadcast to all clients (destination = NULL)
-    int rc = mpapi_game(ctx->api, state, NULL);
+    int rc = online_multiplayer_send(ctx->api, state);
 
     if (rc != MPAPI_OK) {
         snprintf(ctx->error_message, sizeof(ctx->error_message),
@@ -274,31 +305,33 @@ void online_multiplayer_host_broadcast_state(OnlineMultiplayerContext *ctx)
 
 int online_multiplayer_join(OnlineMultiplayerContext *ctx, const char *session_id, int board_width, int board_height, const char *player_name)
 {
-    printf("DEBUG: online_multiplayer_join called with session_id=%s\n", session_id);
-    fflush(stdout);
+    LOG_DEBUG("online", "online_multiplayer_join called with session_id=%s", session_id);
 
     if (!ctx || !ctx->api || !ctx->game || !session_id) {
-        printf("DEBUG: NULL pointer check failed\n");
-        fflush(stdout);
+        LOG_ERROR("online", "NULL pointer check failed");
         return MPAPI_ERR_ARGUMENT;
     }
 
+    // Initialize game as client before any event can reach it
+    multiplayer_game_free(ctx->game);
+    // Until the host's start_game message brings the round seed
+    multiplayer_game_init(ctx->game, board_width, board_height, ctx->seed_fixed ? ctx->seed : rng_entropy_seed());
+    LOG_INFO("online", "Match seed: %llu", (unsigned long long)ctx->game->seed);
+    ctx->game->is_host = 0;
+    ctx->game->local_player_index = -1;
+
     // Register event listener BEFORE joining to catch the "joined" event
-    printf("DEBUG: Registering event listener BEFORE join\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "Registering event listener BEFORE join");
     ctx->listener_id = mpapi_listen(ctx->api, mpapi_event_callback, ctx);
-    printf("DEBUG: mpapi_listen returned listener_id=%d\n", ctx->listener_id);
-    fflush(stdout);
+    LOG_DEBUG("online", "mpapi_listen returned listener_id=%d", ctx->listener_id);
     if (ctx->listener_id < 0) {
-        printf("DEBUG: Event listener registration FAILED\n");
-        fflush(stdout);
+        LOG_ERROR("online", "Event listener registration FAILED");
         snprintf(ctx->error_message, sizeof(ctx->error_message),
                  "Failed to register event listener");
         return MPAPI_ERR_STATE;
     }
 
-    printf("DEBUG: Creating join data JSON\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "Creating join data JSON");
     json_t *join_data = json_object();
     json_object_set_new(join_data, "join", json_boolean(1));
     json_object_set_new(join_data, "name", json_string(player_name ? player_name : "Player"));
@@ -306,17 +339,14 @@ int online_multiplayer_join(OnlineMultiplayerContext *ctx, const char *session_i
     char *returned_session = NULL;
     char *client_id = NULL;
     json_t *join_response = NULL;
-    printf("DEBUG: Calling mpapi_join\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "Calling mpapi_join");
     int rc = mpapi_join(ctx->api, session_id, join_data, &returned_session, &client_id, &join_response);
 
-    printf("DEBUG: mpapi_join returned %d\n", rc);
-    fflush(stdout);
+    LOG_DEBUG("online", "mpapi_join returned %d", rc);
     json_decref(join_data);
 
     if (rc != MPAPI_OK) {
-        printf("DEBUG: mpapi_join failed with error %d\n", rc);
-        fflush(stdout);
+        LOG_ERROR("online", "mpapi_join failed with error %d", rc);
 
         // Clean up listener since join failed
         if (ctx->listener_id >= 0) {
@@ -342,39 +372,32 @@ int online_multiplayer_join(OnlineMultiplayerContext *ctx, const char *session_i
     if (client_id) {
         strncpy(ctx->our_client_id, client_id, sizeof(ctx->our_client_id) - 1);
         ctx->our_client_id[sizeof(ctx->our_client_id) - 1] = '\0';
-        printf("DEBUG: Our client_id: %s\n", ctx->our_client_id);
-        fflush(stdout);
+        LOG_DEBUG("online", "Our client_id: %s", ctx->our_client_id);
     }
 
-    // Initialize game as client
-    multiplayer_game_init(ctx->game, board_width, board_height);
-    ctx->game->is_host = 0;
-    ctx->game->local_player_index = -1;
-
     // Parse join response FIRST to get existing players and our correct slot
-    printf("DEBUG: join_response=%p\n", (void*)join_response);
-    fflush(stdout);
+    LOG_DEBUG("online", "join_response=%p", (void*)join_response);
     if (join_response && json_is_object(join_response)) {
-        printf("DEBUG: join_response is a valid JSON object\n");
-        fflush(stdout);
+        LOG_DEBUG("online", "join_response is a valid JSON object");
 
         // Debug: print all keys in the response
         const char *key;
         json_t *value;
-        printf("DEBUG: Keys in join_response: ");
+        char keys[LOG_LINE_MAX];
+        int used = 0;
+        keys[0] = '\0';
         json_object_foreach(join_response, key, value) {
-            printf("%s, ", key);
+            if (used < (int)sizeof(keys)) {
+                used += snprintf(keys + used, sizeof(keys) - used, "%s, ", key);
+            }
         }
-        printf("\n");
-        fflush(stdout);
+        LOG_DEBUG("online", "Keys in join_response: %s", keys);
 
         json_t *clients_array = json_object_get(join_response, "clients");
-        printf("DEBUG: clients_array=%p\n", (void*)clients_array);
-        fflush(stdout);
+        LOG_DEBUG("online", "clients_array=%p", (void*)clients_array);
         if (json_is_array(clients_array)) {
             size_t num_clients = json_array_size(clients_array);
-            printf("DEBUG: Join response has %zu clients\n", num_clients);
-            fflush(stdout);
+            LOG_DEBUG("online", "Join response has %zu clients", num_clients);
 
             // Add all existing clients (including ourselves) as players
             for (size_t i = 0; i < num_clients && i < MAX_PLAYERS; i++) {
@@ -390,8 +413,7 @@ int online_multiplayer_join(OnlineMultiplayerContext *ctx, const char *session_i
                     if (client_id && strcmp(cid, client_id) == 0) {
                         p->is_local_player = 1;
                         ctx->game->local_player_index = i;
-                        printf("DEBUG: Local player is at index %d\n", (int)i);
-                        fflush(stdout);
+                        LOG_DEBUG("online", "Local player is at index %d", (int)i);
                     } else {
                         p->is_local_player = 0;
                     }
@@ -400,8 +422,7 @@ int online_multiplayer_join(OnlineMultiplayerContext *ctx, const char *session_i
                     p->score = 0;
                     p->fruits_eaten = 0;
                     p->lives = INITIAL_LIVES;
-                    p->combo_count = 0;
-                    p->combo_expiry_time = 0;
+                    multiplayer_game_clear_combo(ctx->game, (int)i);
                     p->combo_best = 0;
                     p->food_eaten_this_frame = 0;
 
@@ -409,13 +430,11 @@ int online_multiplayer_join(OnlineMultiplayerContext *ctx, const char *session_i
                 }
             }
         } else {
-            printf("DEBUG: clients_array is not an array or not found\n");
-            fflush(stdout);
+            LOG_DEBUG("online", "clients_array is not an array or not found");
         }
         json_decref(join_response);
     } else {
-        printf("DEBUG: join_response is NULL or not a JSON object\n");
-        fflush(stdout);
+        LOG_DEBUG("online", "join_response is NULL or not a JSON object");
     }
 
     if (client_id) {
@@ -425,27 +444,26 @@ int online_multiplayer_join(OnlineMultiplayerContext *ctx, const char *session_i
     // Event listener already registered before join
     // Set state to lobby
     ctx->state = ONLINE_STATE_LOBBY;
-    printf("DEBUG: State set to ONLINE_STATE_LOBBY\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "State set to ONLINE_STATE_LOBBY");
 
-    printf("DEBUG: online_multiplayer_join returning MPAPI_OK\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "online_multiplayer_join returning MPAPI_OK");
     return MPAPI_OK;
 }
 
-void online_multiplayer_client_send_input(OnlineMultiplayerContext *ctx, Direction dir)
+void online_multiplayer_client_send_input(OnlineMultiplayerContext *ctx, Direction dir, unsigned int time_ms)
 {
     if (!ctx || !ctx->api) return;
 
     // Buffer input using the player's InputBuffer system
-    // This validates 180-degree turns and queues up to 2 inputs
+    // (180-degree turns are skipped when the tick pops it)
     int local_idx = ctx->game->local_player_index;
     if (local_idx < 0 || local_idx >= MAX_PLAYERS) return;
 
     MultiplayerPlayer *local_player = &ctx->game->players[local_idx];
     if (!local_player->alive || local_player->death_state != GAME_RUNNING) return;
 
-    input_buffer_push(&local_player->input, dir, local_player->snake.dir);
+    // Stamped with the key press, so latency includes the wait for the poll
+    input_buffer_push(&local_player->input, dir, time_ms);
 
     // Create JSON: {"dir": "UP|DOWN|LEFT|RIGHT", "segments": [...], "direction": dir}
     json_t *input = json_object();
@@ -464,14 +482,15 @@ void online_multiplayer_client_send_input(OnlineMultiplayerContext *ctx, Directi
     // Include current snake position for reconciliation
     json_t *segments = json_array();
     for (int i = 0; i < local_player->snake.length; i++) {
-        json_array_append_new(segments, json_integer(local_player->snake.segments[i].x));
-        json_array_append_new(segments, json_integer(local_player->snake.segments[i].y));
+        Vec2 seg = snake_segment(&local_player->snake, i);
+        json_array_append_new(segments, json_integer(seg.x));
+        json_array_append_new(segments, json_integer(seg.y));
     }
     json_object_set_new(input, "segments", segments);
     json_object_set_new(input, "direction", json_integer(local_player->snake.dir));
 
     // Send to host (destination = NULL broadcasts to all, including host)
-    int rc = mpapi_game(ctx->api, input, NULL);
+    int rc = online_multiplayer_send(ctx->api, input);
 
     if (rc != MPAPI_OK) {
         ctx->connection_lost = 1;
@@ -486,23 +505,24 @@ void online_multiplayer_client_send_input(OnlineMultiplayerContext *ctx, Directi
 
 void online_multiplayer_start_game(OnlineMultiplayerContext *ctx)
 {
-    printf("DEBUG: online_multiplayer_start_game called\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "online_multiplayer_start_game called");
 
     if (!ctx || !ctx->game) {
-        printf("DEBUG: start_game - NULL check failed\n");
-        fflush(stdout);
+        LOG_ERROR("online", "start_game - NULL check failed");
         return;
     }
 
-    printf("DEBUG: Calling multiplayer_game_start\n");
-    fflush(stdout);
+    // Every peer draws the round's food and spawns from the host's seed
+    if (ctx->game->is_host) {
+        seed_round(ctx->game, ctx->seed_fixed ? ctx->seed : rng_entropy_seed());
+    }
+
+    LOG_DEBUG("online", "Calling multiplayer_game_start");
 
     // Start the multiplayer game
     multiplayer_game_start(ctx->game);
 
-    printf("DEBUG: multiplayer_game_start completed, initializing lives\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "multiplayer_game_start completed, initializing lives");
 
     // Initialize lives for all players
     for (int i = 0; i < MAX_PLAYERS; i++) {
@@ -510,21 +530,18 @@ void online_multiplayer_start_game(OnlineMultiplayerContext *ctx)
             ctx->game->players[i].lives = INITIAL_LIVES;
             ctx->game->players[i].score = 0;
             ctx->game->players[i].fruits_eaten = 0;
-            ctx->game->players[i].combo_count = 0;
-            ctx->game->players[i].combo_expiry_time = 0;
+            multiplayer_game_clear_combo(ctx->game, i);
             ctx->game->players[i].combo_best = 0;
         }
     }
 
-    printf("DEBUG: Setting state to COUNTDOWN\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "Setting state to COUNTDOWN");
 
     ctx->state = ONLINE_STATE_COUNTDOWN;
 
     // Broadcast game start to all clients (only host should call this)
     if (ctx->game->is_host) {
-        printf("DEBUG: Broadcasting start_game command\n");
-        fflush(stdout);
+        LOG_DEBUG("online", "Broadcasting start_game command");
 
         // Host calculates their own start timestamp (3 seconds from now)
         unsigned int current_time = (unsigned int)SDL_GetTicks();
@@ -534,22 +551,21 @@ void online_multiplayer_start_game(OnlineMultiplayerContext *ctx)
         json_object_set_new(start_cmd, "command", json_string("start_game"));
         // Send RELATIVE delay (3000ms) instead of absolute timestamp
         json_object_set_new(start_cmd, "countdown_ms", json_integer(3000));
+        // Bit pattern of the unsigned seed
+        json_object_set_new(start_cmd, "seed", json_integer((json_int_t)ctx->game->seed));
 
-        int rc = mpapi_game(ctx->api, start_cmd, NULL);
+        int rc = online_multiplayer_send(ctx->api, start_cmd);
         if (rc != MPAPI_OK) {
-            printf("DEBUG: Broadcast failed with error %d\n", rc);
-            fflush(stdout);
+            LOG_ERROR("online", "Broadcast failed with error %d", rc);
             ctx->connection_lost = 1;
         }
 
         json_decref(start_cmd);
 
-        printf("DEBUG: Broadcast start_game command with 3000ms countdown\n");
-        fflush(stdout);
+        LOG_DEBUG("online", "Broadcast start_game command with 3000ms countdown");
     }
 
-    printf("DEBUG: online_multiplayer_start_game completed successfully\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "online_multiplayer_start_game completed successfully");
 }
 
 int online_multiplayer_get_local_player_index(OnlineMultiplayerContext *ctx)
@@ -565,14 +581,12 @@ void online_multiplayer_toggle_ready(OnlineMultiplayerContext *ctx)
     int local_idx = ctx->game->local_player_index;
     if (local_idx < 0 || local_idx >= MAX_PLAYERS) return;
 
-    printf("DEBUG: toggle_ready called, local_player_index=%d, is_host=%d\n", local_idx, ctx->game->is_host);
-    fflush(stdout);
+    LOG_DEBUG("online", "toggle_ready called, local_player_index=%d, is_host=%d", local_idx, ctx->game->is_host);
 
     // Toggle ready status
     ctx->game->players[local_idx].ready = !ctx->game->players[local_idx].ready;
 
-    printf("DEBUG: Player %d ready status now: %d\n", local_idx, ctx->game->players[local_idx].ready);
-    fflush(stdout);
+    LOG_DEBUG("online", "Player %d ready status now: %d", local_idx, ctx->game->players[local_idx].ready);
 
     // Spawn/despawn snake based on ready status
     if (ctx->game->players[local_idx].ready) {
@@ -595,7 +609,7 @@ void online_multiplayer_toggle_ready(OnlineMultiplayerContext *ctx)
         ctx->game->players[local_idx].death_state = GAME_RUNNING;
     } else {
         // Despawn snake when unreadying
-        ctx->game->players[local_idx].snake.length = 0;
+        snake_clear(&ctx->game->players[local_idx].snake);
         ctx->game->players[local_idx].alive = 0;
     }
 
@@ -605,7 +619,7 @@ void online_multiplayer_toggle_ready(OnlineMultiplayerContext *ctx)
     json_object_set_new(ready_cmd, "player_index", json_integer(local_idx));
     json_object_set_new(ready_cmd, "ready", json_boolean(ctx->game->players[local_idx].ready));
 
-    int rc = mpapi_game(ctx->api, ready_cmd, NULL);
+    int rc = online_multiplayer_send(ctx->api, ready_cmd);
     if (rc != MPAPI_OK) {
         ctx->connection_lost = 1;
     }
@@ -623,17 +637,16 @@ int online_multiplayer_all_players_ready(OnlineMultiplayerContext *ctx)
     for (int i = 0; i < MAX_PLAYERS; i++) {
         if (ctx->game->players[i].joined) {
             joined_count++;
-            printf("DEBUG: Player %d (%s) joined=1, ready=%d\n",
-                   i, ctx->game->players[i].name, ctx->game->players[i].ready);
+            LOG_DEBUG("online", "Player %d (%s) joined=1, ready=%d",
+                      i, ctx->game->players[i].name, ctx->game->players[i].ready);
             if (ctx->game->players[i].ready) {
                 ready_count++;
             }
         }
     }
 
-    printf("DEBUG: all_players_ready check: joined=%d, ready=%d, result=%d\n",
-           joined_count, ready_count, (joined_count > 0 && joined_count == ready_count));
-    fflush(stdout);
+    LOG_DEBUG("online", "all_players_ready check: joined=%d, ready=%d, result=%d",
+              joined_count, ready_count, (joined_count > 0 && joined_count == ready_count));
 
     // Need at least 1 player, and all joined players must be ready
     return joined_count > 0 && joined_count == ready_count;
@@ -649,21 +662,60 @@ void online_multiplayer_reset_ready_states(OnlineMultiplayerContext *ctx)
         }
     }
 
-    printf("DEBUG: Reset all ready states\n");
-    fflush(stdout);
+    LOG_DEBUG("online", "Reset all ready states");
 }
 
 // Event callback and handlers
 
+// Runs on mpapi's listener thread: only queue the event for the main thread
 static void mpapi_event_callback(const char *event, int64_t messageId,
                                  const char *clientId, json_t *data, void *context)
 {
     (void)messageId; // Unused
     OnlineMultiplayerContext *ctx = (OnlineMultiplayerContext*)context;
-    if (!ctx) return;
+    if (!ctx || !event) return;
+    SDL_AtomicAdd(&messages_received, 1);
+
+    LOG_DEBUG("online", "Received event '%s' from clientId '%s'", event, clientId ? clientId : "NULL");
+
+    OnlineEvent *ev = (OnlineEvent*)calloc(1, sizeof(OnlineEvent));
+    if (!ev) {
+        LOG_ERROR("online", "Out of memory, dropped event '%s'", event);
+        return;
+    }
+    strncpy(ev->event, event, sizeof(ev->event) - 1);
+    if (clientId) {
+        strncpy(ev->client_id, clientId, sizeof(ev->client_id) - 1);
+    }
+    // mpapi keeps its own reference; a deep copy shares nothing with it
+    ev->data = data ? json_deep_copy(data) : NULL;
+    ev->received_ms = (unsigned int)SDL_GetTicks();
+
+    SDL_LockMutex(ctx->inbox_lock);
+    if (ctx->inbox_tail) {
+        ctx->inbox_tail->next = ev;
+    } else {
+        ctx->inbox_head = ev;
+    }
+    ctx->inbox_tail = ev;
+    SDL_UnlockMutex(ctx->inbox_lock);
+}
 
-    printf("DEBUG: Received event '%s' from clientId '%s'\n", event, clientId ? clientId : "NULL");
-    fflush(stdout);
+static void free_events(OnlineEvent *ev)
+{
+    while (ev) {
+        OnlineEvent *next = ev->next;
+        json_decref(ev->data);
+        free(ev);
+        ev = next;
+    }
+}
+
+static void dispatch_event(OnlineMultiplayerContext *ctx, const OnlineEvent *ev)
+{
+    const char *event = ev->event;
+    const char *clientId = ev->client_id;
+    json_t *data = ev->data;
 
     if (strcmp(event, "joined") == 0) {
         handle_player_joined(ctx, clientId, data);
@@ -672,10 +724,11 @@ static void mpapi_event_callback(const char *event, int64_t messageId,
         handle_player_left(ctx, clientId);
     }
     else if (strcmp(event, "game") == 0) {
+        if (!data) return;
         if (ctx->game->is_host) {
-            handle_client_input(ctx, clientId, data);
+            handle_client_input(ctx, clientId, data, ev->received_ms);
         } else {
-            handle_game_state_update(ctx, data);
+            handle_game_state_update(ctx, data, ev->received_ms);
         }
     }
     else if (strcmp(event, "closed") == 0) {
@@ -687,8 +740,7 @@ static void mpapi_event_callback(const char *event, int64_t messageId,
 
 static void handle_player_joined(OnlineMultiplayerContext *ctx, const char *clientId, json_t *data)
 {
-    printf("DEBUG: handle_player_joined called for clientId=%s, is_host=%d\n", clientId, ctx->game->is_host);
-    fflush(stdout);
+    LOG_DEBUG("online", "handle_player_joined called for clientId=%s, is_host=%d", clientId, ctx->game->is_host);
 
     // Don't allow joins after game started
     if (ctx->state != ONLINE_STATE_LOBBY) return;
@@ -696,8 +748,7 @@ static void handle_player_joined(OnlineMultiplayerContext *ctx, const char *clie
     // Check if this player is already in our list
     for (int i = 0; i < MAX_PLAYERS; i++) {
         if (ctx->game->players[i].joined && strcmp(ctx->game->players[i].client_id, clientId) == 0) {
-            printf("DEBUG: Player %s already in slot %d\n", clientId, i);
-            fflush(stdout);
+            LOG_DEBUG("online", "Player %s already in slot %d", clientId, i);
             return; // Already added
         }
     }
@@ -736,7 +787,7 @@ static void handle_player_joined(OnlineMultiplayerContext *ctx, const char *clie
     p->is_local_player = 0;
 
     // Initialize snake (empty until game starts)
-    p->snake.length = 0;
+    snake_clear(&p->snake);
     p->snake.dir = DIR_RIGHT;
     p->death_state = GAME_RUNNING;
 
@@ -748,16 +799,14 @@ static void handle_player_joined(OnlineMultiplayerContext *ctx, const char *clie
     p->fruits_eaten = 0;
     p->lives = INITIAL_LIVES;
     p->wins = 0;
-    p->combo_count = 0;
-    p->combo_expiry_time = 0;
+    multiplayer_game_clear_combo(ctx->game, slot);
     p->combo_best = 0;
     p->food_eaten_this_frame = 0;
     p->ready = 0;
 
     ctx->game->total_joined++;
 
-    printf("DEBUG: Added player %s to slot %d (total_joined=%d)\n", clientId, slot, ctx->game->total_joined);
-    fflush(stdout);
+    LOG_DEBUG("online", "Added player %s to slot %d (total_joined=%d)", clientId, slot, ctx->game->total_joined);
 
     // Broadcast updated lobby state
     online_multiplayer_host_broadcast_state(ctx);
@@ -765,18 +814,17 @@ static void handle_player_joined(OnlineMultiplayerContext *ctx, const char *clie
 
 static void handle_player_left(OnlineMultiplayerContext *ctx, const char *clientId)
 {
-    printf("DEBUG: Player left: %s\n", clientId);
-    fflush(stdout);
+    LOG_DEBUG("online", "Player left: %s", clientId);
 
     // Find player by client_id
     for (int i = 0; i < MAX_PLAYERS; i++) {
         if (ctx->game->players[i].joined &&
             strcmp(ctx->game->players[i].client_id, clientId) == 0) {
 
-            printf("DEBUG: Removing player from slot %d\n", i);
-            fflush(stdout);
+            LOG_DEBUG("online", "Removing player from slot %d", i);
 
-            // Mark as disconnected
+            // Mark as disconnected; a combo timer must not outlive the player
+            multiplayer_game_clear_combo(ctx->game, i);
             ctx->game->players[i].joined = 0;
             ctx->game->players[i].alive = 0;
             ctx->game->total_joined--;
@@ -813,13 +861,12 @@ static void handle_player_left(OnlineMultiplayerContext *ctx, const char *client
 
     // Broadcast updated state to remaining clients (host only)
     if (ctx->game->is_host && (ctx->state == ONLINE_STATE_LOBBY || ctx->state == ONLINE_STATE_PLAYING)) {
-        printf("DEBUG: Broadcasting updated state after player left\n");
-        fflush(stdout);
+        LOG_DEBUG("online", "Broadcasting updated state after player left");
         online_multiplayer_host_broadcast_state(ctx);
     }
 }
 
-static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clientId, json_t *data)
+static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clientId, json_t *data, unsigned int received_ms)
 {
     // Check for commands first
     json_t *command = json_object_get(data, "command");
@@ -828,8 +875,7 @@ static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clien
 
         if (strcmp(cmd, "player_disconnect") == 0) {
             // Handle player disconnect - same as leaved event
-            printf("DEBUG: Received player_disconnect command from %s\n", clientId);
-            fflush(stdout);
+            LOG_DEBUG("online", "Received player_disconnect command from %s", clientId);
             handle_player_left(ctx, clientId);
             return;
         }
@@ -844,8 +890,7 @@ static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clien
 
                 if (player_idx >= 0 && player_idx < MAX_PLAYERS) {
                     ctx->game->players[player_idx].ready = ready;
-                    printf("DEBUG: Host received toggle_ready for player %d, ready=%d\n", player_idx, ready);
-                    fflush(stdout);
+                    LOG_DEBUG("online", "Host received toggle_ready for player %d, ready=%d", player_idx, ready);
 
                     // Spawn/despawn snake based on ready status
                     if (ready) {
@@ -859,13 +904,12 @@ static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clien
                         ctx->game->players[player_idx].alive = 0;
                         ctx->game->players[player_idx].death_state = GAME_RUNNING;
                     } else {
-                        ctx->game->players[player_idx].snake.length = 0;
+                        snake_clear(&ctx->game->players[player_idx].snake);
                         ctx->game->players[player_idx].alive = 0;
                     }
 
                     // Broadcast updated ready status to all clients
-                    printf("DEBUG: Broadcasting updated ready status\n");
-                    fflush(stdout);
+                    LOG_DEBUG("online", "Broadcasting updated ready status");
                     online_multiplayer_host_broadcast_state(ctx);
                 }
             }
@@ -892,8 +936,7 @@ static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clien
             if (lives_json) {
                 int client_lives = (int)json_integer_value(lives_json);
                 ctx->game->players[player_idx].lives = client_lives;
-                printf("DEBUG: Client %d died, lives now: %d\n", player_idx, client_lives);
-                fflush(stdout);
+                LOG_DEBUG("online", "Client %d died, lives now: %d", player_idx, client_lives);
             }
 
             // CRITICAL: Update death_state immediately to prevent food eating during death animation
@@ -903,7 +946,7 @@ static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clien
             json_t *broadcast = json_object();
             json_object_set_new(broadcast, "command", json_string("player_died"));
             json_object_set_new(broadcast, "player_index", json_integer(player_idx));
-            mpapi_game(ctx->api, broadcast, NULL);
+            online_multiplayer_send(ctx->api, broadcast);
             json_decref(broadcast);
         }
         return;
@@ -923,13 +966,8 @@ static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clien
 
             // Remove the food that was eaten and generate new food
             if (vec2_equal(ctx->game->board.food, food_pos)) {
-                // Regenerate main food using first joined player's snake
-                for (int i = 0; i < MAX_PLAYERS; i++) {
-                    if (ctx->game->players[i].joined) {
-                        board_place_food(&ctx->game->board, &ctx->game->players[i].snake);
-                        break;
-                    }
-                }
+                // Regenerate main food clear of every snake
+                board_place_food(&ctx->game->board, &ctx->game->rng);
             } else {
                 // Check additional food items
                 for (int f = 0; f < ctx->game->food_count; f++) {
@@ -970,10 +1008,9 @@ static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clien
                 json_object_set_new(broadcast, "spawn_x", json_integer(json_integer_value(spawn_x)));
                 json_object_set_new(broadcast, "spawn_y", json_integer(json_integer_value(spawn_y)));
             }
-            mpapi_game(ctx->api, broadcast, NULL);
+            online_multiplayer_send(ctx->api, broadcast);
             json_decref(broadcast);
-            printf("DEBUG: Client %d respawned, broadcasting to other clients\n", player_idx);
-            fflush(stdout);
+            LOG_DEBUG("online", "Client %d respawned, broadcasting to other clients", player_idx);
         }
         return;
     }
@@ -998,7 +1035,7 @@ static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clien
             json_object_set_new(broadcast, "command", json_string("food_added"));
             json_object_set_new(broadcast, "food_x", json_integer(food_pos.x));
             json_object_set_new(broadcast, "food_y", json_integer(food_pos.y));
-            mpapi_game(ctx->api, broadcast, NULL);
+            online_multiplayer_send(ctx->api, broadcast);
             json_decref(broadcast);
         }
         return;
@@ -1030,9 +1067,8 @@ static void handle_client_input(OnlineMultiplayerContext *ctx, const char *clien
 
         // Validate player is alive
         if (ctx->game->players[player_idx].alive) {
-            // Add to player's input buffer
-            Direction current_dir = ctx->game->players[player_idx].snake.dir;
-            input_buffer_push(&ctx->game->players[player_idx].input, dir, current_dir);
+            // Add to player's input buffer (the host's tick consumes it)
+            input_buffer_push(&ctx->game->players[player_idx].input, dir, received_ms);
         }
     }
 
@@ -1049,15 +1085,17 @@ skip_input:
     // Apply position update from client (accept in all states for smooth rendering)
     if (segments && json_is_array(segments)) {
         size_t arr_len = json_array_size(segments);
-        player->snake.length = 0;
-
-        // Directly apply client's position
-        for (size_t i = 0; i + 1 < arr_len && player->snake.length < MAX_SNAKE_LEN; i += 2) {
-            player->snake.segments[player->snake.length].x =
-                (int)json_integer_value(json_array_get(segments, i));
-            player->snake.segments[player->snake.length].y =
-                (int)json_integer_value(json_array_get(segments, i + 1));
-            player->snake.length++;
+        snake_clear(&player->snake);
+
+        // Directly apply client's position (a snake can't outgrow the board)
+        int max_segments = ctx->game->board.width * ctx->game->board.height;
+        for (size_t i = 0; i + 1 < arr_len && player->snake.length < max_segments; i += 2) {
+            Vec2 seg = {
+                (int)json_integer_value(json_array_get(segments, i)),
+                (int)json_integer_value(json_array_get(segments, i + 1))
+            };
+            if (!snake_push_tail(&player->snake, seg))
+                break;
         }
     }
 
@@ -1079,7 +1117,7 @@ skip_input:
     }
 }
 
-static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data)
+static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data, unsigned int received_ms)
 {
     // Check for commands first
     json_t *command = json_object_get(data, "command");
@@ -1088,13 +1126,11 @@ static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data
         if (strcmp(cmd, "player_disconnect") == 0) {
             // Player disconnect is handled via leaved event or host broadcast
             // Just ignore this message on client side
-            printf("DEBUG: Client ignoring player_disconnect command (handled via state update)\n");
-            fflush(stdout);
+            LOG_DEBUG("online", "Client ignoring player_disconnect command (handled via state update)");
             return;
         }
         else if (strcmp(cmd, "start_game") == 0) {
-            printf("DEBUG: Received start_game command, transitioning to COUNTDOWN\n");
-            fflush(stdout);
+            LOG_DEBUG("online", "Received start_game command, transitioning to COUNTDOWN");
 
             // Read relative countdown delay from host
             json_t *countdown_json = json_object_get(data, "countdown_ms");
@@ -1103,12 +1139,17 @@ static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data
                 countdown_ms = (unsigned int)json_integer_value(countdown_json);
             }
 
-            // Calculate our own absolute timestamp based on OUR clock
-            unsigned int current_time = (unsigned int)SDL_GetTicks();
-            ctx->game_start_timestamp = current_time + countdown_ms;
-            printf("DEBUG: Client calculated game_start_timestamp: %u (current: %u, countdown: %u)\n",
-                   ctx->game_start_timestamp, current_time, countdown_ms);
-            fflush(stdout);
+            // Calculate our own absolute timestamp based on OUR clock,
+            // from when the command arrived rather than when it is applied
+            ctx->game_start_timestamp = received_ms + countdown_ms;
+            LOG_DEBUG("online", "Client calculated game_start_timestamp: %u (received: %u, countdown: %u)",
+                      ctx->game_start_timestamp, received_ms, countdown_ms);
+
+            // Host's round seed (older hosts send none: keep ours)
+            json_t *seed_json = json_object_get(data, "seed");
+            if (seed_json && json_is_integer(seed_json)) {
+                seed_round(ctx->game, (uint64_t)json_integer_value(seed_json));
+            }
 
             ctx->state = ONLINE_STATE_COUNTDOWN;
             multiplayer_game_start(ctx->game);
@@ -1119,8 +1160,7 @@ static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data
                     ctx->game->players[i].lives = INITIAL_LIVES;
                     ctx->game->players[i].score = 0;
                     ctx->game->players[i].fruits_eaten = 0;
-                    ctx->game->players[i].combo_count = 0;
-                    ctx->game->players[i].combo_expiry_time = 0;
+                    multiplayer_game_clear_combo(ctx->game, i);
                     ctx->game->players[i].combo_best = 0;
                 }
             }
@@ -1128,8 +1168,7 @@ static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data
             return; // Don't deserialize, this is just a command
         }
         else if (strcmp(cmd, "game_over") == 0) {
-            printf("DEBUG: Received game_over command, transitioning to GAME_OVER\n");
-            fflush(stdout);
+            LOG_DEBUG("online", "Received game_over command, transitioning to GAME_OVER");
             ctx->state = ONLINE_STATE_GAME_OVER;
             return; // Don't deserialize, this is just a command
         }
@@ -1147,8 +1186,7 @@ static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data
                 if (player_idx >= 0 && player_idx < MAX_PLAYERS &&
                     player_idx != ctx->game->local_player_index) {
                     ctx->game->players[player_idx].ready = ready;
-                    printf("DEBUG: Received toggle_ready for player %d (not us), ready=%d\n", player_idx, ready);
-                    fflush(stdout);
+                    LOG_DEBUG("online", "Received toggle_ready for player %d (not us), ready=%d", player_idx, ready);
 
                     // Spawn/despawn snake based on ready status
                     if (ready) {
@@ -1162,7 +1200,7 @@ static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data
                         ctx->game->players[player_idx].alive = 0;
                         ctx->game->players[player_idx].death_state = GAME_RUNNING;
                     } else {
-                        ctx->game->players[player_idx].snake.length = 0;
+                        snake_clear(&ctx->game->players[player_idx].snake);
                         ctx->game->players[player_idx].alive = 0;
                     }
                 }
@@ -1186,7 +1224,9 @@ static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data
     }
 
     // Deserialize and update local game state
+    uint64_t trace_t = trace_begin();
     online_multiplayer_deserialize_state(ctx->game, data);
+    trace_end("deserialize_state", trace_t);
 
     // Clear pending input if snake has turned to match it
     if (ctx->has_pending_input && ctx->game->local_player_index >= 0) {
@@ -1203,8 +1243,7 @@ static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data
                 strcmp(ctx->game->players[i].client_id, ctx->our_client_id) == 0) {
                 ctx->game->local_player_index = i;
                 ctx->game->players[i].is_local_player = 1;
-                printf("DEBUG: Found local player at index %d via client_id match\n", i);
-                fflush(stdout);
+                LOG_DEBUG("online", "Found local player at index %d via client_id match", i);
                 break;
             }
         }
@@ -1213,6 +1252,14 @@ static void handle_game_state_update(OnlineMultiplayerContext *ctx, json_t *data
 
 // Helper functions
 
+// Restart the match's randomness; the logged seed replays the round with --seed
+static void seed_round(MultiplayerGame_s *game, uint64_t seed)
+{
+    game->seed = seed;
+    rng_seed(&game->rng, seed);
+    LOG_INFO("online", "Round seed: %llu", (unsigned long long)seed);
+}
+
 static void respawn_player(MultiplayerGame_s *game, int player_idx)
 {
     MultiplayerPlayer *p = &game->players[player_idx];
@@ -1233,32 +1280,30 @@ static void respawn_player(MultiplayerGame_s *game, int player_idx)
 
 static Vec2 find_safe_spawn_position(MultiplayerGame_s *game)
 {
-    // Try random positions until one is safe
+    const OccupancyGrid *grid = &game->board.occupancy;
+
+    // Draw random free cells until one has a clear 3x3 area around it
     int max_attempts = 100;
     for (int attempt = 0; attempt < max_attempts; attempt++) {
+        Vec2 candidate;
+        if (!board_random_free_cell(&game->board, &game->rng, &candidate)) break;
+
         // Spawn at least 3 cells away from edges to avoid immediate wall collision
         int margin = 3;
-        Vec2 candidate = {
-            margin + (rand() % (game->board.width - 2 * margin)),
-            margin + (rand() % (game->board.height - 2 * margin))
-        };
-
-        // Check if position and surrounding area are safe
-        int safe = 1;
+        if (candidate.x < margin || candidate.x >= game->board.width - margin ||
+            candidate.y < margin || candidate.y >= game->board.height - margin) {
+            continue;
+        }
 
         // Check 3x3 area around spawn point to ensure some clearance
+        int safe = 1;
         for (int dx = -1; dx <= 1 && safe; dx++) {
             for (int dy = -1; dy <= 1 && safe; dy++) {
                 Vec2 check = {candidate.x + dx, candidate.y + dy};
 
-                // Check if any snake occupies this position
-                for (int i = 0; i < MAX_PLAYERS; i++) {
-                    // Check any snake with segments (including dying snakes)
-                    if (game->players[i].snake.length > 0 &&
-                        snake_occupies(&game->players[i].snake, check)) {
-                        safe = 0;
-                        break;
-                    }
+                // Any snake with segments (including dying snakes) takes the cell
+                if (!occupancy_is_free(grid, check)) {
+                    safe = 0;
                 }
 
                 // Also avoid food positions in the area
@@ -1271,23 +1316,28 @@ static Vec2 find_safe_spawn_position(MultiplayerGame_s *game)
         if (safe) return candidate;
     }
 
-    // Fallback: center of board
-    Vec2 fallback = {game->board.width / 2, game->board.height / 2};
+    // Fallback: any free cell, then the center of the board
+    Vec2 fallback;
+    if (!board_random_free_cell(&game->board, &game->rng, &fallback)) {
+        fallback.x = game->board.width / 2;
+        fallback.y = game->board.height / 2;
+    }
     return fallback;
 }
 
-static void update_player_combo_timer(MultiplayerPlayer *p, unsigned int current_time, unsigned int combo_window_ms)
+int online_multiplayer_send(mpapi *api, json_t *msg)
 {
-    // If combo expiry time was just set to placeholder, update it
-    if (p->combo_expiry_time == 1) {
-        p->combo_expiry_time = current_time + combo_window_ms;
-    }
+    uint64_t trace_t = trace_begin();
+    int rc = mpapi_game(api, msg, NULL);
+    trace_end("mpapi_game", trace_t);
+    SDL_AtomicAdd(&messages_sent, 1);
+    return rc;
+}
 
-    // Check expiration
-    if (p->combo_count > 0 && current_time >= p->combo_expiry_time) {
-        p->combo_count = 0;
-        p->combo_expiry_time = 0;
-    }
+void online_multiplayer_traffic(unsigned int *sent, unsigned int *received)
+{
+    *sent = (unsigned int)SDL_AtomicGet(&messages_sent);
+    *received = (unsigned int)SDL_AtomicGet(&messages_received);
 }
 
 // JSON serialization
@@ -1348,8 +1398,9 @@ static json_t* serialize_player(MultiplayerPlayer *player)
     // Snake segments - COMPACT FORMAT: flat array [x1,y1,x2,y2,...]
     json_t *segments = json_array();
     for (int i = 0; i < player->snake.length; i++) {
-        json_array_append_new(segments, json_integer(player->snake.segments[i].x));
-        json_array_append_new(segments, json_integer(player->snake.segments[i].y));
+        Vec2 seg = snake_segment(&player->snake, i);
+        json_array_append_new(segments, json_integer(seg.x));
+        json_array_append_new(segments, json_integer(seg.y));
     }
     json_object_set_new(p, "segments", segments);
 
@@ -1396,14 +1447,15 @@ void online_multiplayer_deserialize_state(MultiplayerGame_s *game, json_t *data)
         game->active_players = 0;
         game->total_joined = 0;
         for (int i = 0; i < MAX_PLAYERS && i < (int)json_array_size(players); i++) {
-            deserialize_player(&game->players[i], json_array_get(players, i));
+            deserialize_player(&game->players[i], json_array_get(players, i),
+                               game->board.width * game->board.height);
             if (game->players[i].joined) game->total_joined++;
             if (game->players[i].alive) game->active_players++;
         }
     }
 }
 
-static void deserialize_player(MultiplayerPlayer *player, json_t *data)
+static void deserialize_player(MultiplayerPlayer *player, json_t *data, int max_segments)
 {
     // Preserve is_local_player flag - should not be overwritten by network data
     int was_local = player->is_local_player;
@@ -1450,15 +1502,16 @@ static void deserialize_player(MultiplayerPlayer *player, json_t *data)
         json_t *segments = json_object_get(data, "segments");
         if (json_is_array(segments)) {
             size_t arr_len = json_array_size(segments);
-            player->snake.length = 0;
-
-            // Directly apply position from network
-            for (size_t i = 0; i + 1 < arr_len && player->snake.length < MAX_SNAKE_LEN; i += 2) {
-                player->snake.segments[player->snake.length].x =
-                    (int)json_integer_value(json_array_get(segments, i));
-                player->snake.segments[player->snake.length].y =
-                    (int)json_integer_value(json_array_get(segments, i + 1));
-                player->snake.length++;
+            snake_clear(&player->snake);
+
+            // Directly apply position from network (a snake can't outgrow the board)
+            for (size_t i = 0; i + 1 < arr_len && player->snake.length < max_segments; i += 2) {
+                Vec2 seg = {
+                    (int)json_integer_value(json_array_get(segments, i)),
+                    (int)json_integer_value(json_array_get(segments, i + 1))
+                };
+                if (!snake_push_tail(&player->snake, seg))
+                    break;
             }
         }
 
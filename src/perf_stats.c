@@ -0,0 +1,72 @@
+#include "perf_stats.h"
+#include <string.h>
+
+void perf_stats_init(PerfStats *p) {
+    memset(p, 0, sizeof(*p));
+}
+
+void perf_series_add(PerfSeries *s, float ms) {
+    s->samples[s->count % PERF_HISTORY] = ms;
+    s->count++;
+}
+
+unsigned int perf_series_size(const PerfSeries *s) {
+    return s->count < PERF_HISTORY ? s->count : PERF_HISTORY;
+}
+
+float perf_series_at(const PerfSeries *s, unsigned int i) {
+    return s->samples[(s->count - 1 - i) % PERF_HISTORY];
+}
+
+float perf_series_last(const PerfSeries *s) {
+    return s->count ? perf_series_at(s, 0) : 0.0f;
+}
+
+void perf_series_summary(const PerfSeries *s, float *avg, float *max) {
+    unsigned int n = perf_series_size(s);
+    float total = 0.0f;
+    float top = 0.0f;
+    for (unsigned int i = 0; i < n; i++) {
+        total += s->samples[i];
+        if (s->samples[i] > top) {
+            top = s->samples[i];
+        }
+    }
+    *avg = n ? total / (float)n : 0.0f;
+    *max = top;
+}
+
+void perf_stats_tick(PerfStats *p, uint64_t tick, float late_ms) {
+    if (tick != p->tick_seen) {
+        p->tick_seen = tick;
+        perf_series_add(&p->series[PERF_TICK_JITTER], late_ms);
+    }
+}
+
+void perf_stats_audio(PerfStats *p, unsigned int calls, unsigned int time_us) {
+    if (calls != p->audio_seen) {
+        p->audio_seen = calls;
+        perf_series_add(&p->series[PERF_AUDIO], (float)time_us / 1000.0f);
+    }
+}
+
+void perf_stats_net(PerfStats *p, unsigned int now_ms, unsigned int sent_total, unsigned int received_total) {
+    unsigned int elapsed = now_ms - p->rate_window_ms;
+    if (p->rate_window_ms == 0 || sent_total < p->rate_sent || received_total < p->rate_received) {
+        // First call, or the counters were reset: start a fresh window
+        p->rate_window_ms = now_ms;
+        p->rate_sent = sent_total;
+        p->rate_received = received_total;
+        return;
+    }
+    if (elapsed < PERF_RATE_WINDOW_MS) {
+        return;
+    }
+
+    float seconds = (float)elapsed / 1000.0f;
+    p->sent_per_s = (float)(sent_total - p->rate_sent) / seconds;
+    p->received_per_s = (float)(received_total - p->rate_received) / seconds;
+    p->rate_window_ms = now_ms;
+    p->rate_sent = sent_total;
+    p->rate_received = received_total;
+}
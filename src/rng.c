@@ -0,0 +1,56 @@
+#include "rng.h"
+#include <stdatomic.h>
+#include <time.h>
+
+#define PCG_MULTIPLIER 6364136223846793005ULL
+#define PCG_STREAM 1442695040888963407ULL
+
+// SplitMix64 finalizer: spreads nearby seeds (e.g. timestamps) apart
+static uint64_t mix64(uint64_t x) {
+    x += 0x9e3779b97f4a7c15ULL;
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+}
+
+void rng_seed(Rng *r, uint64_t seed) {
+    r->state = 0;
+    r->inc = PCG_STREAM | 1u;
+    rng_next(r);
+    r->state += mix64(seed);
+    rng_next(r);
+}
+
+uint32_t rng_next(Rng *r) {
+    uint64_t old = r->state;
+    r->state = old * PCG_MULTIPLIER + r->inc;
+
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31u));
+}
+
+int rng_below(Rng *r, int bound) {
+    if (bound <= 0) {
+        return 0;
+    }
+
+    // Reject the few low values that would make x % bound uneven
+    uint32_t b = (uint32_t)bound;
+    uint32_t threshold = (uint32_t)(-b) % b;
+    for (;;) {
+        uint32_t x = rng_next(r);
+        if (x >= threshold) {
+            return (int)(x % b);
+        }
+    }
+}
+
+uint64_t rng_entropy_seed(void) {
+    // Shared by every thread that starts a game
+    static atomic_ullong counter = 0;
+    uint64_t n = (uint64_t)atomic_fetch_add_explicit(&counter, 1, memory_order_relaxed) + 1;
+    uint64_t t = (uint64_t)time(NULL);
+    uint64_t c = (uint64_t)clock();
+    return mix64(t ^ (c << 32) ^ mix64(n));
+}
@@ -0,0 +1,129 @@
+#include "segment_pool.h"
+#include <stdlib.h>
+#include <string.h>
+
+struct SegmentChunk {
+    SegmentChunk *next;
+    int capacity;   // Segments in data[]
+    int used;       // Segments already carved off
+    Vec2 data[];
+};
+
+static void pool_lock(SegmentPool *pool) {
+    while (atomic_flag_test_and_set_explicit(&pool->lock, memory_order_acquire)) {
+        // Spin - critical sections are a handful of pointer updates
+    }
+}
+
+static void pool_unlock(SegmentPool *pool) {
+    atomic_flag_clear_explicit(&pool->lock, memory_order_release);
+}
+
+static int size_class(int capacity) {
+    int cls = 0;
+    while ((SEGMENT_POOL_MIN_BLOCK << cls) < capacity) {
+        cls++;
+    }
+    return cls;
+}
+
+static SegmentChunk *chunk_create(int capacity) {
+    SegmentChunk *chunk = malloc(sizeof(SegmentChunk) + (size_t)capacity * sizeof(Vec2));
+    if (!chunk) return NULL;
+
+    chunk->next = NULL;
+    chunk->capacity = capacity;
+    chunk->used = 0;
+    return chunk;
+}
+
+void segment_pool_init(SegmentPool *pool) {
+    pool->chunks = NULL;
+    for (int i = 0; i < SEGMENT_POOL_CLASSES; ++i) {
+        pool->free_blocks[i] = NULL;
+    }
+    atomic_flag_clear(&pool->lock);
+}
+
+void segment_pool_destroy(SegmentPool *pool) {
+    SegmentChunk *chunk = pool->chunks;
+    while (chunk) {
+        SegmentChunk *next = chunk->next;
+        free(chunk);
+        chunk = next;
+    }
+    segment_pool_init(pool);
+}
+
+int segment_pool_block_capacity(int segments) {
+    int capacity = SEGMENT_POOL_MIN_BLOCK;
+    for (int cls = 0; cls < SEGMENT_POOL_CLASSES; ++cls) {
+        if (capacity >= segments) {
+            return capacity;
+        }
+        capacity <<= 1;
+    }
+    return 0;
+}
+
+Vec2 *segment_pool_alloc(SegmentPool *pool, int capacity) {
+    int cls = size_class(capacity);
+    if (cls >= SEGMENT_POOL_CLASSES) return NULL;
+
+    pool_lock(pool);
+
+    // Reuse a released block of the same size class
+    Vec2 *block = pool->free_blocks[cls];
+    if (block) {
+        memcpy(&pool->free_blocks[cls], block, sizeof(Vec2 *));
+        pool_unlock(pool);
+        return block;
+    }
+
+    if (capacity > SEGMENT_POOL_CHUNK_SEGMENTS / 2) {
+        // Large blocks get a dedicated chunk, linked behind the bump chunk
+        SegmentChunk *chunk = chunk_create(capacity);
+        if (chunk) {
+            chunk->used = capacity;
+            if (pool->chunks) {
+                chunk->next = pool->chunks->next;
+                pool->chunks->next = chunk;
+            } else {
+                pool->chunks = chunk;
+            }
+            block = chunk->data;
+        }
+        pool_unlock(pool);
+        return block;
+    }
+
+    SegmentChunk *bump = pool->chunks;
+    if (!bump || bump->capacity - bump->used < capacity) {
+        bump = chunk_create(SEGMENT_POOL_CHUNK_SEGMENTS);
+        if (!bump) {
+            pool_unlock(pool);
+            return NULL;
+        }
+        bump->next = pool->chunks;
+        pool->chunks = bump;
+    }
+
+    block = bump->data + bump->used;
+    bump->used += capacity;
+
+    pool_unlock(pool);
+    return block;
+}
+
+void segment_pool_release(SegmentPool *pool, Vec2 *block, int capacity) {
+    if (!block) return;
+
+    int cls = size_class(capacity);
+    if (cls >= SEGMENT_POOL_CLASSES) return;
+
+    pool_lock(pool);
+    // Free list link is stored in the first bytes of the released block
+    memcpy(block, &pool->free_blocks[cls], sizeof(Vec2 *));
+    pool->free_blocks[cls] = block;
+    pool_unlock(pool);
+}
@@ -0,0 +1,97 @@
+#include "sim.h"
+#include <stdlib.h>
+
+static Vec2 sim_step_pos(Vec2 pos, Direction dir) {
+    switch (dir) {
+        case DIR_UP:    pos.y--; break;
+        case DIR_DOWN:  pos.y++; break;
+        case DIR_LEFT:  pos.x--; break;
+        case DIR_RIGHT: pos.x++; break;
+    }
+    return pos;
+}
+
+Direction sim_greedy_policy(const Game *g, void *user) {
+    static const Direction dirs[4] = {DIR_UP, DIR_DOWN, DIR_LEFT, DIR_RIGHT};
+    (void)user;
+
+    Vec2 head = snake_head(&g->snake);
+    Vec2 food = g->board.food;
+
+    Direction best = g->snake.dir;
+    int best_score = -1000000;
+    for (int i = 0; i < 4; i++) {
+        Vec2 next = sim_step_pos(head, dirs[i]);
+        int grow = vec2_equal(next, food);
+        // Same collision queries game_update uses
+        int blocked = board_out_of_bounds(&g->board, next) ||
+                      (grow ? snake_occupies(&g->snake, next)
+                            : snake_occupies_excluding_tail(&g->snake, next));
+
+        int dist = abs(next.x - food.x) + abs(next.y - food.y);
+        int score = (blocked ? -100000 : 0) - dist;
+        if (score > best_score) {
+            best_score = score;
+            best = dirs[i];
+        }
+    }
+    return best;
+}
+
+void sim_start(Game *g, const GameConfig *cfg, uint64_t seed, SimClock *clock) {
+    game_free(g);
+    game_init(g, cfg->sp_board_width, cfg->sp_board_height, seed);
+    g->combo_window_ms = cfg->tick_ms * cfg->combo_window_ticks;
+
+    clock->now = 0;
+    clock->tick_ms = cfg->tick_ms;
+}
+
+void sim_tick(Game *g, const GameConfig *cfg, SimClock *clock) {
+    unsigned int next_tick = clock->now + (unsigned int)clock->tick_ms;
+
+    // A combo running out before the next tick drops the speed back
+    // to the start, which moves the next tick (main.c checks per frame)
+    if (g->combo_count > 0 && g->combo_expiry_time <= next_tick) {
+        unsigned int expiry = g->combo_expiry_time;
+        game_update_timers(g, expiry);
+        clock->tick_ms = game_tick_ms_for_combo(cfg, 0);
+        next_tick = clock->now + (unsigned int)clock->tick_ms;
+        if (next_tick < expiry) {
+            next_tick = expiry;
+        }
+    }
+
+    clock->now = next_tick;
+    game_update(g);
+
+    if (g->food_eaten_this_frame) {
+        clock->tick_ms = game_tick_ms_for_combo(cfg, g->combo_count);
+        g->combo_window_ms = (int)game_combo_window_ms(cfg, clock->tick_ms, g->combo_count);
+        game_start_combo_timer(g, clock->now);
+    }
+}
+
+void sim_play_game(Game *g, const GameConfig *cfg, uint64_t seed, int max_ticks,
+                   SimPolicy policy, void *user, SimResult *out) {
+    SimClock clock;
+    sim_start(g, cfg, seed, &clock);
+
+    int ticks = 0;
+    while (g->state == GAME_RUNNING && ticks < max_ticks) {
+        game_change_direction(g, policy(g, user));
+        sim_tick(g, cfg, &clock);
+        ticks++;
+    }
+
+    out->score = g->score;
+    out->fruits_eaten = g->fruits_eaten;
+    out->combo_best = g->combo_best;
+    out->ticks = ticks;
+    out->duration_ms = clock.now;
+    out->won = g->won;
+
+    while (game_update_death_animation(g)) {
+        // Finish the death animation so the game ends in GAME_OVER
+    }
+}
@@ -9,6 +9,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <stdio.h>
+#include "trace.h"
 
 #define MAX_SOUNDS 50
 #define AUDIO_FORMAT AUDIO_S16LSB
@@ -32,6 +33,8 @@ typedef struct
     SDL_AudioSpec spec;
     Sound sounds[MAX_SOUNDS];
     int initialized;
+    SDL_atomic_t mix_time_us;   // Duration of the last callback (performance HUD)
+    SDL_atomic_t mix_calls;     // Callbacks run so far
 } SimpleAudio;
 
 static SimpleAudio g_audio = {0};
@@ -40,6 +43,9 @@ static SimpleAudio g_audio = {0};
 static void audio_callback(void *userdata, Uint8 *stream, int len)
 {
     (void)userdata;
+    trace_thread_name("audio");
+    uint64_t trace_t = trace_begin();
+    Uint64 mix_start = SDL_GetPerformanceCounter();
 
     SDL_memset(stream, 0, len);
 
@@ -86,6 +92,10 @@ static void audio_callback(void *userdata, Uint8 *stream, int len)
             }
         }
     }
+    trace_end("audio_callback", trace_t);
+    SDL_AtomicSet(&g_audio.mix_time_us,
+                  (int)((SDL_GetPerformanceCounter() - mix_start) * 1000000 / SDL_GetPerformanceFrequency()));
+    SDL_AtomicAdd(&g_audio.mix_calls, 1);
 }
 
 
@@ -371,4 +381,10 @@ void simple_audio_resume(int sound_id)
     }
 
     SDL_UnlockAudioDevice(g_audio.device);
-}
\ No newline at end of file
+}
+
+unsigned int simple_audio_mix_time_us(unsigned int *calls)
+{
+    *calls = (unsigned int)SDL_AtomicGet(&g_audio.mix_calls);
+    return (unsigned int)SDL_AtomicGet(&g_audio.mix_time_us);
+}
@@ -1,32 +1,151 @@
 #include "snake.h"
+#include <string.h>
+
+// Resize storage to `capacity` segments, unwrapping the ring so the head
+// lands at index 0. Returns 1 on success, 0 if the pool is exhausted.
+static int snake_set_capacity(Snake *s, int capacity) {
+    Vec2 *block = segment_pool_alloc(s->pool, capacity);
+    if (!block) {
+        return 0;
+    }
+
+    int keep = s->length < capacity ? s->length : capacity;
+    if (keep > 0) {
+        int first = s->capacity - s->head;  // Segments before the ring wraps
+        if (first >= keep) {
+            memcpy(block, s->segments + s->head, (size_t)keep * sizeof(Vec2));
+        } else {
+            memcpy(block, s->segments + s->head, (size_t)first * sizeof(Vec2));
+            memcpy(block + first, s->segments, (size_t)(keep - first) * sizeof(Vec2));
+        }
+    }
+
+    segment_pool_release(s->pool, s->segments, s->capacity);
+    s->segments = block;
+    s->capacity = capacity;
+    s->head = 0;
+    s->length = keep;
+    return 1;
+}
+
+static void snake_mark(Snake *s, Vec2 pos, unsigned int age) {
+    if (s->grid) {
+        occupancy_mark(s->grid, s->owner, pos, age);
+    }
+}
+
+static void snake_unmark(Snake *s, Vec2 pos, unsigned int age) {
+    if (s->grid) {
+        occupancy_unmark(s->grid, s->owner, pos, age);
+    }
+}
+
+static int snake_reserve(Snake *s, int needed) {
+    if (needed <= s->capacity) {
+        return 1;
+    }
+
+    int capacity = segment_pool_block_capacity(needed);
+    if (capacity == 0) {
+        return 0;
+    }
+    return snake_set_capacity(s, capacity);
+}
+
+void snake_storage_init(Snake *s, SegmentPool *pool, OccupancyGrid *grid, int owner) {
+    s->segments = NULL;
+    s->capacity = 0;
+    s->head = 0;
+    s->length = 0;
+    s->dir = DIR_RIGHT;
+    s->pool = pool;
+    s->grid = grid;
+    s->owner = owner;
+    s->age = SNAKE_AGE_BASE;
+    s->prev_tail.x = 0;
+    s->prev_tail.y = 0;
+    s->moved = 0;
+}
+
+void snake_storage_free(Snake *s) {
+    snake_clear(s);
+    segment_pool_release(s->pool, s->segments, s->capacity);
+    s->segments = NULL;
+    s->capacity = 0;
+    s->head = 0;
+    s->length = 0;
+}
 
 void snake_init(Snake *s, Vec2 start, Direction dir) {
-    s->length = 2;
-    s->dir = dir;
-    s->segments[0] = start;
+    Vec2 body = start;
 
     switch (dir) {
         case DIR_UP:
-            s->segments[1].x = start.x;
-            s->segments[1].y = start.y + 1;
+            body.y = start.y + 1;
             break;
         case DIR_DOWN:
-            s->segments[1].x = start.x;
-            s->segments[1].y = start.y - 1;
+            body.y = start.y - 1;
             break;
         case DIR_LEFT:
-            s->segments[1].x = start.x + 1;
-            s->segments[1].y = start.y;
+            body.x = start.x + 1;
             break;
         case DIR_RIGHT:
-            s->segments[1].x = start.x - 1;
-            s->segments[1].y = start.y;
+            body.x = start.x - 1;
             break;
     }
+
+    s->dir = dir;
+    snake_clear(s);
+
+    // Memory tracks length: drop storage grown during a previous life
+    if (s->capacity != SNAKE_MIN_CAPACITY) {
+        snake_set_capacity(s, SNAKE_MIN_CAPACITY);
+    }
+    if (s->capacity < 2) {
+        return;
+    }
+
+    s->length = 2;
+    s->segments[0] = start;
+    s->segments[1] = body;
+    snake_mark(s, start, s->age);
+    snake_mark(s, body, s->age - 1);
+}
+
+void snake_clear(Snake *s) {
+    if (s->grid) {
+        for (int i = 0; i < s->length; ++i) {
+            snake_unmark(s, snake_segment(s, i), s->age - (unsigned int)i);
+        }
+    }
+    s->head = 0;
+    s->length = 0;
+    s->age = SNAKE_AGE_BASE;
+    s->moved = 0;
+}
+
+int snake_push_tail(Snake *s, Vec2 pos) {
+    if (!snake_reserve(s, s->length + 1)) {
+        return 0;
+    }
+
+    s->segments[(s->head + s->length) & (s->capacity - 1)] = pos;
+    snake_mark(s, pos, s->age - (unsigned int)s->length);
+    s->length++;
+    s->moved = 0;
+    return 1;
 }
 
 Vec2 snake_head(const Snake *s) {
-    return s->segments[0];
+    if (!s->segments) {
+        Vec2 none = {0, 0};
+        return none;
+    }
+    return s->segments[s->head];
+}
+
+Vec2 snake_tail(const Snake *s) {
+    return snake_segment(s, s->length - 1);
 }
 
 void snake_change_direction(Snake *s, Direction newDir) {
@@ -41,28 +160,47 @@ void snake_change_direction(Snake *s, Direction newDir) {
 }
 
 void snake_step_to(Snake *s, Vec2 newHead, int grow) {
-    int newLength = s->length;
-    if (grow && s->length < MAX_SNAKE_LEN) {
-        newLength = s->length + 1;
+    int needed = grow ? s->length + 1 : (s->length > 0 ? s->length : 1);
+    if (!snake_reserve(s, needed)) {
+        // Out of memory: keep moving at the current length if we can
+        if (s->capacity == 0) return;
+        grow = 0;
     }
 
-    // Move segments from back to front
-    for (int i = newLength - 1; i > 0; --i) {
-        if (i < s->length) {
-            s->segments[i] = s->segments[i - 1];
-        } else {
-            // New segment is copied from the old tail
-            s->segments[i] = s->segments[s->length - 1];
-        }
+    int drop_tail = !grow && s->length > 0;
+    Vec2 tail = drop_tail ? snake_tail(s) : newHead;
+    unsigned int tail_age = s->age - (unsigned int)(s->length - 1);
+
+    // Step the head index back one slot. When not growing that slot is
+    // either free or holds the old tail, which is dropped.
+    s->head = (s->head - 1) & (s->capacity - 1);
+    s->segments[s->head] = newHead;
+    s->age++;
+
+    if (grow) {
+        s->length++;
+    }
+
+    // Mark the head before unmarking the tail: if the head moved onto the
+    // cell the tail just left, the newer head age survives the unmark
+    if (s->length > 0) {
+        snake_mark(s, newHead, s->age);
+    }
+    if (drop_tail) {
+        snake_unmark(s, tail, tail_age);
     }
 
-    s->segments[0] = newHead;
-    s->length = newLength;
+    s->prev_tail = drop_tail ? tail : snake_tail(s);
+    s->moved = 1;
 }
 
 int snake_occupies(const Snake *s, Vec2 pos) {
+    if (s->grid) {
+        return occupancy_age(s->grid, s->owner, pos) != 0;
+    }
+
     for (int i = 0; i < s->length; ++i) {
-        if (s->segments[i].x == pos.x && s->segments[i].y == pos.y) {
+        if (vec2_equal(snake_segment(s, i), pos)) {
             return 1;
         }
     }
@@ -72,8 +210,15 @@ int snake_occupies(const Snake *s, Vec2 pos) {
 int snake_occupies_excluding_tail(const Snake *s, Vec2 pos) {
     // Check all segments except the tail (last segment)
     // This is used for collision detection when the snake will move (not grow)
+    if (s->grid) {
+        // The cell records its newest segment, so it only shows the tail's
+        // age when the tail is the sole segment there
+        unsigned int age = occupancy_age(s->grid, s->owner, pos);
+        return age != 0 && age != s->age - (unsigned int)(s->length - 1);
+    }
+
     for (int i = 0; i < s->length - 1; ++i) {
-        if (s->segments[i].x == pos.x && s->segments[i].y == pos.y) {
+        if (vec2_equal(snake_segment(s, i), pos)) {
             return 1;
         }
     }
@@ -85,11 +230,12 @@ int snake_remove_head(Snake *s) {
         return 0;
     }
 
-    // Shift all segments forward (removing the head)
-    for (int i = 0; i < s->length - 1; ++i) {
-        s->segments[i] = s->segments[i + 1];
-    }
+    snake_unmark(s, s->segments[s->head], s->age);
+    s->age--;
 
+    // Advance the head index past the removed segment
+    s->head = (s->head + 1) & (s->capacity - 1);
     s->length--;
+    s->moved = 0;
     return 1;
 }
@@ -0,0 +1,254 @@
+#include "snapshot.h"
+#include <stdlib.h>
+#include <string.h>
+
+// Bytes of one slot's arrays, rounded up so every slot stays 8-byte aligned
+static size_t snapshot_slot_bytes(int cells, int owners) {
+    size_t n = (size_t)cells;
+    size_t bytes = (size_t)owners * n * (sizeof(Vec2) + sizeof(unsigned int)) +
+                   n * (2 * sizeof(int) + sizeof(unsigned short));
+    return (bytes + 7) & ~(size_t)7;
+}
+
+int snapshot_ring_init(SnapshotRing *r, int slots, int width, int height, int owners) {
+    memset(r, 0, sizeof(*r));
+    if (slots <= 0 || width <= 0 || height <= 0 || owners <= 0 || owners > MAX_PLAYERS) {
+        return 0;
+    }
+
+    r->capacity = slots;
+    r->width = width;
+    r->height = height;
+    r->cells = width * height;
+    r->owners = owners;
+
+    size_t n = (size_t)r->cells;
+    size_t slot_bytes = snapshot_slot_bytes(r->cells, owners);
+    r->slots = calloc((size_t)slots, sizeof(Snapshot));
+    r->storage = malloc((size_t)slots * slot_bytes);
+    if (!r->slots || !r->storage) {
+        snapshot_ring_free(r);
+        return 0;
+    }
+
+    // Carve each slot's arrays out of the backing block, widest type first
+    for (int i = 0; i < slots; i++) {
+        unsigned char *p = (unsigned char *)r->storage + (size_t)i * slot_bytes;
+        Snapshot *s = &r->slots[i];
+        s->cells = (Vec2 *)p;
+        p += (size_t)owners * n * sizeof(Vec2);
+        s->ages = (unsigned int *)p;
+        p += (size_t)owners * n * sizeof(unsigned int);
+        s->free_cells = (int *)p;
+        p += n * sizeof(int);
+        s->free_slot = (int *)p;
+        p += n * sizeof(int);
+        s->takers = (unsigned short *)p;
+    }
+    return 1;
+}
+
+void snapshot_ring_free(SnapshotRing *r) {
+    free(r->slots);
+    free(r->storage);
+    memset(r, 0, sizeof(*r));
+}
+
+void snapshot_ring_clear(SnapshotRing *r) {
+    for (int i = 0; i < r->capacity; i++) {
+        r->slots[i].kind = SNAPSHOT_EMPTY;
+    }
+    r->count = 0;
+    r->next = 0;
+}
+
+static int snapshot_board_matches(const SnapshotRing *r, const Board *b) {
+    return b->width == r->width && b->height == r->height &&
+           b->occupancy.ages != NULL && b->occupancy.owners <= r->owners;
+}
+
+// Claim the oldest slot for a new save
+static Snapshot *snapshot_begin(SnapshotRing *r, SnapshotKind kind, unsigned int frame) {
+    Snapshot *s = &r->slots[r->next];
+    s->kind = kind;
+    s->version = SNAPSHOT_VERSION;
+    s->frame = frame;
+    return s;
+}
+
+static void snapshot_commit(SnapshotRing *r) {
+    r->next = (r->next + 1) % r->capacity;
+    if (r->count < r->capacity) {
+        r->count++;
+    }
+}
+
+// Copy the snake's cells head first, unwrapping the ring
+static int snapshot_save_snake(const SnapshotRing *r, Snapshot *s, int index, const Snake *snake) {
+    if (snake->length > r->cells) {
+        return 0;
+    }
+
+    Vec2 *out = s->cells + (size_t)index * (size_t)r->cells;
+    int first = snake->capacity - snake->head;
+    if (first >= snake->length) {
+        memcpy(out, snake->segments + snake->head, (size_t)snake->length * sizeof(Vec2));
+    } else {
+        memcpy(out, snake->segments + snake->head, (size_t)first * sizeof(Vec2));
+        memcpy(out + first, snake->segments, (size_t)(snake->length - first) * sizeof(Vec2));
+    }
+    s->lengths[index] = snake->length;
+    return 1;
+}
+
+static void snapshot_save_grid(const SnapshotRing *r, Snapshot *s, const OccupancyGrid *g) {
+    size_t n = (size_t)r->cells;
+    memcpy(s->ages, g->ages, (size_t)g->owners * n * sizeof(unsigned int));
+    memcpy(s->takers, g->takers, n * sizeof(unsigned short));
+    memcpy(s->free_cells, g->free_cells, n * sizeof(int));
+    memcpy(s->free_slot, g->free_slot, n * sizeof(int));
+}
+
+int snapshot_save_game(SnapshotRing *r, const Game *g, unsigned int frame) {
+    if (!snapshot_board_matches(r, &g->board)) {
+        return 0;
+    }
+
+    Snapshot *s = snapshot_begin(r, SNAPSHOT_GAME, frame);
+    if (!snapshot_save_snake(r, s, 0, &g->snake)) {
+        s->kind = SNAPSHOT_EMPTY;
+        return 0;
+    }
+    memcpy(&s->state.game, g, sizeof(*g));
+    snapshot_save_grid(r, s, &g->board.occupancy);
+    snapshot_commit(r);
+    return 1;
+}
+
+int snapshot_save_multiplayer(SnapshotRing *r, const MultiplayerGame_s *mg, unsigned int frame) {
+    if (r->owners < MAX_PLAYERS || !snapshot_board_matches(r, &mg->board)) {
+        return 0;
+    }
+
+    Snapshot *s = snapshot_begin(r, SNAPSHOT_MULTIPLAYER, frame);
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        if (!snapshot_save_snake(r, s, i, &mg->players[i].snake)) {
+            s->kind = SNAPSHOT_EMPTY;
+            return 0;
+        }
+    }
+    memcpy(&s->state.mp, mg, sizeof(*mg));
+    snapshot_save_grid(r, s, &mg->board.occupancy);
+    snapshot_commit(r);
+    return 1;
+}
+
+const Snapshot *snapshot_find(const SnapshotRing *r, unsigned int frame) {
+    for (int k = 1; k <= r->count; k++) {
+        const Snapshot *s = &r->slots[(r->next - k + r->capacity) % r->capacity];
+        if (s->kind != SNAPSHOT_EMPTY && s->frame == frame) {
+            return s;
+        }
+    }
+    return NULL;
+}
+
+const Snapshot *snapshot_latest(const SnapshotRing *r) {
+    if (r->count == 0) {
+        return NULL;
+    }
+    const Snapshot *s = &r->slots[(r->next - 1 + r->capacity) % r->capacity];
+    return s->kind != SNAPSHOT_EMPTY ? s : NULL;
+}
+
+void snapshot_ring_truncate(SnapshotRing *r, const Snapshot *s) {
+    int index = (int)(s - r->slots);
+    if (index < 0 || index >= r->capacity || s->kind == SNAPSHOT_EMPTY) {
+        return;
+    }
+
+    int newest = (r->next - 1 + r->capacity) % r->capacity;
+    while (newest != index) {
+        r->slots[newest].kind = SNAPSHOT_EMPTY;
+        r->count--;
+        newest = (newest - 1 + r->capacity) % r->capacity;
+    }
+    r->next = (index + 1) % r->capacity;
+}
+
+// Refill a live snake from saved cells. The grid arrays are copied over
+// afterwards, so only the snake's own ring matters here.
+static void snapshot_restore_snake(const SnapshotRing *r, const Snapshot *s, int index,
+                                   const Snake *saved, Snake *snake) {
+    const Vec2 *cells = s->cells + (size_t)index * (size_t)r->cells;
+
+    snake_clear(snake);
+    snake->dir = saved->dir;
+    snake->age = saved->age;
+    for (int k = 0; k < s->lengths[index]; k++) {
+        snake_push_tail(snake, cells[k]);
+    }
+
+    // Pushing clears the last step; put it back so the first frame after a
+    // restore interpolates from the saved tick, not the one rolled back from
+    snake->prev_tail = saved->prev_tail;
+    snake->moved = saved->moved;
+}
+
+static void snapshot_restore_grid(const SnapshotRing *r, const Snapshot *s,
+                                  const OccupancyGrid *saved, OccupancyGrid *g) {
+    size_t n = (size_t)r->cells;
+    memcpy(g->ages, s->ages, (size_t)g->owners * n * sizeof(unsigned int));
+    memcpy(g->takers, s->takers, n * sizeof(unsigned short));
+    memcpy(g->free_cells, s->free_cells, n * sizeof(int));
+    memcpy(g->free_slot, s->free_slot, n * sizeof(int));
+    g->free_count = saved->free_count;
+}
+
+static int snapshot_can_restore(const SnapshotRing *r, const Snapshot *s, SnapshotKind kind,
+                                const Board *saved, const Board *live) {
+    return s && s->kind == kind && s->version == SNAPSHOT_VERSION &&
+           saved->width == live->width && saved->height == live->height &&
+           saved->occupancy.owners == live->occupancy.owners &&
+           snapshot_board_matches(r, live);
+}
+
+int snapshot_restore_game(const SnapshotRing *r, const Snapshot *s, Game *g) {
+    if (!snapshot_can_restore(r, s, SNAPSHOT_GAME, &s->state.game.board, &g->board)) {
+        return 0;
+    }
+
+    // Take every scalar field from the snapshot but keep the live game's
+    // storage (grid arrays, segment pool, snake ring)
+    Game restored;
+    memcpy(&restored, &s->state.game, sizeof(restored));
+    restored.board.occupancy = g->board.occupancy;
+    restored.snake = g->snake;
+    memcpy(&restored.pool, &g->pool, sizeof(restored.pool));
+    memcpy(g, &restored, sizeof(*g));
+
+    snapshot_restore_snake(r, s, 0, &s->state.game.snake, &g->snake);
+    snapshot_restore_grid(r, s, &s->state.game.board.occupancy, &g->board.occupancy);
+    return 1;
+}
+
+int snapshot_restore_multiplayer(const SnapshotRing *r, const Snapshot *s, MultiplayerGame_s *mg) {
+    if (!snapshot_can_restore(r, s, SNAPSHOT_MULTIPLAYER, &s->state.mp.board, &mg->board)) {
+        return 0;
+    }
+
+    MultiplayerGame_s restored;
+    memcpy(&restored, &s->state.mp, sizeof(restored));
+    restored.board.occupancy = mg->board.occupancy;
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        restored.players[i].snake = mg->players[i].snake;
+    }
+    memcpy(&restored.pool, &mg->pool, sizeof(restored.pool));
+    memcpy(mg, &restored, sizeof(*mg));
+
+    for (int i = 0; i < MAX_PLAYERS; i++) {
+        snapshot_restore_snake(r, s, i, &s->state.mp.players[i].snake, &mg->players[i].snake);
+    }
+    snapshot_restore_grid(r, s, &s->state.mp.board.occupancy, &mg->board.occupancy);
+    return 1;
+}
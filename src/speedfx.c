@@ -1,4 +1,5 @@
 #include "speedfx.h"
+#include "ui_helpers.h"
 #include <math.h>
 #include <stdlib.h>
 #ifndef PI_F
@@ -43,6 +44,10 @@
 // 0 = linear ramp, 1 = ease-in (starts gentler), 2 = ease-out (starts stronger)
 #define FX_RAMP_MODE 0
 
+// Software renderer batching
+#define FX_SOFT_ALPHA_LEVELS 16 // particle alphas are rounded to this many levels, one batch each
+#define FX_SOFT_BATCH 1024      // points or spans per draw call
+
 // ==========================================================
 static float clamp01(float v)
 {
@@ -349,6 +354,27 @@ void speedfx_apply_shake_rect(const SpeedFX *f, SDL_Rect *dst)
     dst->y += dy;
 }
 
+// Particle streak from head to tail, in the pixels SDL_RenderDrawLine would use
+static void particle_line(const WarpParticle *p, int *x1, int *y1, int *x2, int *y2)
+{
+    float vlen = sqrtf(p->vx * p->vx + p->vy * p->vy);
+    float nx = (vlen > 0.001f) ? (p->vx / vlen) : 0.0f;
+    float ny = (vlen > 0.001f) ? (p->vy / vlen) : 0.0f;
+
+    *x1 = (int)lroundf(p->x);
+    *y1 = (int)lroundf(p->y);
+    *x2 = (int)lroundf(p->x - nx * p->len);
+    *y2 = (int)lroundf(p->y - ny * p->len);
+}
+
+static unsigned char particle_alpha(const WarpParticle *p)
+{
+    float t = (p->ttl > 0.0001f) ? (p->life / p->ttl) : 0.0f; // 1..0
+    if (t < 0.0f)
+        t = 0.0f;
+    return (unsigned char)((float)p->a * t);
+}
+
 void speedfx_render_particles(SDL_Renderer *ren, const SpeedFX *f)
 {
     if (!ren || !f)
@@ -363,23 +389,78 @@ void speedfx_render_particles(SDL_Renderer *ren, const SpeedFX *f)
         {
             return;
         }
-        float t = (p->ttl > 0.0001f) ? (p->life / p->ttl) : 0.0f; // 1..0
-        if (t < 0.0f)
-            t = 0.0f;
+        SDL_SetRenderDrawColor(ren, 180, 200, 255, particle_alpha(p));
 
-        unsigned char a = (unsigned char)((float)p->a * t);
-        SDL_SetRenderDrawColor(ren, 180, 200, 255, a);
+        int x1, y1, x2, y2;
+        particle_line(p, &x1, &y1, &x2, &y2);
+        SDL_RenderDrawLine(ren, x1, y1, x2, y2);
+        ui_draw_calls++;
+    }
+
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+}
 
-        float vlen = sqrtf(p->vx * p->vx + p->vy * p->vy);
-        float nx = (vlen > 0.001f) ? (p->vx / vlen) : 0.0f;
-        float ny = (vlen > 0.001f) ? (p->vy / vlen) : 0.0f;
+void speedfx_render_particles_batched(SDL_Renderer *ren, const SpeedFX *f)
+{
+    if (!ren || !f || f->fx <= 0.01f)
+        return;
 
-        int x1 = (int)lroundf(p->x);
-        int y1 = (int)lroundf(p->y);
-        int x2 = (int)lroundf(p->x - nx * p->len);
-        int y2 = (int)lroundf(p->y - ny * p->len);
+    static SDL_Point pts[FX_SOFT_BATCH];
+    const int step = 256 / FX_SOFT_ALPHA_LEVELS;
 
-        SDL_RenderDrawLine(ren, x1, y1, x2, y2);
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_ADD);
+
+    for (int level = 0; level < FX_SOFT_ALPHA_LEVELS; level++)
+    {
+        int n = 0;
+        SDL_SetRenderDrawColor(ren, 180, 200, 255, (Uint8)(level * step + step / 2));
+
+        for (int i = 0; i < f->p_count; i++)
+        {
+            const WarpParticle *p = &f->p[i];
+            if (particle_alpha(p) / step != level)
+                continue;
+
+            // Bresenham, both ends included
+            int x, y, x2, y2;
+            particle_line(p, &x, &y, &x2, &y2);
+            int dx = abs(x2 - x), sx = x < x2 ? 1 : -1;
+            int dy = -abs(y2 - y), sy = y < y2 ? 1 : -1;
+            int err = dx + dy;
+            for (;;)
+            {
+                if (x >= 0 && y >= 0 && x < f->w && y < f->h)
+                {
+                    pts[n].x = x;
+                    pts[n].y = y;
+                    if (++n == FX_SOFT_BATCH)
+                    {
+                        SDL_RenderDrawPoints(ren, pts, n);
+                        ui_draw_calls++;
+                        n = 0;
+                    }
+                }
+                if (x == x2 && y == y2)
+                    break;
+                int e2 = 2 * err;
+                if (e2 >= dy)
+                {
+                    err += dy;
+                    x += sx;
+                }
+                if (e2 <= dx)
+                {
+                    err += dx;
+                    y += sy;
+                }
+            }
+        }
+
+        if (n > 0)
+        {
+            SDL_RenderDrawPoints(ren, pts, n);
+            ui_draw_calls++;
+        }
     }
 
     SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
@@ -513,6 +594,7 @@ void speedfx_render_rings(SDL_Renderer *ren, const SpeedFX *f, Uint8 cr, Uint8 c
                     ren,
                     (int)lroundf(prevx), (int)lroundf(prevy),
                     (int)lroundf(x), (int)lroundf(y));
+                ui_draw_calls++;
 
                 prevx = x;
                 prevy = y;
@@ -522,3 +604,94 @@ void speedfx_render_rings(SDL_Renderer *ren, const SpeedFX *f, Uint8 cr, Uint8 c
 
     SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
 }
+
+void speedfx_render_rings_spans(SDL_Renderer *ren, const SpeedFX *f, Uint8 cr, Uint8 cg, Uint8 cb)
+{
+    if (!ren || !f)
+        return;
+    if (f->ring_count <= 0)
+        return;
+
+    static SDL_Rect spans[FX_SOFT_BATCH];
+
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_ADD);
+
+    for (int i = 0; i < f->ring_count; i++)
+    {
+        const ComboRing *q = &f->ring[i];
+
+        float u = (q->ttl > 0.0001f) ? (q->t / q->ttl) : 0.0f; // 1..0
+        if (u < 0.0f)
+            u = 0.0f;
+        float k = u * u;
+        SDL_SetRenderDrawColor(ren, cr, cg, cb, (Uint8)(q->a * k));
+
+        // The band the concentric circles of speedfx_render_rings cover
+        int layers = (int)lroundf(q->thick);
+        if (layers < 1)
+            layers = 1;
+        if (layers > 8)
+            layers = 8;
+        float inner = q->r - (q->thick * 0.5f);
+        float outer = inner + (float)layers;
+        if (inner < 0.0f)
+            inner = 0.0f;
+
+        int cx = (int)lroundf(q->x);
+        int cy = (int)lroundf(q->y);
+        int top = cy - (int)outer;
+        int bottom = cy + (int)outer;
+        if (top < 0)
+            top = 0;
+        if (bottom > f->h - 1)
+            bottom = f->h - 1;
+
+        // One or two spans per row, clipped to the viewport
+        int n = 0;
+        for (int y = top; y <= bottom; y++)
+        {
+            float dy = (float)(y - cy);
+            float xo2 = outer * outer - dy * dy;
+            if (xo2 < 0.0f)
+                continue;
+            int xo = (int)sqrtf(xo2);
+            int xi = -1;
+            if (dy * dy < inner * inner)
+                xi = (int)sqrtf(inner * inner - dy * dy);
+
+            int run[2][2] = {{cx - xo, cx - xi - 1}, {cx + xi + 1, cx + xo}};
+            int runs = 2;
+            if (xi < 0)
+            {
+                run[0][1] = cx + xo;
+                runs = 1;
+            }
+
+            for (int r = 0; r < runs; r++)
+            {
+                int x0 = run[r][0] < 0 ? 0 : run[r][0];
+                int x1 = run[r][1] > f->w - 1 ? f->w - 1 : run[r][1];
+                if (x1 < x0)
+                    continue;
+                spans[n].x = x0;
+                spans[n].y = y;
+                spans[n].w = x1 - x0 + 1;
+                spans[n].h = 1;
+                if (++n == FX_SOFT_BATCH)
+                {
+                    SDL_RenderFillRects(ren, spans, n);
+                    ui_draw_calls++;
+                    n = 0;
+                }
+            }
+        }
+
+        if (n > 0)
+        {
+            SDL_RenderFillRects(ren, spans, n);
+            ui_draw_calls++;
+        }
+    }
+
+    SDL_SetRenderDrawBlendMode(ren, SDL_BLENDMODE_BLEND);
+}
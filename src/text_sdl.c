@@ -1,18 +1,44 @@
 #include "text_sdl.h"
+#include "ui_helpers.h"
+#include <stdlib.h>
 #include <string.h>
 
+// Pair kerning between glyphs (what TTF_RenderUTF8_Blended applies)
+#ifdef SDL_TTF_VERSION_ATLEAST
+#if SDL_TTF_VERSION_ATLEAST(2, 0, 14)
+#define TEXT_KERNING 1
+#endif
+#endif
+
 int text_init(TextRenderer *tr, const char *font_path, int pt_size) {
+    memset(tr, 0, sizeof(*tr));
     tr->font = TTF_OpenFont(font_path, pt_size);
-    return tr->font ? 1 : 0;
+    if (!tr->font) return 0;
+    tr->height = TTF_FontHeight(tr->font);
+    return 1;
+}
+
+static void text_atlas_reset(TextRenderer *tr) {
+    if (tr->atlas) {
+        SDL_DestroyTexture(tr->atlas);
+        tr->atlas = NULL;
+    }
+    tr->atlas_ren = NULL;
+    tr->pen_x = 0;
+    tr->pen_y = 0;
+    memset(tr->glyphs, 0, sizeof(tr->glyphs));
+    memset(tr->lines, 0, sizeof(tr->lines));
 }
 
 void text_shutdown(TextRenderer *tr) {
+    text_atlas_reset(tr);
     if (tr->font) {
         TTF_CloseFont(tr->font);
         tr->font = NULL;
     }
 }
 
+// Whole-string path for text the atlas cannot lay out
 static void draw_text_internal(SDL_Renderer *ren, TTF_Font *font, int x, int y, const char *msg) {
     if (!msg || !*msg) return;
 
@@ -32,35 +58,262 @@ static void draw_text_internal(SDL_Renderer *ren, TTF_Font *font, int x, int y,
     SDL_FreeSurface(surf);
 
     SDL_RenderCopy(ren, tex, NULL, &dst);
+    ui_draw_calls++;
     SDL_DestroyTexture(tex);
 }
 
-void text_draw(SDL_Renderer *ren, TextRenderer *tr, int x, int y, const char *msg) {
-    if (!tr || !tr->font) return;
-    draw_text_internal(ren, tr->font, x, y, msg);
+// Atlas texture for `ren`, created (cleared) on first use and rebuilt if
+// the renderer changes
+static int text_atlas_ready(SDL_Renderer *ren, TextRenderer *tr) {
+    if (tr->atlas && tr->atlas_ren == ren) return 1;
+    text_atlas_reset(tr);
+
+    tr->atlas = SDL_CreateTexture(ren, SDL_PIXELFORMAT_ARGB8888, SDL_TEXTUREACCESS_STATIC,
+                                  TEXT_ATLAS_SIZE, TEXT_ATLAS_SIZE);
+    if (!tr->atlas) return 0;
+
+    void *clear = calloc((size_t)TEXT_ATLAS_SIZE * TEXT_ATLAS_SIZE, 4);
+    if (!clear) {
+        SDL_DestroyTexture(tr->atlas);
+        tr->atlas = NULL;
+        return 0;
+    }
+    SDL_UpdateTexture(tr->atlas, NULL, clear, TEXT_ATLAS_SIZE * 4);
+    free(clear);
+
+    SDL_SetTextureBlendMode(tr->atlas, SDL_BLENDMODE_BLEND);
+    tr->atlas_ren = ren;
+    return 1;
 }
 
-void text_draw_center(SDL_Renderer *ren, TextRenderer *tr, int cx, int cy, const char *msg) {
-    if (!tr || !tr->font || !msg) return;
+// Glyph for code point `cp`, rasterized into the atlas on first use.
+// NULL if it cannot be drawn from the atlas.
+static const TextGlyph *text_glyph(TextRenderer *tr, uint32_t cp) {
+    if (cp >= TEXT_ATLAS_GLYPHS) return NULL;
+
+    TextGlyph *g = &tr->glyphs[cp];
+    if (g->state != 0) return g->state > 0 ? g : NULL;
+    g->state = -1;
+
+    int minx, maxx, miny, maxy, advance;
+    if (TTF_GlyphMetrics(tr->font, (Uint16)cp, &minx, &maxx, &miny, &maxy, &advance) != 0) return NULL;
 
     SDL_Color c = {255, 255, 255, 255};
-    SDL_Surface *surf = TTF_RenderUTF8_Blended(tr->font, msg, c);
-    if (!surf) return;
+    SDL_Surface *surf = TTF_RenderGlyph_Blended(tr->font, (Uint16)cp, c);
+    if (!surf) return NULL;
+    SDL_Surface *argb = SDL_ConvertSurfaceFormat(surf, SDL_PIXELFORMAT_ARGB8888, 0);
+    SDL_FreeSurface(surf);
+    if (!argb) return NULL;
 
-    SDL_Texture *tex = SDL_CreateTextureFromSurface(ren, surf);
-    if (!tex) {
-        SDL_FreeSurface(surf);
+    // Shelf packing: every glyph is one line tall, so rows are tr->height apart
+    if (tr->pen_x + argb->w > TEXT_ATLAS_SIZE) {
+        tr->pen_x = 0;
+        tr->pen_y += tr->height + 1;
+    }
+    if (argb->w > TEXT_ATLAS_SIZE || tr->pen_y + argb->h > TEXT_ATLAS_SIZE) {
+        SDL_FreeSurface(argb);
+        return NULL;
+    }
+
+    g->src.x = tr->pen_x;
+    g->src.y = tr->pen_y;
+    g->src.w = argb->w;
+    g->src.h = argb->h;
+    g->advance = advance;
+    SDL_UpdateTexture(tr->atlas, &g->src, argb->pixels, argb->pitch);
+    SDL_FreeSurface(argb);
+
+    tr->pen_x += g->src.w + 1;
+    g->state = 1;
+    return g;
+}
+
+// Next code point of UTF-8 `*s`, advancing it; 0xFFFFFFFF if malformed
+static uint32_t text_next_codepoint(const unsigned char **s) {
+    const unsigned char *p = *s;
+    uint32_t cp;
+    int extra;
+
+    if (p[0] < 0x80) {
+        cp = p[0];
+        extra = 0;
+    } else if ((p[0] & 0xE0) == 0xC0) {
+        cp = p[0] & 0x1F;
+        extra = 1;
+    } else if ((p[0] & 0xF0) == 0xE0) {
+        cp = p[0] & 0x0F;
+        extra = 2;
+    } else if ((p[0] & 0xF8) == 0xF0) {
+        cp = p[0] & 0x07;
+        extra = 3;
+    } else {
+        *s = p + 1;
+        return 0xFFFFFFFFu;
+    }
+
+    for (int i = 1; i <= extra; i++) {
+        if ((p[i] & 0xC0) != 0x80) {
+            *s = p + i;
+            return 0xFFFFFFFFu;
+        }
+        cp = (cp << 6) | (p[i] & 0x3F);
+    }
+    *s = p + 1 + extra;
+    return cp;
+}
+
+// Lay `msg` out into `line`; 0 if any glyph is missing from the atlas or
+// the string is too long
+static int text_layout(TextRenderer *tr, const char *msg, TextLine *line) {
+    const unsigned char *p = (const unsigned char *)msg;
+    int pen = 0;
+    int right = 0;
+#ifdef TEXT_KERNING
+    uint32_t prev = 0;
+#endif
+
+    line->count = 0;
+    while (*p) {
+        uint32_t cp = text_next_codepoint(&p);
+        const TextGlyph *g = text_glyph(tr, cp);
+        if (!g || line->count == TEXT_LINE_MAX_GLYPHS) return 0;
+
+#ifdef TEXT_KERNING
+        if (line->count > 0) {
+            pen += TTF_GetFontKerningSizeGlyphs(tr->font, (Uint16)prev, (Uint16)cp);
+        }
+        prev = cp;
+#endif
+
+        TextQuad *q = &line->quads[line->count++];
+        q->src = g->src;
+        q->dst.x = pen;
+        q->dst.y = 0;
+        q->dst.w = g->src.w;
+        q->dst.h = g->src.h;
+        if (pen + g->src.w > right) right = pen + g->src.w;
+        pen += g->advance;
+    }
+
+    line->w = pen > right ? pen : right;
+    line->h = tr->height;
+    return 1;
+}
+
+static uint32_t text_hash(const char *s) {
+    // FNV-1a; never 0 so 0 can mark an empty cache slot
+    uint32_t h = 2166136261u;
+    for (; *s; s++) {
+        h ^= (unsigned char)*s;
+        h *= 16777619u;
+    }
+    return h ? h : 1;
+}
+
+// Cached layout of `msg`, laid out now on a miss (evicting the least
+// recently used line). NULL if the atlas cannot draw it; such strings
+// never take a cache slot from one that can be drawn.
+static const TextLine *text_line(SDL_Renderer *ren, TextRenderer *tr, const char *msg) {
+    if (strlen(msg) >= TEXT_LINE_MAX_BYTES || !text_atlas_ready(ren, tr)) return NULL;
+
+    uint32_t hash = text_hash(msg);
+    TextLine *victim = NULL;
+    tr->clock++;
+    for (int i = 0; i < TEXT_CACHE_LINES; i++) {
+        TextLine *line = &tr->lines[i];
+        if (line->hash == hash && strcmp(line->text, msg) == 0) {
+            line->last_used = tr->clock;
+            return line;
+        }
+        // Unused slots have stamp 0 and go first
+        if (!victim || line->last_used < victim->last_used) victim = line;
+    }
+
+    // Lay out aside first: failing glyphs are already known (state -1),
+    // so a string the atlas cannot draw costs a scan, not an eviction
+    if (!text_layout(tr, msg, &tr->scratch)) return NULL;
+    *victim = tr->scratch;
+    strcpy(victim->text, msg);
+    victim->hash = hash;
+    victim->last_used = tr->clock;
+    return victim;
+}
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+// One batch of textured quads from the atlas, top left at (x, y)
+static void text_draw_geometry(SDL_Renderer *ren, TextRenderer *tr, const TextLine *line, int x, int y) {
+    SDL_Vertex verts[TEXT_LINE_MAX_GLYPHS * 4];
+    int indices[TEXT_LINE_MAX_GLYPHS * 6];
+    const float inv = 1.0f / (float)TEXT_ATLAS_SIZE;
+    const SDL_Color white = {255, 255, 255, 255};
+
+    for (int i = 0; i < line->count; i++) {
+        const TextQuad *q = &line->quads[i];
+        float x0 = (float)(x + q->dst.x), y0 = (float)(y + q->dst.y);
+        float x1 = x0 + (float)q->dst.w, y1 = y0 + (float)q->dst.h;
+        float u0 = (float)q->src.x * inv, v0 = (float)q->src.y * inv;
+        float u1 = (float)(q->src.x + q->src.w) * inv, v1 = (float)(q->src.y + q->src.h) * inv;
+
+        SDL_Vertex *v = &verts[i * 4];
+        v[0] = (SDL_Vertex){{x0, y0}, white, {u0, v0}};
+        v[1] = (SDL_Vertex){{x1, y0}, white, {u1, v0}};
+        v[2] = (SDL_Vertex){{x1, y1}, white, {u1, v1}};
+        v[3] = (SDL_Vertex){{x0, y1}, white, {u0, v1}};
+
+        int *ix = &indices[i * 6];
+        ix[0] = i * 4;
+        ix[1] = i * 4 + 1;
+        ix[2] = i * 4 + 2;
+        ix[3] = i * 4;
+        ix[4] = i * 4 + 2;
+        ix[5] = i * 4 + 3;
+    }
+    SDL_RenderGeometry(ren, tr->atlas, verts, line->count * 4, indices, line->count * 6);
+    ui_draw_calls++;
+}
+#endif
+
+// A laid-out string from the atlas, top left at (x, y)
+static void text_draw_line(SDL_Renderer *ren, TextRenderer *tr, const TextLine *line, int x, int y) {
+    if (line->count == 0) return;
+
+#if SDL_VERSION_ATLEAST(2, 0, 18)
+    if (!tr->copy_glyphs) {
+        text_draw_geometry(ren, tr, line, x, y);
         return;
     }
+#endif
 
-    SDL_Rect dst;
-    dst.w = surf->w;
-    dst.h = surf->h;
-    dst.x = cx - dst.w / 2;
-    dst.y = cy - dst.h / 2;
+    // One copy per glyph (no geometry API before SDL 2.0.18), still from the atlas
+    for (int i = 0; i < line->count; i++) {
+        const TextQuad *q = &line->quads[i];
+        SDL_Rect dst = {x + q->dst.x, y + q->dst.y, q->dst.w, q->dst.h};
+        SDL_RenderCopy(ren, tr->atlas, &q->src, &dst);
+        ui_draw_calls++;
+    }
+}
 
-    SDL_FreeSurface(surf);
+void text_draw(SDL_Renderer *ren, TextRenderer *tr, int x, int y, const char *msg) {
+    if (!tr || !tr->font || !msg || !*msg) return;
 
-    SDL_RenderCopy(ren, tex, NULL, &dst);
-    SDL_DestroyTexture(tex);
+    const TextLine *line = text_line(ren, tr, msg);
+    if (line) {
+        text_draw_line(ren, tr, line, x, y);
+    } else {
+        draw_text_internal(ren, tr->font, x, y, msg);
+    }
+}
+
+void text_draw_center(SDL_Renderer *ren, TextRenderer *tr, int cx, int cy, const char *msg) {
+    if (!tr || !tr->font || !msg || !*msg) return;
+
+    const TextLine *line = text_line(ren, tr, msg);
+    if (line) {
+        text_draw_line(ren, tr, line, cx - line->w / 2, cy - line->h / 2);
+        return;
+    }
+
+    int w = 0, h = 0;
+    if (TTF_SizeUTF8(tr->font, msg, &w, &h) != 0) return;
+    draw_text_internal(ren, tr->font, cx - w / 2, cy - h / 2, msg);
 }
@@ -0,0 +1,84 @@
+#include "tick_scheduler.h"
+
+void tick_scheduler_init(TickScheduler *ts, uint64_t freq, int max_catch_up) {
+    ts->freq = freq > 0 ? freq : 1000;
+    ts->period = ts->freq / 10;
+    ts->last = 0;
+    ts->tick = 0;
+    ts->dropped = 0;
+    ts->max_catch_up = max_catch_up > 0 ? max_catch_up : 1;
+    ts->paused = 0;
+    ts->paused_elapsed = 0;
+}
+
+uint64_t tick_scheduler_from_ms(const TickScheduler *ts, unsigned int ms) {
+    return (uint64_t)ms * ts->freq / 1000;
+}
+
+void tick_scheduler_start(TickScheduler *ts, uint64_t now, unsigned int period_ms) {
+    tick_scheduler_set_period_ms(ts, period_ms);
+    ts->last = now;
+    ts->tick = 0;
+    ts->dropped = 0;
+    ts->paused = 0;
+}
+
+void tick_scheduler_pause(TickScheduler *ts, uint64_t now) {
+    if (ts->paused) return;
+
+    uint64_t elapsed = now - ts->last;
+    ts->paused_elapsed = elapsed < ts->period ? elapsed : ts->period;
+    ts->paused = 1;
+}
+
+void tick_scheduler_resume(TickScheduler *ts, uint64_t now) {
+    if (!ts->paused) return;
+
+    ts->last = now - ts->paused_elapsed;
+    ts->paused = 0;
+}
+
+void tick_scheduler_set_period_ms(TickScheduler *ts, unsigned int period_ms) {
+    ts->period = tick_scheduler_from_ms(ts, period_ms);
+    if (ts->period == 0) {
+        ts->period = 1;
+    }
+}
+
+int tick_scheduler_due(TickScheduler *ts, uint64_t now) {
+    if (ts->paused) {
+        return 0;
+    }
+
+    uint64_t next = ts->last + ts->period;
+    // Signed distance so a deadline slightly in the future reads as "not yet"
+    int64_t late = (int64_t)(now - next);
+    if (late < 0) {
+        return 0;
+    }
+
+    // Too far behind (debugger, window drag, stalled frame): keep the last
+    // max_catch_up ticks and drop the rest instead of fast-forwarding
+    uint64_t backlog = (uint64_t)late / ts->period;
+    if (backlog >= (uint64_t)ts->max_catch_up) {
+        uint64_t skip = backlog - (uint64_t)ts->max_catch_up + 1;
+        ts->dropped += skip;
+        next += skip * ts->period;
+    }
+
+    ts->last = next;
+    ts->tick++;
+    return 1;
+}
+
+float tick_scheduler_alpha(const TickScheduler *ts, uint64_t now) {
+    uint64_t elapsed = ts->paused ? ts->paused_elapsed : now - ts->last;
+    // A deadline in the future (negative elapsed) wraps to a huge value
+    if ((int64_t)elapsed <= 0) {
+        return 0.0f;
+    }
+    if (elapsed >= ts->period) {
+        return 1.0f;
+    }
+    return (float)((double)elapsed / (double)ts->period);
+}
@@ -0,0 +1,205 @@
+#include "timer_wheel.h"
+#include <string.h>
+
+#define TIMER_WHEEL_MASK (TIMER_WHEEL_SLOTS - 1)
+#define TIMER_WHEEL_SPAN (1u << (TIMER_WHEEL_BITS * TIMER_WHEEL_LEVELS)) // ms the top level covers
+
+static int lowest_bit(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int b = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        b++;
+    }
+    return b;
+#endif
+}
+
+static int timer_handle(const TimerWheel *w, int index) {
+    return ((int)w->timers[index].generation << 16) | index;
+}
+
+// Index of the pending timer `handle` names, or -1
+static int timer_index(const TimerWheel *w, int handle) {
+    if (handle < 0) {
+        return -1;
+    }
+    int index = handle & 0xffff;
+    if (index >= TIMER_WHEEL_CAPACITY) {
+        return -1;
+    }
+    const Timer *t = &w->timers[index];
+    if (t->slot < 0 || t->generation != (uint16_t)(handle >> 16)) {
+        return -1;
+    }
+    return index;
+}
+
+// File timer `index` in the slot for its distance from the clock
+static void timer_link(TimerWheel *w, int index) {
+    Timer *t = &w->timers[index];
+    unsigned int due = t->due;
+    if ((int)(due - w->next) < 0) {
+        due = w->next;
+    }
+
+    unsigned int delta = due - w->next;
+    if (delta >= TIMER_WHEEL_SPAN) {
+        // Park in the farthest slot; it is filed again when that comes round
+        delta = TIMER_WHEEL_SPAN - 1;
+        due = w->next + delta;
+    }
+
+    int level = 0;
+    while (level < TIMER_WHEEL_LEVELS - 1 &&
+           delta >= (1u << (TIMER_WHEEL_BITS * (level + 1)))) {
+        level++;
+    }
+
+    int pos = (int)((due >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK);
+    int slot = level * TIMER_WHEEL_SLOTS + pos;
+
+    t->slot = (int16_t)slot;
+    t->prev = -1;
+    t->next = w->heads[slot];
+    if (t->next >= 0) {
+        w->timers[t->next].prev = (int16_t)index;
+    }
+    w->heads[slot] = (int16_t)index;
+    w->occupied[level] |= (uint64_t)1 << pos;
+}
+
+static void timer_unlink(TimerWheel *w, int index) {
+    Timer *t = &w->timers[index];
+    int slot = t->slot;
+
+    if (t->prev >= 0) {
+        w->timers[t->prev].next = t->next;
+    } else {
+        w->heads[slot] = t->next;
+    }
+    if (t->next >= 0) {
+        w->timers[t->next].prev = t->prev;
+    }
+    if (w->heads[slot] < 0) {
+        w->occupied[slot / TIMER_WHEEL_SLOTS] &= ~((uint64_t)1 << (slot & TIMER_WHEEL_MASK));
+    }
+    t->slot = -1;
+}
+
+static void timer_release(TimerWheel *w, int index) {
+    Timer *t = &w->timers[index];
+    t->generation++;
+    t->next = w->free_head;
+    w->free_head = (int16_t)index;
+    w->active--;
+}
+
+void timer_wheel_init(TimerWheel *w, unsigned int now) {
+    memset(w, 0, sizeof(*w));
+    for (int i = 0; i < TIMER_WHEEL_LEVELS * TIMER_WHEEL_SLOTS; i++) {
+        w->heads[i] = -1;
+    }
+    for (int i = 0; i < TIMER_WHEEL_CAPACITY; i++) {
+        w->timers[i].slot = -1;
+        w->timers[i].next = (int16_t)(i + 1 < TIMER_WHEEL_CAPACITY ? i + 1 : -1);
+    }
+    w->free_head = 0;
+    w->next = now + 1;
+}
+
+int timer_wheel_schedule(TimerWheel *w, unsigned int due, int kind, int data) {
+    int index = w->free_head;
+    if (index < 0) {
+        return TIMER_NONE;
+    }
+
+    Timer *t = &w->timers[index];
+    w->free_head = t->next;
+    w->active++;
+    t->due = due;
+    t->kind = kind;
+    t->data = data;
+    timer_link(w, index);
+    return timer_handle(w, index);
+}
+
+int timer_wheel_cancel(TimerWheel *w, int handle) {
+    int index = timer_index(w, handle);
+    if (index < 0) {
+        return 0;
+    }
+    timer_unlink(w, index);
+    timer_release(w, index);
+    return 1;
+}
+
+int timer_wheel_pending(const TimerWheel *w, int handle) {
+    return timer_index(w, handle) >= 0;
+}
+
+// The clock reached the start of slot `pos` on `level`: refile its timers
+// one level down (they now fall within that level's span)
+static void timer_cascade(TimerWheel *w, int level, int pos) {
+    int slot = level * TIMER_WHEEL_SLOTS + pos;
+    int index = w->heads[slot];
+    w->heads[slot] = -1;
+    w->occupied[level] &= ~((uint64_t)1 << pos);
+
+    while (index >= 0) {
+        int next = w->timers[index].next;
+        timer_link(w, index);
+        index = next;
+    }
+}
+
+void timer_wheel_advance(TimerWheel *w, unsigned int now, TimerFireFn fire, void *user) {
+    while ((int)(now - w->next) >= 0) {
+        if (w->active == 0) {
+            w->next = now + 1;
+            return;
+        }
+
+        // Until the next level 0 rotation only level 0 slots can fire,
+        // so jump to the first occupied one (or to the rotation)
+        unsigned int t = w->next;
+        int pos = (int)(t & TIMER_WHEEL_MASK);
+        if (pos != 0) {
+            uint64_t ahead = w->occupied[0] >> pos;
+            unsigned int jump = ahead ? (unsigned int)lowest_bit(ahead) : (unsigned int)(TIMER_WHEEL_SLOTS - pos);
+            if (jump > now - t) {
+                w->next = now + 1;
+                return;
+            }
+            t += jump;
+            pos = (int)(t & TIMER_WHEEL_MASK);
+        }
+        w->next = t;
+
+        // New rotation: bring the next span of each level down
+        for (int level = 1; pos == 0 && level < TIMER_WHEEL_LEVELS; level++) {
+            int level_pos = (int)((t >> (TIMER_WHEEL_BITS * level)) & TIMER_WHEEL_MASK);
+            timer_cascade(w, level, level_pos);
+            if (level_pos != 0) {
+                break;
+            }
+        }
+
+        // Timers scheduled by `fire` for a time already passed go to t + 1
+        w->next = t + 1;
+        int index;
+        while ((index = w->heads[pos]) >= 0) {
+            Timer *timer = &w->timers[index];
+            int kind = timer->kind;
+            int data = timer->data;
+            unsigned int due = timer->due;
+            timer_unlink(w, index);
+            timer_release(w, index);
+            if (fire) {
+                fire(user, kind, data, due);
+            }
+        }
+    }
+}
@@ -0,0 +1,163 @@
+#include "trace.h"
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+typedef struct {
+    const char *name;
+    uint64_t begin;
+    uint64_t end;
+} TraceEvent;
+
+typedef struct {
+    const char *name;       // Track name, NULL for an unnamed thread
+    TraceEvent *events;     // TRACE_RING_EVENTS entries, written only by the owning thread
+    uint64_t count;         // Events recorded so far
+} TraceRing;
+
+static TraceRing rings[TRACE_MAX_THREADS];
+static int ring_count;
+static atomic_flag rings_lock = ATOMIC_FLAG_INIT;   // Guards ring registration
+static atomic_int enabled;
+static TraceClockFn trace_clock;
+static uint64_t trace_frequency;
+static uint64_t trace_origin;
+
+static _Thread_local TraceRing *local_ring;
+
+static void rings_lock_acquire(void) {
+    while (atomic_flag_test_and_set_explicit(&rings_lock, memory_order_acquire)) {
+    }
+}
+
+static void rings_lock_release(void) {
+    atomic_flag_clear_explicit(&rings_lock, memory_order_release);
+}
+
+// Track named `name` (a new one when NULL), or NULL if all are taken or
+// memory ran out. Caller holds the lock.
+static TraceRing *ring_attach(const char *name) {
+    for (int i = 0; name && i < ring_count; i++) {
+        if (rings[i].name && strcmp(rings[i].name, name) == 0) {
+            return &rings[i];
+        }
+    }
+    if (ring_count >= TRACE_MAX_THREADS) {
+        return NULL;
+    }
+
+    TraceEvent *events = malloc(sizeof(TraceEvent) * TRACE_RING_EVENTS);
+    if (!events) {
+        return NULL;
+    }
+    TraceRing *r = &rings[ring_count++];
+    r->name = name;
+    r->events = events;
+    r->count = 0;
+    return r;
+}
+
+void trace_start(TraceClockFn clock, uint64_t frequency) {
+    trace_clock = clock;
+    trace_frequency = frequency;
+    trace_origin = clock();
+    atomic_store_explicit(&enabled, 1, memory_order_release);
+}
+
+void trace_thread_name(const char *name) {
+    if (!atomic_load_explicit(&enabled, memory_order_acquire)) {
+        return;
+    }
+    if (local_ring && local_ring->name == name) {
+        return;
+    }
+    rings_lock_acquire();
+    TraceRing *r = ring_attach(name);
+    rings_lock_release();
+    if (r) {
+        local_ring = r;
+    }
+}
+
+uint64_t trace_begin(void) {
+    if (!atomic_load_explicit(&enabled, memory_order_acquire)) {
+        return 0;
+    }
+    return trace_clock();
+}
+
+void trace_end(const char *name, uint64_t begin) {
+    if (begin == 0 || !atomic_load_explicit(&enabled, memory_order_acquire)) {
+        return;
+    }
+    uint64_t end = trace_clock();
+
+    TraceRing *r = local_ring;
+    if (!r) {
+        rings_lock_acquire();
+        r = ring_attach(NULL);
+        rings_lock_release();
+        if (!r) {
+            return;
+        }
+        local_ring = r;
+    }
+
+    TraceEvent *e = &r->events[r->count % TRACE_RING_EVENTS];
+    e->name = name;
+    e->begin = begin;
+    e->end = end;
+    r->count++;
+}
+
+static double trace_us(uint64_t ticks) {
+    return (double)ticks * 1e6 / (double)trace_frequency;
+}
+
+int trace_write_json(const char *path) {
+    FILE *f = fopen(path, "w");
+    if (!f) {
+        return -1;
+    }
+
+    rings_lock_acquire();
+    int tracks = ring_count;
+    rings_lock_release();
+
+    fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(f, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"snake\"}}");
+    for (int t = 0; t < tracks; t++) {
+        const TraceRing *r = &rings[t];
+        int tid = t + 1;
+        if (r->name) {
+            fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,\"args\":{\"name\":\"%s\"}}",
+                    tid, r->name);
+        }
+
+        uint64_t first = r->count > TRACE_RING_EVENTS ? r->count - TRACE_RING_EVENTS : 0;
+        for (uint64_t i = first; i < r->count; i++) {
+            const TraceEvent *e = &r->events[i % TRACE_RING_EVENTS];
+            fprintf(f, ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f}",
+                    e->name, tid, trace_us(e->begin - trace_origin), trace_us(e->end - e->begin));
+        }
+    }
+    fprintf(f, "\n]}\n");
+
+    int ok = !ferror(f);
+    if (fclose(f) != 0) {
+        ok = 0;
+    }
+    return ok ? 0 : -1;
+}
+
+void trace_stop(void) {
+    atomic_store_explicit(&enabled, 0, memory_order_release);
+    rings_lock_acquire();
+    for (int i = 0; i < ring_count; i++) {
+        free(rings[i].events);
+        rings[i].events = NULL;
+    }
+    ring_count = 0;
+    rings_lock_release();
+}
@@ -0,0 +1,39 @@
+#include "triple_buffer.h"
+
+#define TRIPLE_BUFFER_INDEX 3   // Slot index bits of `shared`
+#define TRIPLE_BUFFER_FRESH 4   // Set when the shared slot was published but not acquired
+
+void triple_buffer_init(TripleBuffer *tb, void *a, void *b, void *c) {
+    tb->slots[0] = a;
+    tb->slots[1] = b;
+    tb->slots[2] = c;
+    tb->front = 0;
+    tb->back = 1;
+    atomic_init(&tb->shared, 2);
+}
+
+void *triple_buffer_back(const TripleBuffer *tb) {
+    return tb->slots[tb->back];
+}
+
+void triple_buffer_publish(TripleBuffer *tb) {
+    // Release makes the slot's contents visible before the consumer can take it
+    int old = atomic_exchange_explicit(&tb->shared, tb->back | TRIPLE_BUFFER_FRESH,
+                                       memory_order_acq_rel);
+    tb->back = old & TRIPLE_BUFFER_INDEX;
+}
+
+int triple_buffer_acquire(TripleBuffer *tb) {
+    if (!(atomic_load_explicit(&tb->shared, memory_order_relaxed) & TRIPLE_BUFFER_FRESH)) {
+        return 0;
+    }
+
+    // Acquire pairs with the publish that filled the slot we take
+    int old = atomic_exchange_explicit(&tb->shared, tb->front, memory_order_acq_rel);
+    tb->front = old & TRIPLE_BUFFER_INDEX;
+    return 1;
+}
+
+void *triple_buffer_front(const TripleBuffer *tb) {
+    return tb->slots[tb->front];
+}
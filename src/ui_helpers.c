@@ -2,11 +2,14 @@
 #include "text_sdl.h"
 #include <string.h>
 
+unsigned int ui_draw_calls = 0;
+
 void ui_draw_filled_rect(SDL_Renderer *ren, int x, int y, int w, int h, int r, int g, int b)
 {
     SDL_Rect rect = {x, y, w, h};
     SDL_SetRenderDrawColor(ren, r, g, b, 255);
     SDL_RenderFillRect(ren, &rect);
+    ui_draw_calls++;
 }
 
 void ui_draw_filled_rect_alpha(SDL_Renderer *ren, int x, int y, int w, int h, int r, int g, int b, int a)
@@ -14,6 +17,7 @@ void ui_draw_filled_rect_alpha(SDL_Renderer *ren, int x, int y, int w, int h, in
     SDL_Rect rect = {x, y, w, h};
     SDL_SetRenderDrawColor(ren, r, g, b, a);
     SDL_RenderFillRect(ren, &rect);
+    ui_draw_calls++;
 }
 
 void ui_draw_filled_rect_with_outline(SDL_Renderer *ren, int x, int y, int w, int h, int r, int g, int b)
@@ -23,11 +27,13 @@ void ui_draw_filled_rect_with_outline(SDL_Renderer *ren, int x, int y, int w, in
     // Draw black outline
     SDL_SetRenderDrawColor(ren, 0, 0, 0, 255);
     SDL_RenderDrawRect(ren, &rect);
+    ui_draw_calls++;
 
     // Draw filled rect (slightly inset to show outline)
     SDL_Rect inner_rect = {x + 1, y + 1, w - 2, h - 2};
     SDL_SetRenderDrawColor(ren, r, g, b, 255);
     SDL_RenderFillRect(ren, &inner_rect);
+    ui_draw_calls++;
 }
 
 void ui_draw_text_centered(SDL_Renderer *ren, TextRenderer *text, int cx, int y, const char *str)
@@ -18,6 +18,15 @@
 
 static void compute_layout(UiSdl *ui, const Board *board, int *out_origin_x, int *out_origin_y)
 {
+    // Same window and board as last time: same layout
+    if (ui->layout_w == ui->w && ui->layout_h == ui->h &&
+        ui->layout_board_w == board->width && ui->layout_board_h == board->height)
+    {
+        *out_origin_x = ui->layout_ox;
+        *out_origin_y = ui->layout_oy;
+        return;
+    }
+
     // Draw a board with 1-cell border, but in pixels
     int board_cells_w = board->width + BOARD_BORDER_CELLS;
     int board_cells_h = board->height + BOARD_BORDER_CELLS;
@@ -42,6 +51,13 @@ static void compute_layout(UiSdl *ui, const Board *board, int *out_origin_x, int
         *out_origin_x = ui->pad;
     if (*out_origin_y < ui->pad + TOP_OFFSET)
         *out_origin_y = ui->pad + TOP_OFFSET;
+
+    ui->layout_w = ui->w;
+    ui->layout_h = ui->h;
+    ui->layout_board_w = board->width;
+    ui->layout_board_h = board->height;
+    ui->layout_ox = *out_origin_x;
+    ui->layout_oy = *out_origin_y;
 }
 
 static SDL_Rect cell_rect(UiSdl *ui, int origin_x, int origin_y, int cx, int cy)
@@ -54,9 +70,356 @@ static SDL_Rect cell_rect(UiSdl *ui, int origin_x, int origin_y, int cx, int cy)
     return r;
 }
 
+// Pixel origin of a cell `alpha` of the way from cell `from` to cell `to`
+static void lerp_cell_px(UiSdl *ui, int origin_x, int origin_y, Vec2 from, Vec2 to, float alpha,
+                         int *out_x, int *out_y)
+{
+    *out_x = origin_x + (1 + from.x) * ui->cell + (int)((float)((to.x - from.x) * ui->cell) * alpha);
+    *out_y = origin_y + (1 + from.y) * ui->cell + (int)((float)((to.y - from.y) * ui->cell) * alpha);
+}
+
+// Queue the board background and its 1-cell border on ui->draw
+static void queue_board(UiSdl *ui, int origin_x, int origin_y, const Board *board)
+{
+    const SDL_Color bg = {COLOR_BG_BOARD_R, COLOR_BG_BOARD_G, COLOR_BG_BOARD_B, 255};
+    const SDL_Color border = {COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B, 255};
+    int w = (board->width + 2) * ui->cell;
+    int h = (board->height + 2) * ui->cell;
+
+    draw_list_rect(&ui->draw, origin_x, origin_y, w, h, bg);
+    draw_list_rect(&ui->draw, origin_x, origin_y, w, ui->cell, border);
+    draw_list_rect(&ui->draw, origin_x, origin_y + (board->height + 1) * ui->cell, w, ui->cell, border);
+    draw_list_rect(&ui->draw, origin_x, origin_y, ui->cell, h, border);
+    draw_list_rect(&ui->draw, origin_x + (board->width + 1) * ui->cell, origin_y, ui->cell, h, border);
+}
+
+// The board layer for the current cell size and `board`, rendered now if
+// it is missing or was drawn for another size. NULL if the renderer cannot
+// draw into textures.
+static SDL_Texture *board_layer(UiSdl *ui, const Board *board)
+{
+    // A copy costs the software renderer more than the fills it replaces
+    if (!ui->target_textures || ui->software)
+        return NULL;
+
+    // Target texture contents are gone after a device reset
+    int resets = SDL_AtomicGet(&ui->target_resets);
+    if (ui->board_layer && ui->board_layer_cell == ui->cell && ui->board_layer_resets == resets &&
+        ui->board_layer_w == board->width && ui->board_layer_h == board->height)
+        return ui->board_layer;
+
+    if (ui->board_layer)
+    {
+        SDL_DestroyTexture(ui->board_layer);
+        ui->board_layer = NULL;
+    }
+
+    int w = (board->width + 2) * ui->cell;
+    int h = (board->height + 2) * ui->cell;
+    ui->board_layer = SDL_CreateTexture(ui->ren, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, w, h);
+    if (!ui->board_layer)
+        return NULL;
+    // Opaque: copying it replaces pixels without blending
+    SDL_SetTextureBlendMode(ui->board_layer, SDL_BLENDMODE_NONE);
+
+    // Draw into it without disturbing the caller's target (the world texture)
+    SDL_Texture *target = SDL_GetRenderTarget(ui->ren);
+    SDL_SetRenderTarget(ui->ren, ui->board_layer);
+    queue_board(ui, 0, 0, board);
+    draw_list_flush(&ui->draw);
+    SDL_SetRenderTarget(ui->ren, target);
+
+    ui->board_layer_cell = ui->cell;
+    ui->board_layer_resets = resets;
+    ui->board_layer_w = board->width;
+    ui->board_layer_h = board->height;
+    return ui->board_layer;
+}
+
+// Draw the board background and its 1-cell border: one copy of the cached
+// board layer, or quads queued on ui->draw without target texture support.
+// Call before queueing anything that goes over the board.
+static void draw_board(UiSdl *ui, int origin_x, int origin_y, const Board *board)
+{
+    SDL_Texture *layer = board_layer(ui, board);
+    if (!layer)
+    {
+        queue_board(ui, origin_x, origin_y, board);
+        return;
+    }
+
+    SDL_Rect dst = {origin_x, origin_y, (board->width + 2) * ui->cell, (board->height + 2) * ui->cell};
+    draw_list_flush(&ui->draw);
+    SDL_RenderCopy(ui->ren, layer, NULL, &dst);
+    ui_draw_calls++;
+}
+
+// Queue a food cell on ui->draw
+static void draw_food(UiSdl *ui, int origin_x, int origin_y, Vec2 food)
+{
+    const SDL_Color c = {COLOR_FOOD_R, COLOR_FOOD_G, COLOR_FOOD_B, 255};
+    draw_list_rect(&ui->draw, origin_x + (1 + food.x) * ui->cell, origin_y + (1 + food.y) * ui->cell,
+                   ui->cell, ui->cell, c);
+}
+
+// Draw a snake. If it stepped on the last tick and `interpolate` is set, the
+// head slides in from the previous head cell and the tail slides out of the
+// cell it left, `alpha` of the way; the body in between stays on its cells.
+// The cells are queued on ui->draw.
+static void draw_snake(UiSdl *ui, int origin_x, int origin_y, const Snake *snake,
+                       int interpolate, float alpha, SDL_Color head, SDL_Color body)
+{
+    int lerp = interpolate && snake->moved && snake->length > 1;
+
+    // Tail to head so the head is drawn over the segment it is leaving
+    for (int i = snake->length - 1; i >= 0; i--)
+    {
+        Vec2 seg = snake_segment(snake, i);
+        Vec2 from = seg;
+        if (lerp && i == 0)
+            from = snake_segment(snake, 1);
+        else if (lerp && i == snake->length - 1)
+            from = snake->prev_tail;
+
+        int cell_x, cell_y;
+        lerp_cell_px(ui, origin_x, origin_y, from, seg, alpha, &cell_x, &cell_y);
+
+        SDL_Color c = i == 0 ? head : body;
+        draw_list_rect_outlined(&ui->draw, cell_x, cell_y, ui->cell, ui->cell, c);
+    }
+}
+
+// world_target at the window's current size, recreated after a resize
+static SDL_Texture *world_target_sized(UiSdl *ui)
+{
+    int w, h;
+    if (!ui->world_target)
+        return NULL;
+    if (SDL_QueryTexture(ui->world_target, NULL, NULL, &w, &h) == 0 && w == ui->w && h == ui->h)
+        return ui->world_target;
+
+    SDL_Texture *tex = SDL_CreateTexture(ui->ren, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, ui->w, ui->h);
+    if (!tex)
+        return ui->world_target; // Keep drawing into the old size, stretched
+    SDL_SetTextureBlendMode(tex, SDL_BLENDMODE_NONE);
+    SDL_DestroyTexture(ui->world_target);
+    ui->world_target = tex;
+    dirty_grid_invalidate(&ui->world_cells);
+    return tex;
+}
+
+// Queues what lies on the board (food, snakes) on ui->draw
+typedef void (*WorldItemsFn)(UiSdl *ui, const void *state, int origin_x, int origin_y, float alpha);
+
+// Draw the world: background, board and what `items` queues on it. When
+// drawing into world_target in incremental mode, only the board cells that
+// changed since the last frame are repainted; any other time (first frame,
+// new layout, lost target) everything is drawn.
+static void draw_world_layer(UiSdl *ui, const Board *board, WorldItemsFn items, const void *state, float alpha)
+{
+    int ox, oy;
+    compute_layout(ui, board, &ox, &oy);
+
+    int resets = SDL_AtomicGet(&ui->target_resets);
+    int incremental = ui->incremental && ui->world_target &&
+                      SDL_GetRenderTarget(ui->ren) == ui->world_target;
+    if (incremental &&
+        dirty_grid_begin(&ui->world_cells, ox + ui->cell, oy + ui->cell, ui->cell, board->width, board->height) &&
+        ui->world_resets == resets)
+    {
+        const SDL_Color bg = {COLOR_BG_BOARD_R, COLOR_BG_BOARD_G, COLOR_BG_BOARD_B, 255};
+        items(ui, state, ox, oy, alpha);
+        if (dirty_grid_repaint(&ui->world_cells, &ui->draw, bg))
+        {
+            draw_list_flush(&ui->draw);
+            return;
+        }
+        draw_list_clear(&ui->draw);
+    }
+
+    SET_COLOR_BG_DARK(ui->ren);
+    SDL_RenderClear(ui->ren);
+    draw_board(ui, ox, oy, board);
+    items(ui, state, ox, oy, alpha);
+    if (incremental)
+    {
+        dirty_grid_record(&ui->world_cells, &ui->draw);
+        ui->world_resets = resets;
+    }
+    draw_list_flush(&ui->draw);
+}
+
+// Screens that only change on input. A frame of one is drawn and presented
+// only when the screen or its cursor changed or an event arrived since the
+// last present; live screens (gameplay, lobby, countdown) present every frame.
+typedef enum
+{
+    UI_SCREEN_LIVE = 0,
+    UI_SCREEN_MENU,
+    UI_SCREEN_OPTIONS,
+    UI_SCREEN_OPTIONS_MENU,
+    UI_SCREEN_KEYBIND_PLAYER_SELECT,
+    UI_SCREEN_KEYBIND_PROMPT,
+    UI_SCREEN_SOUND_SETTINGS,
+    UI_SCREEN_GAME_OVER,
+    UI_SCREEN_ONLINE_MENU,
+    UI_SCREEN_HOST_SETUP,
+    UI_SCREEN_JOIN_SELECT,
+    UI_SCREEN_PAUSE_MENU,
+    UI_SCREEN_PAUSE_OPTIONS,
+    UI_SCREEN_NAME_INPUT,
+    UI_SCREEN_SCOREBOARD,
+    UI_SCREEN_SESSION_INPUT
+} UiScreen;
+
+// Event watch: runs as each event is queued, before any poll loop sees it
+static int SDLCALL ui_sdl_on_event(void *userdata, SDL_Event *e)
+{
+    UiSdl *ui = (UiSdl *)userdata;
+    if (e->type != SDL_MOUSEMOTION)
+        SDL_AtomicSet(&ui->events_pending, 1);
+    if (e->type == SDL_RENDER_TARGETS_RESET || e->type == SDL_RENDER_DEVICE_RESET)
+        SDL_AtomicAdd(&ui->target_resets, 1);
+    return 0;
+}
+
+static int ui_sdl_frame_needed(UiSdl *ui, UiScreen screen, int state)
+{
+    int events = SDL_AtomicSet(&ui->events_pending, 0);
+    return events || screen == UI_SCREEN_LIVE || screen != (UiScreen)ui->shown_screen ||
+           state != ui->shown_state;
+}
+
+static float ui_sdl_elapsed_ms(Uint64 from, Uint64 to)
+{
+    return (float)((double)(to - from) * 1000.0 / (double)SDL_GetPerformanceFrequency());
+}
+
+static void ui_sdl_present_screen(UiSdl *ui, UiScreen screen, int state)
+{
+    ui->shown_screen = (int)screen;
+    ui->shown_state = state;
+
+    Uint64 present_begin = SDL_GetPerformanceCounter();
+    SDL_RenderPresent(ui->ren);
+    Uint64 present_end = SDL_GetPerformanceCounter();
+
+    if (ui->perf)
+    {
+        PerfStats *perf = ui->perf;
+        if (ui->frame_begin)
+            perf_series_add(&perf->series[PERF_RENDER], ui_sdl_elapsed_ms(ui->frame_begin, present_begin));
+        perf_series_add(&perf->series[PERF_PRESENT], ui_sdl_elapsed_ms(present_begin, present_end));
+        if (ui->last_present)
+            perf_series_add(&perf->series[PERF_FRAME], ui_sdl_elapsed_ms(ui->last_present, present_end));
+        perf->draw_calls = ui_draw_calls;
+    }
+    ui->frame_begin = 0;
+    ui->last_present = present_end;
+    ui_draw_calls = 0;
+}
+
 // ---- public API ----
 
-UiSdl *ui_sdl_create(const char *title, int window_w, int window_h)
+void ui_sdl_present(UiSdl *ui)
+{
+    ui_sdl_present_screen(ui, UI_SCREEN_LIVE, 0);
+}
+
+void ui_sdl_wait_event(unsigned int timeout_ms)
+{
+    // Peek only: the event stays queued for the screen's own poll loop
+    if (timeout_ms > 0)
+        SDL_WaitEventTimeout(NULL, (int)timeout_ms);
+}
+
+void ui_sdl_set_latency_overlay(UiSdl *ui, const LatencyChannel *ch)
+{
+    ui->latency = ch;
+}
+
+void ui_sdl_set_incremental(UiSdl *ui, int on)
+{
+    ui->incremental = on;
+    dirty_grid_invalidate(&ui->world_cells);
+}
+
+void ui_sdl_set_perf_overlay(UiSdl *ui, PerfStats *perf)
+{
+    ui->perf = perf;
+}
+
+// Two lines of latency percentiles, the bottom one ending at `bottom_y`
+static void ui_sdl_draw_latency(UiSdl *ui, int x, int bottom_y)
+{
+    const LatencyChannel *ch = ui->latency;
+    if (!ch || !ui->text_ok)
+        return;
+
+    const LatencyHistogram *tick = &ch->stages[LATENCY_STAGE_TICK];
+    const LatencyHistogram *present = &ch->stages[LATENCY_STAGE_PRESENT];
+    char line[96];
+
+    snprintf(line, sizeof(line), "Key>tick %u/%u/%u ms",
+             latency_histogram_percentile(tick, 50), latency_histogram_percentile(tick, 95),
+             latency_histogram_percentile(tick, 99));
+    text_draw(ui->ren, &ui->text, x, bottom_y - 22, line);
+
+    snprintf(line, sizeof(line), "Key>screen %u/%u/%u ms",
+             latency_histogram_percentile(present, 50), latency_histogram_percentile(present, 95),
+             latency_histogram_percentile(present, 99));
+    text_draw(ui->ren, &ui->text, x, bottom_y, line);
+}
+
+// Rolling graphs of the frame timings plus draw call and network counters,
+// PERF_HUD_WIDTH wide from (x, y) down
+static void ui_sdl_draw_perf(UiSdl *ui, int x, int y)
+{
+    static const char *names[PERF_SERIES_COUNT] = {"Frame", "Tick late", "Render", "Present", "Audio"};
+    const PerfStats *perf = ui->perf;
+    if (!perf || !ui->text_ok)
+        return;
+
+    SDL_SetRenderDrawBlendMode(ui->ren, SDL_BLENDMODE_BLEND);
+    char line[96];
+    for (int i = 0; i < PERF_SERIES_COUNT; i++)
+    {
+        const PerfSeries *s = &perf->series[i];
+        float avg, max;
+        perf_series_summary(s, &avg, &max);
+        snprintf(line, sizeof(line), "%s %.1f ms (avg %.1f, max %.1f)", names[i], perf_series_last(s), avg, max);
+        text_draw(ui->ren, &ui->text, x, y, line);
+        y += 20;
+
+        ui_draw_filled_rect_alpha(ui->ren, x, y, PERF_HUD_WIDTH, PERF_HUD_GRAPH_HEIGHT, 0, 0, 0, 160);
+
+        // Newest sample at the right edge
+        SDL_Point points[PERF_HISTORY];
+        unsigned int n = perf_series_size(s);
+        for (unsigned int k = 0; k < n; k++)
+        {
+            float v = perf_series_at(s, k) / PERF_HUD_GRAPH_MS;
+            if (v > 1.0f)
+                v = 1.0f;
+            points[k].x = x + PERF_HUD_WIDTH - 1 - (int)k * (PERF_HUD_WIDTH / PERF_HISTORY);
+            points[k].y = y + PERF_HUD_GRAPH_HEIGHT - 1 - (int)(v * (float)(PERF_HUD_GRAPH_HEIGHT - 1));
+        }
+        if (n > 1)
+        {
+            SDL_SetRenderDrawColor(ui->ren, COLOR_TEXT_R, COLOR_TEXT_G, COLOR_TEXT_B, 255);
+            SDL_RenderDrawLines(ui->ren, points, (int)n);
+            ui_draw_calls++;
+        }
+        y += PERF_HUD_GRAPH_HEIGHT + 6;
+    }
+
+    snprintf(line, sizeof(line), "Draw calls %u", perf->draw_calls);
+    text_draw(ui->ren, &ui->text, x, y, line);
+    snprintf(line, sizeof(line), "Net %.0f out / %.0f in msg/s", perf->sent_per_s, perf->received_per_s);
+    text_draw(ui->ren, &ui->text, x, y + 22, line);
+}
+
+UiSdl *ui_sdl_create(const char *title, int window_w, int window_h, int vsync)
 {
     if (SDL_Init(SDL_INIT_VIDEO | SDL_INIT_TIMER) != 0)
     {
@@ -96,7 +459,16 @@ UiSdl *ui_sdl_create(const char *title, int window_w, int window_h)
 
     SDL_SetWindowTitle(ui->win, "Snake");
 
-    ui->ren = SDL_CreateRenderer(ui->win, -1, SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC);
+    Uint32 renderer_flags = SDL_RENDERER_ACCELERATED;
+    if (vsync)
+        renderer_flags |= SDL_RENDERER_PRESENTVSYNC;
+    ui->ren = SDL_CreateRenderer(ui->win, -1, renderer_flags);
+    if (!ui->ren)
+    {
+        // No GPU renderer (common under WSL2 and in VMs): draw with the CPU
+        fprintf(stderr, "No accelerated renderer (%s), falling back to software\n", SDL_GetError());
+        ui->ren = SDL_CreateRenderer(ui->win, -1, SDL_RENDERER_SOFTWARE);
+    }
     if (!ui->ren)
     {
         fprintf(stderr, "SDL_CreateRenderer failed: %s\n", SDL_GetError());
@@ -105,6 +477,8 @@ UiSdl *ui_sdl_create(const char *title, int window_w, int window_h)
         SDL_Quit();
         return NULL;
     }
+    draw_list_init(&ui->draw, ui->ren);
+    dirty_grid_init(&ui->world_cells);
     ui->text_ok = 0;
     if (text_init(&ui->text, "assets/fonts/BBHBogle-Regular.ttf", DEFAULT_FONT_SIZE))
     {
@@ -116,12 +490,33 @@ UiSdl *ui_sdl_create(const char *title, int window_w, int window_h)
     }
     SDL_RendererInfo info;
     SDL_GetRendererInfo(ui->ren, &info);
+    ui->vsync = (info.flags & SDL_RENDERER_PRESENTVSYNC) != 0;
+
+    // The software renderer gets its own pipeline: unblended rect fills
+    // (memsets) for the board, glyph blits, span-filled effects and no
+    // board layer texture, where its triangle and line rasterizers are slow
+    ui->software = (info.flags & SDL_RENDERER_SOFTWARE) != 0;
+    ui->draw.fill_rects = ui->software;
+    ui->text.copy_glyphs = ui->software;
+    fprintf(stderr, "Renderer: %s%s\n", info.name, ui->software ? " (software pipeline)" : "");
+
+    SDL_DisplayMode mode;
+    ui->refresh_hz = 0;
+    if (SDL_GetCurrentDisplayMode(SDL_GetWindowDisplayIndex(ui->win), &mode) == 0)
+        ui->refresh_hz = mode.refresh_rate;
+
+    ui->shown_screen = UI_SCREEN_LIVE;
+    SDL_AtomicSet(&ui->events_pending, 1);
+    SDL_AddEventWatch(ui_sdl_on_event, ui);
 
     ui->world_target = NULL;
     ui->fx_last_frame_ms = 0;
     speedfx_init(&ui->speedfx, ui->w, ui->h);
 
-    if (info.flags & SDL_RENDERER_TARGETTEXTURE)
+    ui->target_textures = (info.flags & SDL_RENDERER_TARGETTEXTURE) != 0;
+    // Without a GPU every repainted pixel costs CPU time
+    ui->incremental = ui->software;
+    if (ui->target_textures)
     {
         ui->world_target = SDL_CreateTexture(
             ui->ren,
@@ -131,7 +526,8 @@ UiSdl *ui_sdl_create(const char *title, int window_w, int window_h)
             ui->h);
         if (ui->world_target)
         {
-            SDL_SetTextureBlendMode(ui->world_target, SDL_BLENDMODE_BLEND);
+            // Always cleared to an opaque color: copy it without blending
+            SDL_SetTextureBlendMode(ui->world_target, SDL_BLENDMODE_NONE);
         }
     }
     return ui;
@@ -141,12 +537,17 @@ void ui_sdl_destroy(UiSdl *ui)
 {
     if (!ui)
         return;
+    SDL_DelEventWatch(ui_sdl_on_event, ui);
+    if (ui->board_layer)
+        SDL_DestroyTexture(ui->board_layer);
     if (ui->ren)
         SDL_DestroyRenderer(ui->ren);
     if (ui->win)
         SDL_DestroyWindow(ui->win);
     if (ui->text_ok)
         text_shutdown(&ui->text);
+    draw_list_free(&ui->draw);
+    dirty_grid_free(&ui->world_cells);
     if (ui->world_target)
     {
         SDL_DestroyTexture(ui->world_target);
@@ -158,9 +559,8 @@ void ui_sdl_destroy(UiSdl *ui)
     SDL_Quit();
 }
 
-int ui_sdl_poll(UiSdl *ui, const Settings *settings, int *out_has_dir, Direction *out_dir, int *out_pause)
+int ui_sdl_poll(UiSdl *ui, const Settings *settings, InputBuffer *input, int *out_pause)
 {
-    *out_has_dir = 0;
     *out_pause = 0;
 
     SDL_Event e;
@@ -180,29 +580,26 @@ int ui_sdl_poll(UiSdl *ui, const Settings *settings, int *out_has_dir, Direction
                 break;
             }
 
-            // Check dynamic directional bindings for Player 1
+            // Check dynamic directional bindings for Player 1; every press
+            // is queued with its event time so quick turns are not lost
             int action = settings_find_action(settings, key);
-            if (action >= 0)
+            switch (action)
             {
-                *out_has_dir = 1;
-                switch (action)
-                {
-                case SETTING_ACTION_UP:
-                    *out_dir = DIR_UP;
-                    break;
-                case SETTING_ACTION_DOWN:
-                    *out_dir = DIR_DOWN;
-                    break;
-                case SETTING_ACTION_LEFT:
-                    *out_dir = DIR_LEFT;
-                    break;
-                case SETTING_ACTION_RIGHT:
-                    *out_dir = DIR_RIGHT;
-                    break;
-                case SETTING_ACTION_USE:
-                    // Future functionality
-                    break;
-                }
+            case SETTING_ACTION_UP:
+                input_buffer_push(input, DIR_UP, e.key.timestamp);
+                break;
+            case SETTING_ACTION_DOWN:
+                input_buffer_push(input, DIR_DOWN, e.key.timestamp);
+                break;
+            case SETTING_ACTION_LEFT:
+                input_buffer_push(input, DIR_LEFT, e.key.timestamp);
+                break;
+            case SETTING_ACTION_RIGHT:
+                input_buffer_push(input, DIR_RIGHT, e.key.timestamp);
+                break;
+            case SETTING_ACTION_USE:
+                // Future functionality
+                break;
             }
         }
     }
@@ -210,54 +607,21 @@ int ui_sdl_poll(UiSdl *ui, const Settings *settings, int *out_has_dir, Direction
     SDL_GetWindowSize(ui->win, &ui->w, &ui->h);
     return 1;
 }
-static void ui_sdl_draw_world(UiSdl *ui, const Game *g)
+static void queue_game_items(UiSdl *ui, const void *state, int ox, int oy, float alpha)
 {
-    int ox, oy;
-    compute_layout(ui, &g->board, &ox, &oy);
+    const Game *g = (const Game *)state;
 
-    // background clear
-    SET_COLOR_BG_DARK(ui->ren);
-    SDL_RenderClear(ui->ren);
+    draw_food(ui, ox, oy, g->board.food);
 
-    // board area background
-    SDL_Rect board_bg = cell_rect(ui, ox, oy, 0, 0);
-    board_bg.w = (g->board.width + 2) * ui->cell;
-    board_bg.h = (g->board.height + 2) * ui->cell;
-
-    ui_draw_filled_rect(ui->ren, board_bg.x, board_bg.y, board_bg.w, board_bg.h,
-                        COLOR_BG_BOARD_R, COLOR_BG_BOARD_G, COLOR_BG_BOARD_B);
-
-    // border (1 cell thick)
-    ui_draw_filled_rect(ui->ren, ox, oy, (g->board.width + 2) * ui->cell, ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-    ui_draw_filled_rect(ui->ren, ox, oy + (g->board.height + 1) * ui->cell,
-                        (g->board.width + 2) * ui->cell, ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-    ui_draw_filled_rect(ui->ren, ox, oy, ui->cell, (g->board.height + 2) * ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-    ui_draw_filled_rect(ui->ren, ox + (g->board.width + 1) * ui->cell, oy,
-                        ui->cell, (g->board.height + 2) * ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-
-    // Food
-    ui_draw_filled_rect(ui->ren, ox + (1 + g->board.food.x) * ui->cell,
-                        oy + (1 + g->board.food.y) * ui->cell,
-                        ui->cell, ui->cell, COLOR_FOOD_R, COLOR_FOOD_G, COLOR_FOOD_B);
-
-    // Snake segments
-    for (int i = 0; i < g->snake.length; ++i)
-    {
-        Vec2 seg = g->snake.segments[i];
-        int cell_x = ox + (1 + seg.x) * ui->cell;
-        int cell_y = oy + (1 + seg.y) * ui->cell;
-
-        if (i == 0)
-            ui_draw_filled_rect_with_outline(ui->ren, cell_x, cell_y, ui->cell, ui->cell,
-                                             COLOR_SNAKE_HEAD_R, COLOR_SNAKE_HEAD_G, COLOR_SNAKE_HEAD_B);
-        else
-            ui_draw_filled_rect_with_outline(ui->ren, cell_x, cell_y, ui->cell, ui->cell,
-                                             COLOR_SNAKE_BODY_R, COLOR_SNAKE_BODY_G, COLOR_SNAKE_BODY_B);
-    }
+    // Snake segments (only a running snake moves between ticks)
+    SDL_Color head = {COLOR_SNAKE_HEAD_R, COLOR_SNAKE_HEAD_G, COLOR_SNAKE_HEAD_B, 255};
+    SDL_Color body = {COLOR_SNAKE_BODY_R, COLOR_SNAKE_BODY_G, COLOR_SNAKE_BODY_B, 255};
+    draw_snake(ui, ox, oy, &g->snake, g->state == GAME_RUNNING, alpha, head, body);
+}
+static void ui_sdl_draw_world(UiSdl *ui, const Game *g, float alpha)
+{
+    // board with its 1-cell border, food and snake: one batch
+    draw_world_layer(ui, &g->board, queue_game_items, g, alpha);
 }
 static void ui_sdl_draw_hud(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms)
 {
@@ -269,7 +633,7 @@ static void ui_sdl_draw_hud(UiSdl *ui, const Game *g, const char *player_name, i
     float hx = 0.0f, hy = 0.0f;
     if (g->snake.length > 0)
     {
-        Vec2 head = g->snake.segments[0];
+        Vec2 head = snake_head(&g->snake);
         hx = (float)(ox + (1 + head.x) * ui->cell + ui->cell * 0.5f);
         hy = (float)(oy + (1 + head.y) * ui->cell + ui->cell * 0.5f);
     }
@@ -301,6 +665,9 @@ static void ui_sdl_draw_hud(UiSdl *ui, const Game *g, const char *player_name, i
             snprintf(debug_combo, sizeof(debug_combo), "Combo Window: %d ticks", combo_window_ticks);
             text_draw(ui->ren, &ui->text, debug_x, debug_y + 22, debug_combo);
         }
+        // p50/p95/p99 above the debug lines (--latency)
+        ui_sdl_draw_latency(ui, ui->w - 250, ui->h - 72);
+        ui_sdl_draw_perf(ui, ui->w - PERF_HUD_WIDTH - 10, 10);
         int tier = game_get_combo_tier(g->combo_count);
 
         // Combo display
@@ -339,36 +706,32 @@ static void ui_sdl_draw_hud(UiSdl *ui, const Game *g, const char *player_name, i
                 float time_total = (float)g->combo_window_ms;
                 float fill_ratio = time_remaining / time_total;
 
-                ui_draw_filled_rect(ui->ren, bar_x, bar_y, bar_width, COMBO_BAR_HEIGHT,
-                                    COLOR_COMBO_BG_R, COLOR_COMBO_BG_G, COLOR_COMBO_BG_B);
+                const SDL_Color bar_bg = {COLOR_COMBO_BG_R, COLOR_COMBO_BG_G, COLOR_COMBO_BG_B, 255};
+                const SDL_Color bar_border = {COLOR_TEXT_R, COLOR_TEXT_G, COLOR_TEXT_B, 255};
+                SDL_Color bar_fill;
 
                 int fill_width = (int)(bar_width * fill_ratio);
 
                 if (tier >= 7)
-                    ui_draw_filled_rect(ui->ren, bar_x, bar_y, fill_width, COMBO_BAR_HEIGHT,
-                                        COLOR_COMBO_T7_R, COLOR_COMBO_T7_G, COLOR_COMBO_T7_B);
+                    bar_fill = (SDL_Color){COLOR_COMBO_T7_R, COLOR_COMBO_T7_G, COLOR_COMBO_T7_B, 255};
                 else if (tier >= 6)
-                    ui_draw_filled_rect(ui->ren, bar_x, bar_y, fill_width, COMBO_BAR_HEIGHT,
-                                        COLOR_COMBO_T6_R, COLOR_COMBO_T6_G, COLOR_COMBO_T6_B);
+                    bar_fill = (SDL_Color){COLOR_COMBO_T6_R, COLOR_COMBO_T6_G, COLOR_COMBO_T6_B, 255};
                 else if (tier >= 5)
-                    ui_draw_filled_rect(ui->ren, bar_x, bar_y, fill_width, COMBO_BAR_HEIGHT,
-                                        COLOR_COMBO_T5_R, COLOR_COMBO_T5_G, COLOR_COMBO_T5_B);
+                    bar_fill = (SDL_Color){COLOR_COMBO_T5_R, COLOR_COMBO_T5_G, COLOR_COMBO_T5_B, 255};
                 else if (tier >= 4)
-                    ui_draw_filled_rect(ui->ren, bar_x, bar_y, fill_width, COMBO_BAR_HEIGHT,
-                                        COLOR_COMBO_T4_R, COLOR_COMBO_T4_G, COLOR_COMBO_T4_B);
+                    bar_fill = (SDL_Color){COLOR_COMBO_T4_R, COLOR_COMBO_T4_G, COLOR_COMBO_T4_B, 255};
                 else if (tier >= 3)
-                    ui_draw_filled_rect(ui->ren, bar_x, bar_y, fill_width, COMBO_BAR_HEIGHT,
-                                        COLOR_COMBO_T3_R, COLOR_COMBO_T3_G, COLOR_COMBO_T3_B);
+                    bar_fill = (SDL_Color){COLOR_COMBO_T3_R, COLOR_COMBO_T3_G, COLOR_COMBO_T3_B, 255};
                 else if (tier >= 2)
-                    ui_draw_filled_rect(ui->ren, bar_x, bar_y, fill_width, COMBO_BAR_HEIGHT,
-                                        COLOR_COMBO_T2_R, COLOR_COMBO_T2_G, COLOR_COMBO_T2_B);
+                    bar_fill = (SDL_Color){COLOR_COMBO_T2_R, COLOR_COMBO_T2_G, COLOR_COMBO_T2_B, 255};
                 else
-                    ui_draw_filled_rect(ui->ren, bar_x, bar_y, fill_width, COMBO_BAR_HEIGHT,
-                                        COLOR_COMBO_T1_R, COLOR_COMBO_T1_G, COLOR_COMBO_T1_B);
+                    bar_fill = (SDL_Color){COLOR_COMBO_T1_R, COLOR_COMBO_T1_G, COLOR_COMBO_T1_B, 255};
 
-                SDL_Rect bg_rect = {bar_x, bar_y, bar_width, COMBO_BAR_HEIGHT};
-                SDL_SetRenderDrawColor(ui->ren, COLOR_TEXT_R, COLOR_TEXT_G, COLOR_TEXT_B, 255);
-                SDL_RenderDrawRect(ui->ren, &bg_rect);
+                // Background, fill and outline in one batch
+                draw_list_rect(&ui->draw, bar_x, bar_y, bar_width, COMBO_BAR_HEIGHT, bar_bg);
+                draw_list_rect(&ui->draw, bar_x, bar_y, fill_width, COMBO_BAR_HEIGHT, bar_fill);
+                draw_list_outline(&ui->draw, bar_x, bar_y, bar_width, COMBO_BAR_HEIGHT, bar_border);
+                draw_list_flush(&ui->draw);
             }
             char combo_text[32];
             snprintf(combo_text, sizeof(combo_text), "COMBO x%d", g->combo_count);
@@ -400,12 +763,15 @@ static void ui_sdl_draw_hud(UiSdl *ui, const Game *g, const char *player_name, i
         int cx = board_bg.x + board_bg.w / 2;
         int cy = board_bg.y + board_bg.h / 2;
 
-        text_draw_center(ui->ren, &ui->text, cx, cy - 20, "GAME OVER");
+        text_draw_center(ui->ren, &ui->text, cx, cy - 20, g->won ? "YOU WIN" : "GAME OVER");
         text_draw_center(ui->ren, &ui->text, cx, cy + 15, "ESC: Back to menu");
     }
 }
-void ui_sdl_render(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms)
+// Draw a full game frame (world, effects, HUD) without presenting it
+static void ui_sdl_draw_frame(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms, float alpha)
 {
+    ui->frame_begin = SDL_GetPerformanceCounter();
+
     // dt
     unsigned int now = (unsigned int)SDL_GetTicks();
     float dt = 1.0f / 60.0f;
@@ -421,50 +787,12 @@ void ui_sdl_render(UiSdl *ui, const Game *g, const char *player_name, int debug_
 
     speedfx_set_viewport(&ui->speedfx, ui->w, ui->h);
 
-    // Compute snake head origin in screen coords (for particle spawn)
-    float origin_x = 0.0f, origin_y = 0.0f;
-    {
-        int ox, oy;
-        compute_layout(ui, &g->board, &ox, &oy);
-        if (g->snake.length > 0)
-        {
-            Vec2 head = g->snake.segments[0];
-            origin_x = (float)(ox + (1 + head.x) * ui->cell + ui->cell * 0.5f);
-            origin_y = (float)(oy + (1 + head.y) * ui->cell + ui->cell * 0.5f);
-        }
-        else
-        {
-            origin_x = (float)(ui->w / 2);
-            origin_y = (float)(ui->h / 2);
-        }
-    }
-
-    // Compute board rect in screen coords (matches your board_bg)
-    SDL_Rect board_rect;
-    {
-        int ox, oy;
-        compute_layout(ui, &g->board, &ox, &oy);
-
-        SDL_Rect board_bg = cell_rect(ui, ox, oy, 0, 0);
-        board_bg.w = (g->board.width + 2) * ui->cell;
-        board_bg.h = (g->board.height + 2) * ui->cell;
-        board_rect = board_bg;
-    }
-
-    SDL_Rect head_cell = {0, 0, 0, 0};
-    {
-        int ox, oy;
-        compute_layout(ui, &g->board, &ox, &oy);
-
-        if (g->snake.length > 0)
-        {
-            Vec2 head = g->snake.segments[0];
-            head_cell.x = ox + (1 + head.x) * ui->cell;
-            head_cell.y = oy + (1 + head.y) * ui->cell;
-            head_cell.w = ui->cell;
-            head_cell.h = ui->cell;
-        }
-    }
+    // Board rect in screen coords (matches board_bg)
+    int ox, oy;
+    compute_layout(ui, &g->board, &ox, &oy);
+    SDL_Rect board_rect = cell_rect(ui, ox, oy, 0, 0);
+    board_rect.w = (g->board.width + 2) * ui->cell;
+    board_rect.h = (g->board.height + 2) * ui->cell;
 
     speedfx_update(
         &ui->speedfx,
@@ -475,40 +803,57 @@ void ui_sdl_render(UiSdl *ui, const Game *g, const char *player_name, int debug_
         board_rect);
 
     // Render world to texture if supported; otherwise render directly
-    if (ui->world_target)
+    if (world_target_sized(ui))
     {
         SDL_SetRenderTarget(ui->ren, ui->world_target);
-        ui_sdl_draw_world(ui, g);
+        ui_sdl_draw_world(ui, g, alpha);
 
         SDL_SetRenderTarget(ui->ren, NULL);
 
-        // Clear window
-        SDL_SetRenderDrawBlendMode(ui->ren, SDL_BLENDMODE_BLEND);
-        SDL_SetRenderDrawColor(ui->ren, 0, 0, 0, 255);
-        SDL_RenderClear(ui->ren);
-
         // Copy world with shake offset (translation only)
         SDL_Rect dst = {0, 0, ui->w, ui->h};
         speedfx_apply_shake_rect(&ui->speedfx, &dst);
+
+        // Clear window, unless the copy covers all of it
+        SDL_SetRenderDrawBlendMode(ui->ren, SDL_BLENDMODE_BLEND);
+        if (dst.x != 0 || dst.y != 0)
+        {
+            SDL_SetRenderDrawColor(ui->ren, 0, 0, 0, 255);
+            SDL_RenderClear(ui->ren);
+        }
         SDL_RenderCopy(ui->ren, ui->world_target, NULL, &dst);
+        ui_draw_calls++;
     }
     else
     {
         // Fallback: no target texture support.
         // We draw the world normally (no global shake in this path).
         // If you want shake here too, you must add offsets to all drawing calls.
-        ui_sdl_draw_world(ui, g);
+        ui_sdl_draw_world(ui, g, alpha);
     }
 
     // FX overlays on top
-    speedfx_render_particles(ui->ren, &ui->speedfx);
-    speedfx_render_rings(ui->ren, &ui->speedfx,
-                         COLOR_SNAKE_HEAD_R, COLOR_SNAKE_HEAD_G, COLOR_SNAKE_HEAD_B);
+    if (ui->software)
+    {
+        speedfx_render_particles_batched(ui->ren, &ui->speedfx);
+        speedfx_render_rings_spans(ui->ren, &ui->speedfx,
+                                   COLOR_SNAKE_HEAD_R, COLOR_SNAKE_HEAD_G, COLOR_SNAKE_HEAD_B);
+    }
+    else
+    {
+        speedfx_render_particles(ui->ren, &ui->speedfx);
+        speedfx_render_rings(ui->ren, &ui->speedfx,
+                             COLOR_SNAKE_HEAD_R, COLOR_SNAKE_HEAD_G, COLOR_SNAKE_HEAD_B);
+    }
 
     // HUD should be stable (not shaken)
     ui_sdl_draw_hud(ui, g, player_name, debug_mode, current_tick_ms);
+}
 
-    SDL_RenderPresent(ui->ren);
+void ui_sdl_render(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms, float alpha)
+{
+    ui_sdl_draw_frame(ui, g, player_name, debug_mode, current_tick_ms, alpha);
+    ui_sdl_present(ui);
 }
 
 int ui_sdl_get_name(UiSdl *ui, char *out_name, int out_size, int show_game_over)
@@ -579,6 +924,13 @@ int ui_sdl_get_name(UiSdl *ui, char *out_name, int out_size, int show_game_over)
 
         /* -------- Rendering -------- */
 
+        if (!running || !ui_sdl_frame_needed(ui, UI_SCREEN_NAME_INPUT, len))
+        {
+            if (running)
+                ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
+            continue;
+        }
+
         SET_COLOR_BG_MENU(ui->ren);
         SDL_RenderClear(ui->ren);
 
@@ -597,6 +949,7 @@ int ui_sdl_get_name(UiSdl *ui, char *out_name, int out_size, int show_game_over)
 
         SDL_SetRenderDrawColor(ui->ren, COLOR_TEXT_R, COLOR_TEXT_G, COLOR_TEXT_B, 255);
         SDL_RenderDrawRect(ui->ren, &box);
+        ui_draw_calls++;
 
         // Text
         if (show_game_over)
@@ -625,9 +978,7 @@ int ui_sdl_get_name(UiSdl *ui, char *out_name, int out_size, int show_game_over)
         ui_draw_text_centered(ui->ren, &ui->text, cx, box.y + box.h - 30,
                               "Enter = OK    Esc = Cancel");
 
-        SDL_RenderPresent(ui->ren);
-
-        SDL_Delay(16); // ~60 FPS
+        ui_sdl_present_screen(ui, UI_SCREEN_NAME_INPUT, len);
     }
 
     SDL_StopTextInput();
@@ -659,6 +1010,13 @@ void ui_sdl_show_scoreboard(UiSdl *ui, const Scoreboard *sb)
             }
         }
 
+        if (!running || !ui_sdl_frame_needed(ui, UI_SCREEN_SCOREBOARD, 0))
+        {
+            if (running)
+                ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
+            continue;
+        }
+
         SET_COLOR_BG_MENU(ui->ren);
         SDL_RenderClear(ui->ren);
 
@@ -687,8 +1045,7 @@ void ui_sdl_show_scoreboard(UiSdl *ui, const Scoreboard *sb)
             }
         }
 
-        SDL_RenderPresent(ui->ren);
-        SDL_Delay(16);
+        ui_sdl_present_screen(ui, UI_SCREEN_SCOREBOARD, 0);
     }
 }
 
@@ -734,6 +1091,9 @@ UiMenuAction ui_sdl_poll_menu(UiSdl *ui, const Settings *settings, int *out_quit
 
 void ui_sdl_render_menu(UiSdl *ui, const Settings *settings, int selected_index)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_MENU, selected_index))
+        return;
+
     SET_COLOR_BG_MENU(ui->ren);
     SDL_RenderClear(ui->ren);
 
@@ -765,11 +1125,14 @@ void ui_sdl_render_menu(UiSdl *ui, const Settings *settings, int selected_index)
         ui_draw_text_centered(ui->ren, &ui->text, center_x, ui->h - 40, instructions);
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_MENU, selected_index);
 }
 
 void ui_sdl_render_options(UiSdl *ui)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_OPTIONS, 0))
+        return;
+
     SET_COLOR_BG_MENU(ui->ren);
     SDL_RenderClear(ui->ren);
 
@@ -781,7 +1144,7 @@ void ui_sdl_render_options(UiSdl *ui)
         ui_draw_text_centered(ui->ren, &ui->text, cx, ui->h - 40, "ESC = Back to menu");
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_OPTIONS, 0);
 }
 
 UiPauseAction ui_sdl_poll_pause(UiSdl *ui, const Settings *settings, int *out_quit)
@@ -824,10 +1187,13 @@ UiPauseAction ui_sdl_poll_pause(UiSdl *ui, const Settings *settings, int *out_qu
     return UI_PAUSE_NONE;
 }
 
-void ui_sdl_render_pause_menu(UiSdl *ui, const Game *g, const char *player_name, int selected_index, int debug_mode, unsigned int current_tick_ms)
+void ui_sdl_render_pause_menu(UiSdl *ui, const Game *g, const char *player_name, int selected_index, int debug_mode, unsigned int current_tick_ms, float alpha)
 {
-    // Render the game frame behind the pause overlay
-    ui_sdl_render(ui, g, player_name, debug_mode, current_tick_ms);
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_PAUSE_MENU, selected_index))
+        return;
+
+    // Draw the game frame behind the pause overlay
+    ui_sdl_draw_frame(ui, g, player_name, debug_mode, current_tick_ms, alpha);
 
     // Draw a semi-transparent overlay
     SDL_SetRenderDrawBlendMode(ui->ren, SDL_BLENDMODE_BLEND);
@@ -845,6 +1211,7 @@ void ui_sdl_render_pause_menu(UiSdl *ui, const Game *g, const char *player_name,
 
     SDL_SetRenderDrawColor(ui->ren, COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B, 255);
     SDL_RenderDrawRect(ui->ren, &box);
+    ui_draw_calls++;
 
     if (ui->text_ok)
     {
@@ -861,13 +1228,16 @@ void ui_sdl_render_pause_menu(UiSdl *ui, const Game *g, const char *player_name,
         ui_draw_text_centered(ui->ren, &ui->text, cx, box.y + 4 * yseg, "UP/DOWN + ENTER");
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_PAUSE_MENU, selected_index);
 }
 
-void ui_sdl_render_pause_options(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms)
+void ui_sdl_render_pause_options(UiSdl *ui, const Game *g, const char *player_name, int debug_mode, unsigned int current_tick_ms, float alpha)
 {
-    // render the game behind
-    ui_sdl_render(ui, g, player_name, debug_mode, current_tick_ms);
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_PAUSE_OPTIONS, 0))
+        return;
+
+    // Draw the game behind
+    ui_sdl_draw_frame(ui, g, player_name, debug_mode, current_tick_ms, alpha);
 
     SDL_SetRenderDrawBlendMode(ui->ren, SDL_BLENDMODE_BLEND);
     ui_draw_filled_rect_alpha(ui->ren, 0, 0, ui->w, ui->h, 0, 0, 0, 170);
@@ -882,6 +1252,7 @@ void ui_sdl_render_pause_options(UiSdl *ui, const Game *g, const char *player_na
                         COLOR_BG_BOARD_R, COLOR_BG_BOARD_G, COLOR_BG_BOARD_B);
     SDL_SetRenderDrawColor(ui->ren, COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B, 255);
     SDL_RenderDrawRect(ui->ren, &box);
+    ui_draw_calls++;
 
     if (ui->text_ok)
     {
@@ -893,13 +1264,16 @@ void ui_sdl_render_pause_options(UiSdl *ui, const Game *g, const char *player_na
         ui_draw_text_centered(ui->ren, &ui->text, cx, box.y + 4 * yseg, "ESC = Back");
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_PAUSE_OPTIONS, 0);
 }
 
 // ==== New Keybindings UI Functions ====
 
 void ui_sdl_render_options_menu(UiSdl *ui, const Settings *settings, int selected_index)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_OPTIONS_MENU, selected_index))
+        return;
+
     SET_COLOR_BG_MENU(ui->ren);
     SDL_RenderClear(ui->ren);
 
@@ -926,7 +1300,7 @@ void ui_sdl_render_options_menu(UiSdl *ui, const Settings *settings, int selecte
         ui_draw_text_centered(ui->ren, &ui->text, cx, ui->h - 40, instructions);
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_OPTIONS_MENU, selected_index);
 }
 
 UiMenuAction ui_sdl_poll_options_menu(UiSdl *ui, const Settings *settings, int *out_quit)
@@ -970,6 +1344,9 @@ UiMenuAction ui_sdl_poll_options_menu(UiSdl *ui, const Settings *settings, int *
 
 void ui_sdl_render_keybind_player_select(UiSdl *ui, const Settings *settings, int selected_index)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_KEYBIND_PLAYER_SELECT, selected_index))
+        return;
+
     SET_COLOR_BG_MENU(ui->ren);
     SDL_RenderClear(ui->ren);
 
@@ -996,7 +1373,7 @@ void ui_sdl_render_keybind_player_select(UiSdl *ui, const Settings *settings, in
         ui_draw_text_centered(ui->ren, &ui->text, cx, ui->h - 40, instructions);
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_KEYBIND_PLAYER_SELECT, selected_index);
 }
 
 UiMenuAction ui_sdl_poll_keybind_player_select(UiSdl *ui, const Settings *settings, int *out_quit)
@@ -1040,12 +1417,15 @@ UiMenuAction ui_sdl_poll_keybind_player_select(UiSdl *ui, const Settings *settin
 
 void ui_sdl_render_keybind_prompt(UiSdl *ui, const Settings *settings, SettingAction action)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_KEYBIND_PROMPT, (int)action))
+        return;
+
     SET_COLOR_BG_MENU(ui->ren);
     SDL_RenderClear(ui->ren);
 
     if (!ui->text_ok)
     {
-        SDL_RenderPresent(ui->ren);
+        ui_sdl_present_screen(ui, UI_SCREEN_KEYBIND_PROMPT, (int)action);
         return;
     }
 
@@ -1096,7 +1476,7 @@ void ui_sdl_render_keybind_prompt(UiSdl *ui, const Settings *settings, SettingAc
     // Cancel hint
     ui_draw_text_centered(ui->ren, &ui->text, cx, ui->h - 40, "ESC = Cancel");
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_KEYBIND_PROMPT, (int)action);
 }
 
 SDL_Keycode ui_sdl_poll_keybind_input(UiSdl *ui, int *out_cancel, int *out_quit)
@@ -1146,6 +1526,9 @@ SDL_Keycode ui_sdl_poll_keybind_input(UiSdl *ui, int *out_cancel, int *out_quit)
 
 void ui_sdl_render_sound_settings(UiSdl *ui, const Settings *settings, const AudioSdl *audio, int selected_index)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_SOUND_SETTINGS, selected_index))
+        return;
+
     SDL_SetRenderDrawColor(ui->ren, 10, 10, 12, 255);
     SDL_RenderClear(ui->ren);
 
@@ -1224,7 +1607,7 @@ void ui_sdl_render_sound_settings(UiSdl *ui, const Settings *settings, const Aud
         text_draw_center(ui->ren, &ui->text, cx, ui->h - 30, instructions2);
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_SOUND_SETTINGS, selected_index);
 }
 
 UiMenuAction ui_sdl_poll_sound_settings(UiSdl *ui, const Settings *settings, int *out_quit)
@@ -1270,8 +1653,11 @@ UiMenuAction ui_sdl_poll_sound_settings(UiSdl *ui, const Settings *settings, int
     return UI_MENU_NONE;
 }
 
-void ui_sdl_render_game_over(UiSdl *ui, int score, int fruits, int time_seconds, int combo_best, const Scoreboard *sb, int selected_index)
+void ui_sdl_render_game_over(UiSdl *ui, int score, int fruits, int time_seconds, int combo_best, int won, const Scoreboard *sb, int selected_index)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_GAME_OVER, selected_index))
+        return;
+
     SET_COLOR_BG_MENU(ui->ren);
     SDL_RenderClear(ui->ren);
 
@@ -1282,7 +1668,7 @@ void ui_sdl_render_game_over(UiSdl *ui, int score, int fruits, int time_seconds,
         int y = ui->h / 2 - 150;
 
         // Title
-        ui_draw_text_centered(ui->ren, &ui->text, cx, y, "GAME OVER");
+        ui_draw_text_centered(ui->ren, &ui->text, cx, y, won ? "YOU WIN" : "GAME OVER");
         y += 60;
 
         // Stats
@@ -1338,7 +1724,7 @@ void ui_sdl_render_game_over(UiSdl *ui, int score, int fruits, int time_seconds,
         }
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_GAME_OVER, selected_index);
 }
 
 UiMenuAction ui_sdl_poll_game_over(UiSdl *ui, const Settings *settings, int *out_quit)
@@ -1381,28 +1767,31 @@ UiMenuAction ui_sdl_poll_game_over(UiSdl *ui, const Settings *settings, int *out
 #include "online_multiplayer.h"
 
 // Helper functions for text rendering with colors (simplified)
-static void text_sdl_draw_centered(TextRenderer text, SDL_Renderer *ren, const char *msg,
+static void text_sdl_draw_centered(TextRenderer *text, SDL_Renderer *ren, const char *msg,
                                    int x, int y, float scale, int r, int g, int b)
 {
     (void)scale;
     (void)r;
     (void)g;
     (void)b; // Ignore for now
-    text_draw_center(ren, &text, x, y, msg);
+    text_draw_center(ren, text, x, y, msg);
 }
 
-static void text_sdl_draw(TextRenderer text, SDL_Renderer *ren, const char *msg,
+static void text_sdl_draw(TextRenderer *text, SDL_Renderer *ren, const char *msg,
                           int x, int y, float scale, int r, int g, int b)
 {
     (void)scale;
     (void)r;
     (void)g;
     (void)b; // Ignore for now
-    text_draw(ren, &text, x, y, msg);
+    text_draw(ren, text, x, y, msg);
 }
 
 void ui_sdl_render_multiplayer_online_menu(UiSdl *ui, int selected_index)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_ONLINE_MENU, selected_index))
+        return;
+
     SDL_SetRenderDrawColor(ui->ren, 0, 0, 0, 255);
     SDL_RenderClear(ui->ren);
 
@@ -1411,7 +1800,7 @@ void ui_sdl_render_multiplayer_online_menu(UiSdl *ui, int selected_index)
     int option_count = 3;
 
     // Draw title
-    text_sdl_draw_centered(ui->text, ui->ren, title, ui->w / 2, ui->h / 4, 1.5f, 255, 255, 255);
+    text_sdl_draw_centered(&ui->text, ui->ren, title, ui->w / 2, ui->h / 4, 1.5f, 255, 255, 255);
 
     // Draw options
     for (int i = 0; i < option_count; i++)
@@ -1424,15 +1813,15 @@ void ui_sdl_render_multiplayer_online_menu(UiSdl *ui, int selected_index)
         {
             char indicator[128];
             snprintf(indicator, sizeof(indicator), "> %s <", options[i]);
-            text_sdl_draw_centered(ui->text, ui->ren, indicator, ui->w / 2, y, 1.0f, 255, 255, 0);
+            text_sdl_draw_centered(&ui->text, ui->ren, indicator, ui->w / 2, y, 1.0f, 255, 255, 0);
         }
         else
         {
-            text_sdl_draw_centered(ui->text, ui->ren, options[i], ui->w / 2, y, 1.0f, 180, 180, 180);
+            text_sdl_draw_centered(&ui->text, ui->ren, options[i], ui->w / 2, y, 1.0f, 180, 180, 180);
         }
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_ONLINE_MENU, selected_index);
 }
 
 UiMenuAction ui_sdl_poll_multiplayer_online_menu(UiSdl *ui, int *out_quit)
@@ -1463,6 +1852,9 @@ UiMenuAction ui_sdl_poll_multiplayer_online_menu(UiSdl *ui, int *out_quit)
 
 void ui_sdl_render_host_setup(UiSdl *ui, int selected_index)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_HOST_SETUP, selected_index))
+        return;
+
     SDL_SetRenderDrawColor(ui->ren, 0, 0, 0, 255);
     SDL_RenderClear(ui->ren);
 
@@ -1471,8 +1863,8 @@ void ui_sdl_render_host_setup(UiSdl *ui, int selected_index)
     const char *options[] = {"Yes", "No"};
     int option_count = 2;
 
-    text_sdl_draw_centered(ui->text, ui->ren, title, ui->w / 2, ui->h / 4, 1.5f, 255, 255, 255);
-    text_sdl_draw_centered(ui->text, ui->ren, prompt, ui->w / 2, ui->h / 3, 1.0f, 200, 200, 200);
+    text_sdl_draw_centered(&ui->text, ui->ren, title, ui->w / 2, ui->h / 4, 1.5f, 255, 255, 255);
+    text_sdl_draw_centered(&ui->text, ui->ren, prompt, ui->w / 2, ui->h / 3, 1.0f, 200, 200, 200);
 
     for (int i = 0; i < option_count; i++)
     {
@@ -1484,15 +1876,15 @@ void ui_sdl_render_host_setup(UiSdl *ui, int selected_index)
         {
             char indicator[128];
             snprintf(indicator, sizeof(indicator), "> %s <", options[i]);
-            text_sdl_draw_centered(ui->text, ui->ren, indicator, ui->w / 2, y, 1.0f, 255, 255, 0);
+            text_sdl_draw_centered(&ui->text, ui->ren, indicator, ui->w / 2, y, 1.0f, 255, 255, 0);
         }
         else
         {
-            text_sdl_draw_centered(ui->text, ui->ren, options[i], ui->w / 2, y, 1.0f, 180, 180, 180);
+            text_sdl_draw_centered(&ui->text, ui->ren, options[i], ui->w / 2, y, 1.0f, 180, 180, 180);
         }
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_HOST_SETUP, selected_index);
 }
 
 UiMenuAction ui_sdl_poll_host_setup(UiSdl *ui, int *out_quit)
@@ -1523,6 +1915,9 @@ UiMenuAction ui_sdl_poll_host_setup(UiSdl *ui, int *out_quit)
 
 void ui_sdl_render_join_select(UiSdl *ui, int selected_index)
 {
+    if (!ui_sdl_frame_needed(ui, UI_SCREEN_JOIN_SELECT, selected_index))
+        return;
+
     SDL_SetRenderDrawColor(ui->ren, 0, 0, 0, 255);
     SDL_RenderClear(ui->ren);
 
@@ -1531,8 +1926,8 @@ void ui_sdl_render_join_select(UiSdl *ui, int selected_index)
     const char *options[] = {"Public", "Private"};
     int option_count = 2;
 
-    text_sdl_draw_centered(ui->text, ui->ren, title, ui->w / 2, ui->h / 4, 1.5f, 255, 255, 255);
-    text_sdl_draw_centered(ui->text, ui->ren, prompt, ui->w / 2, ui->h / 3, 1.0f, 200, 200, 200);
+    text_sdl_draw_centered(&ui->text, ui->ren, title, ui->w / 2, ui->h / 4, 1.5f, 255, 255, 255);
+    text_sdl_draw_centered(&ui->text, ui->ren, prompt, ui->w / 2, ui->h / 3, 1.0f, 200, 200, 200);
 
     for (int i = 0; i < option_count; i++)
     {
@@ -1543,15 +1938,15 @@ void ui_sdl_render_join_select(UiSdl *ui, int selected_index)
         {
             char indicator[128];
             snprintf(indicator, sizeof(indicator), "> %s <", options[i]);
-            text_sdl_draw_centered(ui->text, ui->ren, indicator, ui->w / 2, y, 1.0f, 255, 255, 0);
+            text_sdl_draw_centered(&ui->text, ui->ren, indicator, ui->w / 2, y, 1.0f, 255, 255, 0);
         }
         else
         {
-            text_sdl_draw_centered(ui->text, ui->ren, options[i], ui->w / 2, y, 1.0f, 180, 180, 180);
+            text_sdl_draw_centered(&ui->text, ui->ren, options[i], ui->w / 2, y, 1.0f, 180, 180, 180);
         }
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present_screen(ui, UI_SCREEN_JOIN_SELECT, selected_index);
 }
 
 UiMenuAction ui_sdl_poll_join_select(UiSdl *ui, int *out_quit)
@@ -1586,12 +1981,12 @@ void ui_sdl_render_lobby_browser(UiSdl *ui, json_t *lobby_list, int selected_ind
     SDL_RenderClear(ui->ren);
 
     const char *title = "Public Lobbies";
-    text_sdl_draw_centered(ui->text, ui->ren, title, ui->w / 2, 50, 1.5f, 255, 255, 255);
+    text_sdl_draw_centered(&ui->text, ui->ren, title, ui->w / 2, 50, 1.5f, 255, 255, 255);
 
     if (!lobby_list || json_array_size(lobby_list) == 0)
     {
-        text_sdl_draw_centered(ui->text, ui->ren, "No public lobbies available", ui->w / 2, ui->h / 2, 1.0f, 180, 180, 180);
-        text_sdl_draw_centered(ui->text, ui->ren, "Press ESC to go back", ui->w / 2, ui->h / 2 + 40, 0.8f, 150, 150, 150);
+        text_sdl_draw_centered(&ui->text, ui->ren, "No public lobbies available", ui->w / 2, ui->h / 2, 1.0f, 180, 180, 180);
+        text_sdl_draw_centered(&ui->text, ui->ren, "Press ESC to go back", ui->w / 2, ui->h / 2 + 40, 0.8f, 150, 150, 150);
     }
     else
     {
@@ -1619,18 +2014,18 @@ void ui_sdl_render_lobby_browser(UiSdl *ui, json_t *lobby_list, int selected_ind
             {
                 char indicator[300];
                 snprintf(indicator, sizeof(indicator), "> %s <", lobby_text);
-                text_sdl_draw_centered(ui->text, ui->ren, indicator, ui->w / 2, y, 0.9f, 255, 255, 0);
+                text_sdl_draw_centered(&ui->text, ui->ren, indicator, ui->w / 2, y, 0.9f, 255, 255, 0);
             }
             else
             {
-                text_sdl_draw_centered(ui->text, ui->ren, lobby_text, ui->w / 2, y, 0.9f, 180, 180, 180);
+                text_sdl_draw_centered(&ui->text, ui->ren, lobby_text, ui->w / 2, y, 0.9f, 180, 180, 180);
             }
         }
 
-        text_sdl_draw_centered(ui->text, ui->ren, "ENTER to join | ESC to go back", ui->w / 2, ui->h - 50, 0.8f, 150, 150, 150);
+        text_sdl_draw_centered(&ui->text, ui->ren, "ENTER to join | ESC to go back", ui->w / 2, ui->h - 50, 0.8f, 150, 150, 150);
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present(ui);
 }
 
 UiMenuAction ui_sdl_poll_lobby_browser(UiSdl *ui, int *out_quit)
@@ -1664,10 +2059,10 @@ void ui_sdl_render_error(UiSdl *ui, const char *message)
     SDL_SetRenderDrawColor(ui->ren, 40, 0, 0, 255);
     SDL_RenderClear(ui->ren);
 
-    text_sdl_draw_centered(ui->text, ui->ren, "Error", ui->w / 2, ui->h / 3, 1.5f, 255, 100, 100);
-    text_sdl_draw_centered(ui->text, ui->ren, message, ui->w / 2, ui->h / 2, 1.0f, 255, 200, 200);
+    text_sdl_draw_centered(&ui->text, ui->ren, "Error", ui->w / 2, ui->h / 3, 1.5f, 255, 100, 100);
+    text_sdl_draw_centered(&ui->text, ui->ren, message, ui->w / 2, ui->h / 2, 1.0f, 255, 200, 200);
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present(ui);
 }
 
 int ui_sdl_get_session_id(UiSdl *ui, char *out_session_id, int out_size)
@@ -1726,21 +2121,27 @@ int ui_sdl_get_session_id(UiSdl *ui, char *out_session_id, int out_size)
             }
         }
 
+        if (done || !ui_sdl_frame_needed(ui, UI_SCREEN_SESSION_INPUT, cursor))
+        {
+            if (!done)
+                ui_sdl_wait_event(MENU_IDLE_WAIT_MS);
+            continue;
+        }
+
         // Render
         SDL_SetRenderDrawColor(ui->ren, 0, 0, 0, 255);
         SDL_RenderClear(ui->ren);
 
-        text_sdl_draw_centered(ui->text, ui->ren, "Join Game", ui->w / 2, ui->h / 4, 1.5f, 255, 255, 255);
-        text_sdl_draw_centered(ui->text, ui->ren, "Enter Session ID (6 characters):", ui->w / 2, ui->h / 3, 1.0f, 200, 200, 200);
+        text_sdl_draw_centered(&ui->text, ui->ren, "Join Game", ui->w / 2, ui->h / 4, 1.5f, 255, 255, 255);
+        text_sdl_draw_centered(&ui->text, ui->ren, "Enter Session ID (6 characters):", ui->w / 2, ui->h / 3, 1.0f, 200, 200, 200);
 
         char display[32];
         snprintf(display, sizeof(display), "> %s_", buffer);
-        text_sdl_draw_centered(ui->text, ui->ren, display, ui->w / 2, ui->h / 2, 1.2f, 255, 255, 0);
+        text_sdl_draw_centered(&ui->text, ui->ren, display, ui->w / 2, ui->h / 2, 1.2f, 255, 255, 0);
 
-        text_sdl_draw_centered(ui->text, ui->ren, "Press ENTER when done, ESC to cancel", ui->w / 2, ui->h * 3 / 4, 0.8f, 150, 150, 150);
+        text_sdl_draw_centered(&ui->text, ui->ren, "Press ENTER when done, ESC to cancel", ui->w / 2, ui->h * 3 / 4, 0.8f, 150, 150, 150);
 
-        SDL_RenderPresent(ui->ren);
-        SDL_Delay(16);
+        ui_sdl_present_screen(ui, UI_SCREEN_SESSION_INPUT, cursor);
     }
 
     SDL_StopTextInput();
@@ -1761,33 +2162,12 @@ void ui_sdl_render_online_lobby(UiSdl *ui, const OnlineMultiplayerContext *ctx)
     int ox, oy;
     compute_layout(ui, &mg->board, &ox, &oy);
 
-    int board_w = mg->board.width;
-    int board_h = mg->board.height;
-
     // Background
     SET_COLOR_BG_DARK(ui->ren);
     SDL_RenderClear(ui->ren);
 
-    // Board background
-    SDL_Rect board_bg;
-    board_bg.x = ox;
-    board_bg.y = oy;
-    board_bg.w = (board_w + 2) * ui->cell;
-    board_bg.h = (board_h + 2) * ui->cell;
-    ui_draw_filled_rect(ui->ren, board_bg.x, board_bg.y, board_bg.w, board_bg.h,
-                        COLOR_BG_BOARD_R, COLOR_BG_BOARD_G, COLOR_BG_BOARD_B);
-
-    // White border frame
-    ui_draw_filled_rect(ui->ren, ox, oy, (board_w + 2) * ui->cell, ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-    ui_draw_filled_rect(ui->ren, ox, oy + (board_h + 1) * ui->cell,
-                        (board_w + 2) * ui->cell, ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-    ui_draw_filled_rect(ui->ren, ox, oy, ui->cell, (board_h + 2) * ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-    ui_draw_filled_rect(ui->ren, ox + (board_w + 1) * ui->cell, oy,
-                        ui->cell, (board_h + 2) * ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
+    // Board with white border frame, queued with the snakes below
+    draw_board(ui, ox, oy, &mg->board);
 
     // Player colors (head, body)
     typedef struct
@@ -1813,21 +2193,21 @@ void ui_sdl_render_online_lobby(UiSdl *ui, const OnlineMultiplayerContext *ctx)
 
         for (int i = 0; i < snake->length; i++)
         {
-            int cell_x = ox + (1 + snake->segments[i].x) * ui->cell;
-            int cell_y = oy + (1 + snake->segments[i].y) * ui->cell;
+            Vec2 seg = snake_segment(snake, i);
+            int cell_x = ox + (1 + seg.x) * ui->cell;
+            int cell_y = oy + (1 + seg.y) * ui->cell;
 
             if (i == 0)
             {
-                ui_draw_filled_rect_with_outline(ui->ren, cell_x, cell_y, ui->cell, ui->cell,
-                                                 colors.head.r, colors.head.g, colors.head.b);
+                draw_list_rect_outlined(&ui->draw, cell_x, cell_y, ui->cell, ui->cell, colors.head);
             }
             else
             {
-                ui_draw_filled_rect_with_outline(ui->ren, cell_x, cell_y, ui->cell, ui->cell,
-                                                 colors.body.r, colors.body.g, colors.body.b);
+                draw_list_rect_outlined(&ui->draw, cell_x, cell_y, ui->cell, ui->cell, colors.body);
             }
         }
     }
+    draw_list_flush(&ui->draw);
 
     // HUD - show player lobby status
     if (ui->text_ok)
@@ -1886,7 +2266,7 @@ void ui_sdl_render_online_lobby(UiSdl *ui, const OnlineMultiplayerContext *ctx)
         text_draw_center(ui->ren, &ui->text, ui->w / 2, ui->h / 2 - 30, hint);
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present(ui);
 }
 
 UiMenuAction ui_sdl_poll_online_lobby(UiSdl *ui, const Settings *settings, int *out_quit)
@@ -1922,33 +2302,12 @@ void ui_sdl_render_online_countdown(UiSdl *ui, const OnlineMultiplayerContext *c
     int ox, oy;
     compute_layout(ui, &mg->board, &ox, &oy);
 
-    int board_w = mg->board.width;
-    int board_h = mg->board.height;
-
     // Background
     SET_COLOR_BG_DARK(ui->ren);
     SDL_RenderClear(ui->ren);
 
-    // Board background
-    SDL_Rect board_bg;
-    board_bg.x = ox;
-    board_bg.y = oy;
-    board_bg.w = (board_w + 2) * ui->cell;
-    board_bg.h = (board_h + 2) * ui->cell;
-    ui_draw_filled_rect(ui->ren, board_bg.x, board_bg.y, board_bg.w, board_bg.h,
-                        COLOR_BG_BOARD_R, COLOR_BG_BOARD_G, COLOR_BG_BOARD_B);
-
-    // White border frame
-    ui_draw_filled_rect(ui->ren, ox, oy, (board_w + 2) * ui->cell, ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-    ui_draw_filled_rect(ui->ren, ox, oy + (board_h + 1) * ui->cell,
-                        (board_w + 2) * ui->cell, ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-    ui_draw_filled_rect(ui->ren, ox, oy, ui->cell, (board_h + 2) * ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-    ui_draw_filled_rect(ui->ren, ox + (board_w + 1) * ui->cell, oy,
-                        ui->cell, (board_h + 2) * ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
+    // Board with white border frame, queued with the snakes below
+    draw_board(ui, ox, oy, &mg->board);
 
     // Player colors
     typedef struct
@@ -1973,21 +2332,21 @@ void ui_sdl_render_online_countdown(UiSdl *ui, const OnlineMultiplayerContext *c
 
         for (int i = 0; i < snake->length; i++)
         {
-            int cell_x = ox + (1 + snake->segments[i].x) * ui->cell;
-            int cell_y = oy + (1 + snake->segments[i].y) * ui->cell;
+            Vec2 seg = snake_segment(snake, i);
+            int cell_x = ox + (1 + seg.x) * ui->cell;
+            int cell_y = oy + (1 + seg.y) * ui->cell;
 
             if (i == 0)
             {
-                ui_draw_filled_rect_with_outline(ui->ren, cell_x, cell_y, ui->cell, ui->cell,
-                                                 colors.head.r, colors.head.g, colors.head.b);
+                draw_list_rect_outlined(&ui->draw, cell_x, cell_y, ui->cell, ui->cell, colors.head);
             }
             else
             {
-                ui_draw_filled_rect_with_outline(ui->ren, cell_x, cell_y, ui->cell, ui->cell,
-                                                 colors.body.r, colors.body.g, colors.body.b);
+                draw_list_rect_outlined(&ui->draw, cell_x, cell_y, ui->cell, ui->cell, colors.body);
             }
         }
     }
+    draw_list_flush(&ui->draw);
 
     // Overlay semi-transparent background for countdown
     SDL_SetRenderDrawBlendMode(ui->ren, SDL_BLENDMODE_BLEND);
@@ -2008,70 +2367,20 @@ void ui_sdl_render_online_countdown(UiSdl *ui, const OnlineMultiplayerContext *c
         text_draw_center(ui->ren, &ui->text, ui->w / 2, ui->h / 2, countdown_text);
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present(ui);
 }
 
-void ui_sdl_render_online_game(UiSdl *ui, const OnlineMultiplayerContext *ctx)
+static void queue_online_items(UiSdl *ui, const void *state, int ox, int oy, float alpha)
 {
-    const MultiplayerGame_s *mg = ctx->game;
-
-    // Compute board layout (centered with border) - same as singleplayer
-    int ox, oy;
-    compute_layout(ui, &mg->board, &ox, &oy);
-
-    int board_w = mg->board.width;
-    int board_h = mg->board.height;
-
-    // Board bounds for mp HUD (in pixels)
-    const int pad = 10;
-    const int left = ox;
-    const int top = oy;
-    const int right = ox + (board_w + 2) * ui->cell;
-    const int bottom = oy + (board_h + 2) * ui->cell;
-
-    // Background
-    SET_COLOR_BG_DARK(ui->ren);
-    SDL_RenderClear(ui->ren);
-
-    // Board background
-    SDL_Rect board_bg;
-    board_bg.x = ox;
-    board_bg.y = oy;
-    board_bg.w = (board_w + 2) * ui->cell;
-    board_bg.h = (board_h + 2) * ui->cell;
-    ui_draw_filled_rect(ui->ren, board_bg.x, board_bg.y, board_bg.w, board_bg.h,
-                        COLOR_BG_BOARD_R, COLOR_BG_BOARD_G, COLOR_BG_BOARD_B);
-
-    // White border frame
-    // Top border
-    ui_draw_filled_rect(ui->ren, ox, oy, (board_w + 2) * ui->cell, ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-
-    // Bottom border
-    ui_draw_filled_rect(ui->ren, ox, oy + (board_h + 1) * ui->cell,
-                        (board_w + 2) * ui->cell, ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-
-    // Left border
-    ui_draw_filled_rect(ui->ren, ox, oy, ui->cell, (board_h + 2) * ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
-
-    // Right border
-    ui_draw_filled_rect(ui->ren, ox + (board_w + 1) * ui->cell, oy,
-                        ui->cell, (board_h + 2) * ui->cell,
-                        COLOR_BORDER_R, COLOR_BORDER_G, COLOR_BORDER_B);
+    const MultiplayerGame_s *mg = (const MultiplayerGame_s *)state;
 
     // Render food (orange like singleplayer)
-    ui_draw_filled_rect(ui->ren, ox + (1 + mg->board.food.x) * ui->cell,
-                        oy + (1 + mg->board.food.y) * ui->cell,
-                        ui->cell, ui->cell, COLOR_FOOD_R, COLOR_FOOD_G, COLOR_FOOD_B);
+    draw_food(ui, ox, oy, mg->board.food);
 
     // Render extra food items
     for (int i = 0; i < mg->food_count; i++)
     {
-        ui_draw_filled_rect(ui->ren, ox + (1 + mg->food[i].x) * ui->cell,
-                            oy + (1 + mg->food[i].y) * ui->cell,
-                            ui->cell, ui->cell, COLOR_FOOD_R, COLOR_FOOD_G, COLOR_FOOD_B);
+        draw_food(ui, ox, oy, mg->food[i]);
     }
 
     // Player colors (head, body)
@@ -2093,25 +2402,55 @@ void ui_sdl_render_online_game(UiSdl *ui, const OnlineMultiplayerContext *ctx)
         if (!mg->players[p].joined)
             continue;
 
-        const Snake *snake = &mg->players[p].snake;
+        // Snakes stepped by our own tick move smoothly; remote snakes are
+        // rebuilt from network updates and snap to their cells
+        const MultiplayerPlayer *player = &mg->players[p];
         PlayerColor colors = player_colors[p];
+        draw_snake(ui, ox, oy, &player->snake, player->death_state == GAME_RUNNING, alpha,
+                   colors.head, colors.body);
+    }
+}
 
-        for (int i = 0; i < snake->length; i++)
-        {
-            int cell_x = ox + (1 + snake->segments[i].x) * ui->cell;
-            int cell_y = oy + (1 + snake->segments[i].y) * ui->cell;
+void ui_sdl_render_online_game(UiSdl *ui, const OnlineMultiplayerContext *ctx, float alpha)
+{
+    const MultiplayerGame_s *mg = ctx->game;
+    ui->frame_begin = SDL_GetPerformanceCounter();
 
-            if (i == 0)
-            {
-                ui_draw_filled_rect_with_outline(ui->ren, cell_x, cell_y, ui->cell, ui->cell,
-                                                 colors.head.r, colors.head.g, colors.head.b);
-            }
-            else
-            {
-                ui_draw_filled_rect_with_outline(ui->ren, cell_x, cell_y, ui->cell, ui->cell,
-                                                 colors.body.r, colors.body.g, colors.body.b);
-            }
-        }
+    // Compute board layout (centered with border) - same as singleplayer
+    int ox, oy;
+    compute_layout(ui, &mg->board, &ox, &oy);
+
+    int board_w = mg->board.width;
+    int board_h = mg->board.height;
+
+    // Board bounds for mp HUD (in pixels)
+    const int pad = 10;
+    const int left = ox;
+    const int top = oy;
+    const int right = ox + (board_w + 2) * ui->cell;
+    const int bottom = oy + (board_h + 2) * ui->cell;
+
+    SDL_Rect board_bg;
+    board_bg.x = ox;
+    board_bg.y = oy;
+    board_bg.w = (board_w + 2) * ui->cell;
+    board_bg.h = (board_h + 2) * ui->cell;
+
+    // Background, board, white border frame, food and snakes. In incremental
+    // mode they are kept in world_target and only changed cells repainted.
+    if (ui->incremental && world_target_sized(ui))
+    {
+        SDL_SetRenderTarget(ui->ren, ui->world_target);
+        draw_world_layer(ui, &mg->board, queue_online_items, mg, alpha);
+        SDL_SetRenderTarget(ui->ren, NULL);
+
+        SDL_Rect dst = {0, 0, ui->w, ui->h};
+        SDL_RenderCopy(ui->ren, ui->world_target, NULL, &dst);
+        ui_draw_calls++;
+    }
+    else
+    {
+        draw_world_layer(ui, &mg->board, queue_online_items, mg, alpha);
     }
 
     // HUD - show player info
@@ -2190,60 +2529,64 @@ void ui_sdl_render_online_game(UiSdl *ui, const OnlineMultiplayerContext *ctx)
 
                 int filled_width = (int)(bar_width * time_remaining);
 
-                // Draw bar background (dark gray)
-                SDL_Rect bar_bg = {x, bar_y, bar_width, bar_height};
-                SDL_SetRenderDrawColor(ui->ren, 40, 40, 40, 255);
-                SDL_RenderFillRect(ui->ren, &bar_bg);
+                // Bar background (dark gray); every player's bar goes out in
+                // one batch after the loop
+                const SDL_Color bar_bg = {40, 40, 40, 255};
+                draw_list_rect(&ui->draw, x, bar_y, bar_width, bar_height, bar_bg);
 
-                // Draw filled portion (based on player color from multiplayer_game.h)
-                if (filled_width > 0)
-                {
-                    SDL_Rect bar_fill = {x, bar_y, filled_width, bar_height};
-                    SDL_SetRenderDrawColor(ui->ren, PLAYER_COLORS[p].r, PLAYER_COLORS[p].g, PLAYER_COLORS[p].b, 255);
-                    SDL_RenderFillRect(ui->ren, &bar_fill);
-                }
+                // Filled portion (based on player color from multiplayer_game.h)
+                const SDL_Color bar_fill = {PLAYER_COLORS[p].r, PLAYER_COLORS[p].g, PLAYER_COLORS[p].b, 255};
+                draw_list_rect(&ui->draw, x, bar_y, filled_width, bar_height, bar_fill);
 
-                // Draw bar border (white)
-                SDL_SetRenderDrawColor(ui->ren, 255, 255, 255, 255);
-                SDL_RenderDrawRect(ui->ren, &bar_bg);
+                // Bar border (white)
+                const SDL_Color bar_border = {255, 255, 255, 255};
+                draw_list_outline(&ui->draw, x, bar_y, bar_width, bar_height, bar_border);
             }
         }
+        draw_list_flush(&ui->draw);
 
         // Instructions at bottom
         text_draw(ui->ren, &ui->text, ox, oy + board_bg.h + 8,
                   "Use keybinds to move | ESC: quit");
+
+        ui_sdl_draw_latency(ui, ui->w - 250, ui->h - 28);
+        ui_sdl_draw_perf(ui, ui->w - PERF_HUD_WIDTH - 10, 10);
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present(ui);
 }
 
-Direction ui_sdl_poll_online_game_input(UiSdl *ui, const Settings *settings, int *out_quit)
+int ui_sdl_poll_online_game_input(UiSdl *ui, const Settings *settings, InputBuffer *input)
 {
     SDL_Event e;
     while (SDL_PollEvent(&e))
     {
         if (e.type == SDL_QUIT)
-        {
-            *out_quit = 1;
-            return DIR_UP; // Dummy
-        }
+            return 0;
+
         if (e.type == SDL_KEYDOWN)
         {
-            SDL_Keycode key = e.key.keysym.sym;
-
-            // Use Player 1's keybindings
-            int action = settings_find_action(settings, key);
-            if (action == SETTING_ACTION_UP)
-                return DIR_UP;
-            if (action == SETTING_ACTION_DOWN)
-                return DIR_DOWN;
-            if (action == SETTING_ACTION_LEFT)
-                return DIR_LEFT;
-            if (action == SETTING_ACTION_RIGHT)
-                return DIR_RIGHT;
+            // Use Player 1's keybindings; every press this frame is queued
+            // so two quick turns both reach the next ticks
+            int action = settings_find_action(settings, e.key.keysym.sym);
+            switch (action)
+            {
+            case SETTING_ACTION_UP:
+                input_buffer_push(input, DIR_UP, e.key.timestamp);
+                break;
+            case SETTING_ACTION_DOWN:
+                input_buffer_push(input, DIR_DOWN, e.key.timestamp);
+                break;
+            case SETTING_ACTION_LEFT:
+                input_buffer_push(input, DIR_LEFT, e.key.timestamp);
+                break;
+            case SETTING_ACTION_RIGHT:
+                input_buffer_push(input, DIR_RIGHT, e.key.timestamp);
+                break;
+            }
         }
     }
-    return -1; // No input
+    return 1;
 }
 
 void ui_sdl_render_online_gameover(UiSdl *ui, const OnlineMultiplayerContext *ctx)
@@ -2251,7 +2594,7 @@ void ui_sdl_render_online_gameover(UiSdl *ui, const OnlineMultiplayerContext *ct
     SDL_SetRenderDrawColor(ui->ren, 0, 0, 0, 255);
     SDL_RenderClear(ui->ren);
 
-    text_sdl_draw_centered(ui->text, ui->ren, "GAME OVER", ui->w / 2, ui->h / 4, 2.0f, 255, 0, 0);
+    text_sdl_draw_centered(&ui->text, ui->ren, "GAME OVER", ui->w / 2, ui->h / 4, 2.0f, 255, 0, 0);
 
     // Find the winner (player who is alive or has highest score)
     int winner_idx = -1;
@@ -2286,21 +2629,21 @@ void ui_sdl_render_online_gameover(UiSdl *ui, const OnlineMultiplayerContext *ct
                          ctx->game->players[i].name, name_suffix,
                          ctx->game->players[i].score, ctx->game->players[i].combo_best);
                 // Draw winner in bright gold/yellow
-                text_sdl_draw(ui->text, ui->ren, player_text, ui->w / 2 - 250, y, 1.0f, 255, 215, 0);
+                text_sdl_draw(&ui->text, ui->ren, player_text, ui->w / 2 - 250, y, 1.0f, 255, 215, 0);
             }
             else
             {
                 snprintf(player_text, sizeof(player_text), "%s%s: Score %d, Combo Best %d",
                          ctx->game->players[i].name, name_suffix,
                          ctx->game->players[i].score, ctx->game->players[i].combo_best);
-                text_sdl_draw(ui->text, ui->ren, player_text, ui->w / 2 - 200, y, 0.9f,
+                text_sdl_draw(&ui->text, ui->ren, player_text, ui->w / 2 - 200, y, 0.9f,
                               colors[i].r, colors[i].g, colors[i].b);
             }
             y += 30;
         }
     }
 
-    SDL_RenderPresent(ui->ren);
+    ui_sdl_present(ui);
 }
 
 UiMenuAction ui_sdl_poll_online_gameover(UiSdl *ui, int *out_quit)
@@ -0,0 +1,286 @@
+#include "vec_engine.h"
+#include "game.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int popcount64(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_popcountll(x);
+#else
+    int c = 0;
+    while (x) {
+        x &= x - 1;
+        c++;
+    }
+    return c;
+#endif
+}
+
+static int lowest_bit(uint64_t x) {
+#if defined(__GNUC__)
+    return __builtin_ctzll(x);
+#else
+    int b = 0;
+    while (!(x & 1)) {
+        x >>= 1;
+        b++;
+    }
+    return b;
+#endif
+}
+
+static uint64_t *plane(const VecEngine *e, int i) {
+    return e->occupancy + (size_t)i * (size_t)e->words;
+}
+
+static uint16_t *ring(const VecEngine *e, int i) {
+    return e->body + (size_t)i * (size_t)(e->ring_mask + 1);
+}
+
+static void set_bit(uint64_t *p, int cell) {
+    p[cell >> 6] |= (uint64_t)1 << (cell & 63);
+}
+
+static void clear_bit(uint64_t *p, int cell) {
+    p[cell >> 6] &= ~((uint64_t)1 << (cell & 63));
+}
+
+// Put game i's food on a uniformly random free cell: pick a rank among the
+// free cells, then find that zero bit a word (64 cells) at a time.
+// Returns 0 if the board is full.
+static int place_food(VecEngine *e, int i) {
+    int free_cells = e->cells - e->length[i];
+    if (free_cells <= 0) {
+        return 0;
+    }
+
+    int r = rng_below(&e->rng[i], free_cells);
+    const uint64_t *p = plane(e, i);
+    for (int w = 0; w < e->words; w++) {
+        uint64_t zeros = ~p[w];
+        int c = popcount64(zeros);
+        if (r < c) {
+            while (r-- > 0) {
+                zeros &= zeros - 1;
+            }
+            e->food[i] = w * 64 + lowest_bit(zeros);
+            return 1;
+        }
+        r -= c;
+    }
+    return 0;
+}
+
+int vec_engine_init(VecEngine *e, int count, int width, int height, const GameConfig *cfg) {
+    memset(e, 0, sizeof(*e));
+    if (count <= 0 || width < 2 || height < 1 || width * height > VEC_ENGINE_MAX_CELLS) {
+        return 0;
+    }
+
+    e->count = count;
+    e->width = width;
+    e->height = height;
+    e->cells = width * height;
+    e->words = (e->cells + 63) / 64;
+    e->combo_window_ticks = cfg->combo_window_ticks;
+    e->combo_window_increase_per_tier = cfg->combo_window_increase_per_tier;
+
+    int ring_size = 1;
+    while (ring_size < e->cells) {
+        ring_size <<= 1;
+    }
+    e->ring_mask = ring_size - 1;
+
+    size_t n = (size_t)count;
+    int32_t **fields[] = {
+        &e->head_x, &e->head_y, &e->dir, &e->length, &e->state, &e->won,
+        &e->score, &e->fruits_eaten, &e->combo_count, &e->combo_best,
+        &e->combo_expiry, &e->ticks, &e->food, &e->ate, &e->body_head,
+        &e->next_cell, &e->grow, &e->hit
+    };
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+        *fields[f] = calloc(n, sizeof(int32_t));
+        if (!*fields[f]) {
+            vec_engine_free(e);
+            return 0;
+        }
+    }
+
+    e->body = calloc(n * (size_t)ring_size, sizeof(uint16_t));
+    e->occupancy = calloc(n * (size_t)e->words, sizeof(uint64_t));
+    e->rng = calloc(n, sizeof(Rng));
+    if (!e->body || !e->occupancy || !e->rng) {
+        vec_engine_free(e);
+        return 0;
+    }
+
+    for (int i = 0; i < count; i++) {
+        e->state[i] = GAME_OVER;
+    }
+    return 1;
+}
+
+void vec_engine_free(VecEngine *e) {
+    int32_t *fields[] = {
+        e->head_x, e->head_y, e->dir, e->length, e->state, e->won,
+        e->score, e->fruits_eaten, e->combo_count, e->combo_best,
+        e->combo_expiry, e->ticks, e->food, e->ate, e->body_head,
+        e->next_cell, e->grow, e->hit
+    };
+    for (size_t f = 0; f < sizeof(fields) / sizeof(fields[0]); f++) {
+        free(fields[f]);
+    }
+    free(e->body);
+    free(e->occupancy);
+    free(e->rng);
+    memset(e, 0, sizeof(*e));
+}
+
+void vec_engine_reset(VecEngine *e, int i, uint64_t seed) {
+    uint64_t *p = plane(e, i);
+    memset(p, 0, (size_t)e->words * sizeof(uint64_t));
+    // Cells past the board in the last word count as taken
+    for (int cell = e->cells; cell < e->words * 64; cell++) {
+        set_bit(p, cell);
+    }
+
+    // Same spawn as game_init: head at the center, one segment behind it
+    int x = e->width / 2;
+    int y = e->height / 2;
+    uint16_t *r = ring(e, i);
+    r[0] = (uint16_t)(y * e->width + x);
+    r[1] = (uint16_t)(y * e->width + x - 1);
+    set_bit(p, r[0]);
+    set_bit(p, r[1]);
+
+    e->head_x[i] = x;
+    e->head_y[i] = y;
+    e->dir[i] = DIR_RIGHT;
+    e->length[i] = 2;
+    e->body_head[i] = 0;
+    e->state[i] = GAME_RUNNING;
+    e->won[i] = 0;
+    e->score[i] = 0;
+    e->fruits_eaten[i] = 0;
+    e->combo_count[i] = 0;
+    e->combo_best[i] = 0;
+    e->combo_expiry[i] = 0;
+    e->ticks[i] = 0;
+    e->ate[i] = 0;
+
+    rng_seed(&e->rng[i], seed);
+    // The starting snake may already fill a tiny board: won at once, as in game_init
+    if (!place_food(e, i)) {
+        e->won[i] = 1;
+        e->state[i] = GAME_OVER;
+    }
+}
+
+void vec_engine_reset_all(VecEngine *e, uint64_t seed) {
+    for (int i = 0; i < e->count; i++) {
+        vec_engine_reset(e, i, seed + (uint64_t)i);
+    }
+}
+
+void vec_engine_step(VecEngine *e, const uint8_t *actions) {
+    const int n = e->count;
+    const int32_t w = e->width;
+    const int32_t h = e->height;
+    int32_t *restrict dir = e->dir;
+    int32_t *restrict head_x = e->head_x;
+    int32_t *restrict head_y = e->head_y;
+    int32_t *restrict state = e->state;
+    int32_t *restrict ticks = e->ticks;
+    int32_t *restrict combo_count = e->combo_count;
+    int32_t *restrict combo_expiry = e->combo_expiry;
+    int32_t *restrict food = e->food;
+    int32_t *restrict ate = e->ate;
+    int32_t *restrict next_cell = e->next_cell;
+    int32_t *restrict grow = e->grow;
+    int32_t *restrict hit = e->hit;
+
+    // Pass 1 (branch-free, vectorizable): turn, combo expiry, next head
+    // cell, wall and food tests for every game
+    for (int i = 0; i < n; i++) {
+        int32_t running = state[i] == GAME_RUNNING;
+        int32_t a = actions ? actions[i] : VEC_ACTION_NONE;
+        int32_t d = dir[i];
+        // UP^DOWN and LEFT^RIGHT are both 1: that is a 180-degree turn
+        int32_t turn = running & (a < 4) & ((a ^ d) != 1);
+        d = turn ? a : d;
+        dir[i] = d;
+
+        // The combo runs out when this update reaches its expiry tick
+        int32_t t = ticks[i] + running;
+        int32_t expired = running & (combo_count[i] > 0) & (t >= combo_expiry[i]);
+        ticks[i] = t;
+        combo_count[i] = expired ? 0 : combo_count[i];
+        combo_expiry[i] = expired ? 0 : combo_expiry[i];
+
+        int32_t nx = head_x[i] + (d == DIR_RIGHT) - (d == DIR_LEFT);
+        int32_t ny = head_y[i] + (d == DIR_DOWN) - (d == DIR_UP);
+        int32_t wall = ((uint32_t)nx >= (uint32_t)w) | ((uint32_t)ny >= (uint32_t)h);
+        int32_t cell = wall ? 0 : ny * w + nx;
+
+        next_cell[i] = cell;
+        grow[i] = running & !wall & (cell == food[i]);
+        hit[i] = wall;
+        ate[i] = running ? 0 : ate[i];
+    }
+
+    // Pass 2: body collision, one bit read per game. The tail is excluded
+    // when not growing because it moves out of the way this tick.
+    for (int i = 0; i < n; i++) {
+        const uint64_t *p = plane(e, i);
+        int32_t cell = next_cell[i];
+        int32_t occupied = (int32_t)((p[cell >> 6] >> (cell & 63)) & 1);
+        int32_t tail = ring(e, i)[(e->body_head[i] + e->length[i] - 1) & e->ring_mask];
+        int32_t tail_leaves = !grow[i] & (cell == tail);
+        hit[i] |= occupied & !tail_leaves;
+    }
+
+    // Pass 3: apply moves, growth, score and food for running games
+    for (int i = 0; i < n; i++) {
+        if (state[i] != GAME_RUNNING) continue;
+
+        if (hit[i]) {
+            state[i] = GAME_OVER;
+            continue;
+        }
+
+        uint64_t *p = plane(e, i);
+        uint16_t *r = ring(e, i);
+        int32_t cell = next_cell[i];
+
+        if (!grow[i]) {
+            clear_bit(p, r[(e->body_head[i] + e->length[i] - 1) & e->ring_mask]);
+        } else {
+            e->length[i]++;
+        }
+        e->body_head[i] = (e->body_head[i] - 1) & e->ring_mask;
+        r[e->body_head[i]] = (uint16_t)cell;
+        set_bit(p, cell);
+        head_x[i] = cell % w;
+        head_y[i] = cell / w;
+
+        if (grow[i]) {
+            combo_count[i] = (combo_count[i] > 0 && combo_expiry[i] > 0) ? combo_count[i] + 1 : 1;
+            if (combo_count[i] > e->combo_best[i]) {
+                e->combo_best[i] = combo_count[i];
+            }
+
+            int tier = game_get_combo_tier(combo_count[i]);
+            combo_expiry[i] = ticks[i] + e->combo_window_ticks + (tier - 1) * e->combo_window_increase_per_tier;
+
+            e->score[i] += POINTS_PER_FOOD * game_get_combo_multiplier(combo_count[i]);
+            e->fruits_eaten[i]++;
+            ate[i] = 1;
+
+            // No free cell left: the snake covers the whole board
+            if (!place_food(e, i)) {
+                e->won[i] = 1;
+                state[i] = GAME_OVER;
+            }
+        }
+    }
+}
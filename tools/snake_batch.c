@@ -0,0 +1,500 @@
+// Batch simulator for balancing: plays many bot games per GameConfig
+// parameter set on all cores and writes score, combo and duration
+// distributions as CSV, one row per parameter set.
+//
+//   make batch
+//   ./bin/snake_batch --games 100000 --sweep speed_curve_k=0.05,0.08,0.11 --out sweep.csv
+//
+// Work is split into jobs of BATCH_CHUNK_GAMES games. Each worker owns a
+// deque of jobs, pops from its own bottom and steals from the top of the
+// others when it runs dry, so uneven game lengths do not leave cores idle.
+#define _POSIX_C_SOURCE 200809L
+#include <pthread.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include "config.h"
+#include "game.h"
+#include "sim.h"
+
+#define BATCH_MAX_SETS 256
+#define BATCH_MAX_SWEEPS 8
+#define BATCH_MAX_VALUES 32
+#define BATCH_CHUNK_GAMES 256
+#define BATCH_COMBO_TIERS 7
+
+typedef struct
+{
+    const char *name;
+    int is_float;
+    size_t offset;
+} SweepKey;
+
+// GameConfig fields that affect singleplayer balance
+static const SweepKey SWEEP_KEYS[] = {
+    {"tick_ms", 0, offsetof(GameConfig, tick_ms)},
+    {"speed_floor_ms", 0, offsetof(GameConfig, speed_floor_ms)},
+    {"speed_curve_k", 1, offsetof(GameConfig, speed_curve_k)},
+    {"combo_window_ticks", 0, offsetof(GameConfig, combo_window_ticks)},
+    {"combo_window_increase_per_tier", 0, offsetof(GameConfig, combo_window_increase_per_tier)},
+    {"sp_board_width", 0, offsetof(GameConfig, sp_board_width)},
+    {"sp_board_height", 0, offsetof(GameConfig, sp_board_height)},
+};
+#define SWEEP_KEY_COUNT ((int)(sizeof(SWEEP_KEYS) / sizeof(SWEEP_KEYS[0])))
+
+typedef struct
+{
+    const SweepKey *key;
+    double values[BATCH_MAX_VALUES];
+    int count;
+} Sweep;
+
+// Per-game results of one parameter set, indexed by game number
+typedef struct
+{
+    GameConfig cfg;
+    int *score;
+    int *combo_best;
+    unsigned int *duration_ms;
+    unsigned char *won;
+} SetResults;
+
+typedef struct
+{
+    int set;
+    int first_game;
+    int count;
+} BatchJob;
+
+// Jobs [top, bottom) are pending. The owner takes from the bottom,
+// thieves from the top.
+typedef struct
+{
+    pthread_mutex_t lock;
+    BatchJob *jobs;
+    int top;
+    int bottom;
+} JobDeque;
+
+typedef struct
+{
+    JobDeque *deques;
+    int workers;
+    SetResults *sets;
+    uint64_t seed;
+    int max_ticks;
+} BatchShared;
+
+typedef struct
+{
+    BatchShared *shared;
+    int index;
+    long games_played;
+    long steals;
+} Worker;
+
+static void print_usage(const char *prog)
+{
+    printf("Usage: %s [options]\n", prog);
+    printf("Options:\n");
+    printf("  --games N         Games per parameter set (default 10000)\n");
+    printf("  --seed N          Seed of game 0 in every set (default 1)\n");
+    printf("  --threads N       Worker threads (default: all cores)\n");
+    printf("  --config FILE     Base parameters from a game_config.ini\n");
+    printf("  --sweep KEY=V,... Try each value of KEY (repeatable, cartesian product)\n");
+    printf("  --max-ticks N     Stop a game after N ticks (default 1000000)\n");
+    printf("  --out FILE        Write CSV to FILE (default stdout)\n");
+    printf("  --help, -h        Show this help message\n");
+    printf("Sweep keys:");
+    for (int i = 0; i < SWEEP_KEY_COUNT; i++)
+        printf(" %s", SWEEP_KEYS[i].name);
+    printf("\n");
+}
+
+static int parse_sweep(const char *spec, Sweep *out)
+{
+    const char *eq = strchr(spec, '=');
+    if (!eq)
+        return 0;
+
+    size_t name_len = (size_t)(eq - spec);
+    out->key = NULL;
+    for (int i = 0; i < SWEEP_KEY_COUNT; i++)
+    {
+        if (strlen(SWEEP_KEYS[i].name) == name_len && strncmp(SWEEP_KEYS[i].name, spec, name_len) == 0)
+        {
+            out->key = &SWEEP_KEYS[i];
+            break;
+        }
+    }
+    if (!out->key)
+        return 0;
+
+    out->count = 0;
+    const char *p = eq + 1;
+    while (*p && out->count < BATCH_MAX_VALUES)
+    {
+        char *end;
+        double v = strtod(p, &end);
+        if (end == p)
+            return 0;
+        out->values[out->count++] = v;
+        p = (*end == ',') ? end + 1 : end;
+        if (*end != ',' && *end != '\0')
+            return 0;
+    }
+    return out->count > 0;
+}
+
+static void apply_sweep_value(GameConfig *cfg, const SweepKey *key, double value)
+{
+    char *field = (char *)cfg + key->offset;
+    if (key->is_float)
+        *(float *)field = (float)value;
+    else
+        *(int *)field = (int)value;
+}
+
+static double now_seconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1e9;
+}
+
+static int deque_pop_bottom(JobDeque *d, BatchJob *out)
+{
+    int ok = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->bottom > d->top)
+    {
+        *out = d->jobs[--d->bottom];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ok;
+}
+
+static int deque_steal_top(JobDeque *d, BatchJob *out)
+{
+    int ok = 0;
+    pthread_mutex_lock(&d->lock);
+    if (d->bottom > d->top)
+    {
+        *out = d->jobs[d->top++];
+        ok = 1;
+    }
+    pthread_mutex_unlock(&d->lock);
+    return ok;
+}
+
+// No jobs are added after the workers start, so once every deque has been
+// seen empty there is nothing left to do.
+static int next_job(Worker *w, BatchJob *out)
+{
+    BatchShared *sh = w->shared;
+    if (deque_pop_bottom(&sh->deques[w->index], out))
+        return 1;
+
+    for (int i = 1; i < sh->workers; i++)
+    {
+        int victim = (w->index + i) % sh->workers;
+        if (deque_steal_top(&sh->deques[victim], out))
+        {
+            w->steals++;
+            return 1;
+        }
+    }
+    return 0;
+}
+
+static void *worker_main(void *arg)
+{
+    Worker *w = arg;
+    BatchShared *sh = w->shared;
+    Game game = {0};
+
+    BatchJob job;
+    while (next_job(w, &job))
+    {
+        SetResults *set = &sh->sets[job.set];
+        for (int i = job.first_game; i < job.first_game + job.count; i++)
+        {
+            SimResult r;
+            sim_play_game(&game, &set->cfg, sh->seed + (uint64_t)i, sh->max_ticks,
+                          sim_greedy_policy, NULL, &r);
+            set->score[i] = r.score;
+            set->combo_best[i] = r.combo_best;
+            set->duration_ms[i] = r.duration_ms;
+            set->won[i] = (unsigned char)r.won;
+        }
+        w->games_played += job.count;
+    }
+
+    game_free(&game);
+    return NULL;
+}
+
+static int cmp_int(const void *a, const void *b)
+{
+    int x = *(const int *)a, y = *(const int *)b;
+    return (x > y) - (x < y);
+}
+
+static int cmp_uint(const void *a, const void *b)
+{
+    unsigned int x = *(const unsigned int *)a, y = *(const unsigned int *)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of a sorted array
+static size_t rank(int n, double p)
+{
+    size_t r = (size_t)(p * (double)(n - 1) + 0.5);
+    return r < (size_t)n ? r : (size_t)n - 1;
+}
+
+static void write_csv(FILE *out, SetResults *sets, int set_count, int games)
+{
+    fprintf(out, "set,tick_ms,speed_floor_ms,speed_curve_k,combo_window_ticks,"
+                 "combo_window_increase_per_tier,sp_board_width,sp_board_height,games,win_rate,"
+                 "score_mean,score_p10,score_p50,score_p90,score_p99,score_max,"
+                 "combo_mean,combo_p50,combo_p90,combo_max");
+    for (int t = 1; t <= BATCH_COMBO_TIERS; t++)
+        fprintf(out, ",best_tier%d", t);
+    fprintf(out, ",duration_mean_s,duration_p10_s,duration_p50_s,duration_p90_s\n");
+
+    for (int s = 0; s < set_count; s++)
+    {
+        SetResults *set = &sets[s];
+        const GameConfig *c = &set->cfg;
+        double score_sum = 0.0, combo_sum = 0.0, duration_sum = 0.0;
+        int wins = 0;
+        int tiers[BATCH_COMBO_TIERS + 1] = {0};
+
+        for (int i = 0; i < games; i++)
+        {
+            score_sum += set->score[i];
+            combo_sum += set->combo_best[i];
+            duration_sum += set->duration_ms[i];
+            wins += set->won[i];
+            tiers[game_get_combo_tier(set->combo_best[i])]++;
+        }
+
+        qsort(set->score, (size_t)games, sizeof(int), cmp_int);
+        qsort(set->combo_best, (size_t)games, sizeof(int), cmp_int);
+        qsort(set->duration_ms, (size_t)games, sizeof(unsigned int), cmp_uint);
+
+        fprintf(out, "%d,%d,%d,%.4f,%d,%d,%d,%d,%d,%.4f,",
+                s, c->tick_ms, c->speed_floor_ms, c->speed_curve_k, c->combo_window_ticks,
+                c->combo_window_increase_per_tier, c->sp_board_width, c->sp_board_height,
+                games, (double)wins / games);
+        fprintf(out, "%.1f,%d,%d,%d,%d,%d,",
+                score_sum / games, set->score[rank(games, 0.10)], set->score[rank(games, 0.50)],
+                set->score[rank(games, 0.90)], set->score[rank(games, 0.99)], set->score[games - 1]);
+        fprintf(out, "%.2f,%d,%d,%d",
+                combo_sum / games, set->combo_best[rank(games, 0.50)],
+                set->combo_best[rank(games, 0.90)], set->combo_best[games - 1]);
+        for (int t = 1; t <= BATCH_COMBO_TIERS; t++)
+            fprintf(out, ",%.4f", (double)tiers[t] / games);
+        fprintf(out, ",%.2f,%.2f,%.2f,%.2f\n",
+                duration_sum / games / 1000.0, set->duration_ms[rank(games, 0.10)] / 1000.0,
+                set->duration_ms[rank(games, 0.50)] / 1000.0, set->duration_ms[rank(games, 0.90)] / 1000.0);
+    }
+}
+
+int main(int argc, char *argv[])
+{
+    int games = 10000;
+    uint64_t seed = 1;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    int max_ticks = 1000000;
+    const char *config_path = NULL;
+    const char *out_path = NULL;
+    Sweep sweeps[BATCH_MAX_SWEEPS];
+    int sweep_count = 0;
+
+    for (int i = 1; i < argc; i++)
+    {
+        int has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--games") == 0 && has_value)
+            games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && has_value)
+            seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--threads") == 0 && has_value)
+            threads = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--config") == 0 && has_value)
+            config_path = argv[++i];
+        else if (strcmp(argv[i], "--max-ticks") == 0 && has_value)
+            max_ticks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--out") == 0 && has_value)
+            out_path = argv[++i];
+        else if (strcmp(argv[i], "--sweep") == 0 && has_value)
+        {
+            if (sweep_count == BATCH_MAX_SWEEPS || !parse_sweep(argv[++i], &sweeps[sweep_count]))
+            {
+                fprintf(stderr, "Invalid sweep: %s\n", argv[i]);
+                return 1;
+            }
+            sweep_count++;
+        }
+        else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (games <= 0 || max_ticks <= 0)
+    {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+    if (threads < 1)
+        threads = 1;
+
+    GameConfig base;
+    config_init_defaults(&base);
+    if (config_path)
+    {
+        // config_load writes a default file when it is missing; don't
+        FILE *probe = fopen(config_path, "r");
+        if (!probe)
+        {
+            fprintf(stderr, "Cannot open config %s\n", config_path);
+            return 1;
+        }
+        fclose(probe);
+        config_load(&base, config_path);
+    }
+
+    // Cartesian product of all sweeps over the base config
+    int set_count = 1;
+    for (int s = 0; s < sweep_count; s++)
+    {
+        set_count *= sweeps[s].count;
+        if (set_count > BATCH_MAX_SETS)
+        {
+            fprintf(stderr, "Too many parameter sets (max %d)\n", BATCH_MAX_SETS);
+            return 1;
+        }
+    }
+
+    SetResults *sets = calloc((size_t)set_count, sizeof(SetResults));
+    if (!sets)
+        return 1;
+    for (int i = 0; i < set_count; i++)
+    {
+        sets[i].cfg = base;
+        int rest = i;
+        for (int s = sweep_count - 1; s >= 0; s--)
+        {
+            apply_sweep_value(&sets[i].cfg, sweeps[s].key, sweeps[s].values[rest % sweeps[s].count]);
+            rest /= sweeps[s].count;
+        }
+
+        if (sets[i].cfg.sp_board_width < 2 || sets[i].cfg.sp_board_height < 1 || sets[i].cfg.tick_ms <= 0)
+        {
+            fprintf(stderr, "Invalid parameters in set %d\n", i);
+            return 1;
+        }
+
+        sets[i].score = malloc((size_t)games * sizeof(int));
+        sets[i].combo_best = malloc((size_t)games * sizeof(int));
+        sets[i].duration_ms = malloc((size_t)games * sizeof(unsigned int));
+        sets[i].won = malloc((size_t)games);
+        if (!sets[i].score || !sets[i].combo_best || !sets[i].duration_ms || !sets[i].won)
+        {
+            fprintf(stderr, "Out of memory for %d games x %d sets\n", games, set_count);
+            return 1;
+        }
+    }
+
+    // Deal jobs round-robin; stealing evens out the rest
+    int chunks_per_set = (games + BATCH_CHUNK_GAMES - 1) / BATCH_CHUNK_GAMES;
+    int job_count = chunks_per_set * set_count;
+    JobDeque *deques = calloc((size_t)threads, sizeof(JobDeque));
+    Worker *workers = calloc((size_t)threads, sizeof(Worker));
+    pthread_t *tids = calloc((size_t)threads, sizeof(pthread_t));
+    if (!deques || !workers || !tids)
+        return 1;
+
+    for (int t = 0; t < threads; t++)
+    {
+        pthread_mutex_init(&deques[t].lock, NULL);
+        deques[t].jobs = malloc((size_t)(job_count / threads + 1) * sizeof(BatchJob));
+        if (!deques[t].jobs)
+            return 1;
+    }
+    for (int j = 0; j < job_count; j++)
+    {
+        JobDeque *d = &deques[j % threads];
+        BatchJob job;
+        job.set = j / chunks_per_set;
+        job.first_game = (j % chunks_per_set) * BATCH_CHUNK_GAMES;
+        job.count = games - job.first_game < BATCH_CHUNK_GAMES ? games - job.first_game : BATCH_CHUNK_GAMES;
+        d->jobs[d->bottom++] = job;
+    }
+
+    BatchShared shared = {deques, threads, sets, seed, max_ticks};
+    fprintf(stderr, "Simulating %d sets x %d games on %d threads\n", set_count, games, threads);
+    double start = now_seconds();
+
+    for (int t = 0; t < threads; t++)
+    {
+        workers[t].shared = &shared;
+        workers[t].index = t;
+        pthread_create(&tids[t], NULL, worker_main, &workers[t]);
+    }
+
+    long steals = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        pthread_join(tids[t], NULL);
+        steals += workers[t].steals;
+    }
+    double elapsed = now_seconds() - start;
+    fprintf(stderr, "Done in %.2f s (%.0f games/s, %ld jobs stolen)\n",
+            elapsed, elapsed > 0.0 ? (double)games * set_count / elapsed : 0.0, steals);
+
+    FILE *out = stdout;
+    if (out_path)
+    {
+        out = fopen(out_path, "w");
+        if (!out)
+        {
+            fprintf(stderr, "Cannot write %s\n", out_path);
+            return 1;
+        }
+    }
+    write_csv(out, sets, set_count, games);
+    if (out != stdout)
+        fclose(out);
+
+    for (int t = 0; t < threads; t++)
+    {
+        pthread_mutex_destroy(&deques[t].lock);
+        free(deques[t].jobs);
+    }
+    for (int i = 0; i < set_count; i++)
+    {
+        free(sets[i].score);
+        free(sets[i].combo_best);
+        free(sets[i].duration_ms);
+        free(sets[i].won);
+    }
+    free(sets);
+    free(deques);
+    free(workers);
+    free(tids);
+    return 0;
+}
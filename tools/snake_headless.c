@@ -0,0 +1,126 @@
+// Headless singleplayer driver: runs the real game rules from libsnakecore
+// with a simple bot, no window or audio. Useful for benchmarks, bots and
+// reproducing a seeded run.
+//
+//   make headless
+//   ./bin/snake_headless --games 1000 --seed 42
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include "constants.h"
+#include "config.h"
+#include "game.h"
+#include "sim.h"
+
+typedef struct
+{
+    int games;          // Number of games to play
+    uint64_t seed;      // Game i is seeded with seed + i
+    int width;          // Board width
+    int height;         // Board height
+    int max_ticks;      // Safety cap on ticks per game
+    int verbose;        // Print a line per game
+} HeadlessOptions;
+
+static void print_usage(const char *prog)
+{
+    printf("Usage: %s [options]\n", prog);
+    printf("Options:\n");
+    printf("  --games N        Number of games to play (default 100)\n");
+    printf("  --seed N         Seed of the first game (default 1)\n");
+    printf("  --width N        Board width (default %d)\n", SINGLEPLAYER_BOARD_WIDTH);
+    printf("  --height N       Board height (default %d)\n", SINGLEPLAYER_BOARD_HEIGHT);
+    printf("  --max-ticks N    Stop a game after N ticks (default 1000000)\n");
+    printf("  --verbose, -v    Print the result of every game\n");
+    printf("  --help, -h       Show this help message\n");
+}
+
+int main(int argc, char *argv[])
+{
+    HeadlessOptions opt = {
+        .games = 100,
+        .seed = 1,
+        .width = SINGLEPLAYER_BOARD_WIDTH,
+        .height = SINGLEPLAYER_BOARD_HEIGHT,
+        .max_ticks = 1000000,
+        .verbose = 0};
+
+    for (int i = 1; i < argc; i++)
+    {
+        int has_value = i + 1 < argc;
+        if (strcmp(argv[i], "--games") == 0 && has_value)
+            opt.games = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--seed") == 0 && has_value)
+            opt.seed = strtoull(argv[++i], NULL, 10);
+        else if (strcmp(argv[i], "--width") == 0 && has_value)
+            opt.width = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--height") == 0 && has_value)
+            opt.height = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--max-ticks") == 0 && has_value)
+            opt.max_ticks = atoi(argv[++i]);
+        else if (strcmp(argv[i], "--verbose") == 0 || strcmp(argv[i], "-v") == 0)
+            opt.verbose = 1;
+        else if (strcmp(argv[i], "--help") == 0 || strcmp(argv[i], "-h") == 0)
+        {
+            print_usage(argv[0]);
+            return 0;
+        }
+        else
+        {
+            fprintf(stderr, "Unknown option: %s\n", argv[i]);
+            print_usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (opt.games <= 0 || opt.width < 2 || opt.height < 1 || opt.max_ticks <= 0)
+    {
+        fprintf(stderr, "Invalid options\n");
+        return 1;
+    }
+
+    GameConfig cfg;
+    config_init_defaults(&cfg);
+    cfg.sp_board_width = opt.width;
+    cfg.sp_board_height = opt.height;
+
+    Game game = {0};
+    long total_ticks = 0;
+    long total_score = 0;
+    int best_score = 0;
+    int wins = 0;
+
+    clock_t start = clock();
+    for (int i = 0; i < opt.games; i++)
+    {
+        uint64_t seed = opt.seed + (uint64_t)i;
+        SimResult result;
+        sim_play_game(&game, &cfg, seed, opt.max_ticks, sim_greedy_policy, NULL, &result);
+
+        total_ticks += result.ticks;
+        total_score += result.score;
+        if (result.score > best_score)
+            best_score = result.score;
+        if (result.won)
+            wins++;
+
+        if (opt.verbose)
+        {
+            printf("game %d seed %llu: score %d, fruits %d, ticks %d%s\n",
+                   i, (unsigned long long)seed, result.score, result.fruits_eaten, result.ticks,
+                   result.won ? " (won)" : "");
+        }
+    }
+    double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+    game_free(&game);
+
+    printf("games:       %d (%d won)\n", opt.games, wins);
+    printf("ticks:       %ld\n", total_ticks);
+    printf("mean score:  %.1f\n", (double)total_score / opt.games);
+    printf("best score:  %d\n", best_score);
+    printf("cpu time:    %.3f s\n", seconds);
+    if (seconds > 0.0)
+        printf("ticks/sec:   %.0f\n", (double)total_ticks / seconds);
+    return 0;
+}